@@ -0,0 +1,80 @@
+// © Copyright 2010 - 2021 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_CancellationToken_h
+#define Mezz_Test_CancellationToken_h
+
+/// @file
+/// @brief The declaration of a flag many threads can share to ask running work to stop early.
+
+#include "DataTypes.h"
+
+#include <atomic>
+#include <memory>
+
+namespace Mezzanine
+{
+namespace Testing
+{
+    /// @brief A flag that can be set once from any thread and checked from any other.
+    /// @details Copies share the same flag, so one can be handed to every test group and scheduler and cancelling
+    /// any copy cancels them all. Nothing is interrupted, work has to check IsCancelled and stop itself.
+    class MEZZ_LIB CancellationToken
+    {
+    private:
+        /// @brief The flag every copy shares.
+        std::shared_ptr<std::atomic<Boole>> Cancelled;
+
+    public:
+        /// @brief Create a new token that is not cancelled and shares nothing with other tokens.
+        CancellationToken();
+
+        /// @brief Ask everything holding a copy of this to stop, this cannot be undone.
+        /// @remarks This is const because it changes only the shared flag, not which flag this refers to.
+        void Cancel() const noexcept;
+
+        /// @brief Has this or any copy been cancelled?
+        /// @return True once Cancel has been called on this or any copy of it.
+        [[nodiscard]]
+        Boole IsCancelled() const noexcept;
+    };//CancellationToken
+}// Testing
+}// Mezzanine
+
+#endif
@@ -0,0 +1,109 @@
+// © Copyright 2010 - 2021 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_CpuPinningGuard_h
+#define Mezz_Test_CpuPinningGuard_h
+
+/// @file
+/// @brief The declaration of a way to keep a thread, and any processes it starts, on chosen CPUs for a while.
+
+#include "DataTypes.h"
+
+#include <vector>
+
+namespace Mezzanine
+{
+namespace Testing
+{
+    /// @brief A list of CPU numbers, as the operating system counts them starting from 0.
+    using CpuListType = std::vector<Whole>;
+
+    /// @brief Used to apply RAII to the CPUs the calling thread may run on.
+    /// @details While one of these exists the thread that created it only runs on the chosen CPUs, and so do threads
+    /// and child processes it starts, because they inherit that. Only Linux supports this, everywhere else nothing is
+    /// pinned and IsPinned says so.
+    class MEZZ_LIB CpuPinningGuard
+    {
+    private:
+        /// @brief The CPUs the thread could use before, to put back when this is destroyed.
+        CpuListType PreviousCpus;
+        /// @brief Did pinning work?
+        Boole Pinned = false;
+
+    public:
+        /// @brief Copying this kind of guard would restore the CPUs twice, so the copy constructor is deleted.
+        CpuPinningGuard(const CpuPinningGuard&) = delete;
+        /// @brief Copying this kind of guard would restore the CPUs twice, so assignment is deleted.
+        CpuPinningGuard& operator=(const CpuPinningGuard&) = delete;
+        /// @brief Moving one of these to another thread would restore the wrong thread, so this is deleted.
+        CpuPinningGuard(CpuPinningGuard&&) = delete;
+        /// @brief Moving one of these to another thread would restore the wrong thread, so this is deleted.
+        CpuPinningGuard& operator=(CpuPinningGuard&&) = delete;
+
+        /// @brief Pin the calling thread to some CPUs.
+        /// @param Cpus The CPUs to allow, if none are given nothing is changed.
+        explicit CpuPinningGuard(const CpuListType& Cpus);
+        /// @brief Let the thread run on the CPUs it could use before.
+        ~CpuPinningGuard();
+
+        /// @brief Is the thread running only on the chosen CPUs?
+        /// @return False if no CPUs were given, or the operating system refused or does not support pinning.
+        [[nodiscard]]
+        Boole IsPinned() const;
+    };// CpuPinningGuard
+
+    /// @brief Find out which CPUs the calling thread may run on.
+    /// @return Every allowed CPU in ascending order, or nothing where this is not supported.
+    CpuListType MEZZ_LIB GetThreadCpus();
+
+    /// @brief Read a list of CPUs like "0,2,4-7".
+    /// @param Text Numbers and ranges of numbers separated by commas.
+    /// @param Cpus Where to put every listed CPU, in ascending order and without duplicates.
+    /// @return False if the text is not a valid list, in which case Cpus is left unchanged.
+    Boole MEZZ_LIB ParseCpuList(const String& Text, CpuListType& Cpus);
+
+    /// @brief Write a list of CPUs the way ParseCpuList reads them, without ranges.
+    /// @param Cpus The CPUs to list.
+    /// @return The CPU numbers separated by commas, like "0,2,3".
+    String MEZZ_LIB CpuListToString(const CpuListType& Cpus);
+
+}// Testing
+}// Mezzanine
+
+#endif
@@ -0,0 +1,96 @@
+// © Copyright 2010 - 2021 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_CrashHandlers_h
+#define Mezz_Test_CrashHandlers_h
+
+/// @file
+/// @brief The declaration of a way for child processes to report how they crashed before they die.
+
+#include "DataTypes.h"
+#include "ResultRecords.h"
+
+namespace Mezzanine
+{
+namespace Testing
+{
+#ifndef MEZZ_Windows
+    /// @brief Have this process send a crash record before it dies of a crash.
+    /// @details SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT and SIGXCPU are caught. The handler writes the signal, the
+    /// address that caused it and a backtrace, without allocating, as a crash record to Descriptor. Then the signal is
+    /// raised again without the handler so the process still dies of it. Only the first thread to crash writes a
+    /// record, others crashing at the same time wait for it. Frames are sent unnamed, as offsets into the modules
+    /// loaded when this was called, see NameCrashFrames. Only the calling thread gets a stack to handle running out
+    /// of stack with, on other threads that kills the process without a record, but the parent still sees the signal.
+    /// If writing the record takes more than a few seconds, like when the crash was inside the unwinder, SIGALRM ends
+    /// the process instead. Not available on Windows.
+    /// @param Descriptor Where to write the crash record, normally the result channel.
+    void MEZZ_LIB InstallCrashHandlers(const int Descriptor);
+#endif // MEZZ_Windows
+
+    /// @brief Name the frames of a crash record sent by another process, so the crashing process need not.
+    /// @details Each frame is looked up in the module of the same name loaded into this process. Frames are named
+    /// from the dynamic symbol table, so functions a module does not export, or frames in modules this process has
+    /// not loaded, keep their offset into the module, which addr2line can read. For SIGABRT the frames inside abort
+    /// are dropped, so the backtrace starts at whatever called it.
+    /// @param Crash What the crashing process reported, its frames are named in place.
+    void MEZZ_LIB NameCrashFrames(CrashReport& Crash);
+
+    /// @brief Get the usual name for a signal number.
+    /// @param Signal The number of the signal.
+    /// @return Something like "SIGSEGV", or "signal 42" for signals without a well known name.
+    [[nodiscard]]
+    String MEZZ_LIB SignalName(const Integer Signal);
+
+    /// @brief Get the function a crash happened in, as a person would write it.
+    /// @param Crash What the crashing process reported.
+    /// @return The demangled name of the innermost frame, or an empty String if it has no name.
+    [[nodiscard]]
+    String MEZZ_LIB GetCrashedFunction(const CrashReport& Crash);
+
+    /// @brief Describe a crash for a person to read, with the signal, the address and the backtrace.
+    /// @param Crash What the crashing process reported.
+    /// @return Several lines of text, each ending in a newline, with the names of functions demangled.
+    [[nodiscard]]
+    String MEZZ_LIB DescribeCrash(const CrashReport& Crash);
+
+}// Testing
+}// Mezzanine
+
+#endif
@@ -0,0 +1,128 @@
+// © Copyright 2010 - 2021 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_LogPublisher_h
+#define Mezz_Test_LogPublisher_h
+
+/// @file
+/// @brief The declaration of a thread that writes test group logs so the threads running tests never wait on output.
+
+#include "DataTypes.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <iosfwd>
+#include <mutex>
+#include <thread>
+
+namespace Mezzanine
+{
+namespace Testing
+{
+    SAVE_WARNING_STATE
+    SUPPRESS_CLANG_WARNING("-Wpadded")
+    SUPPRESS_GCC_WARNING("-Wpadded")
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    /// @brief Writes text to a stream from a thread of its own, in the order it was published.
+    /// @details Publishing pushes onto a lock free list with a single compare and swap, so any number of threads can
+    /// publish without waiting on each other or on the stream. The writing thread takes the whole list at once,
+    /// restores the order things were published in and writes them. Text from one thread always comes out in the
+    /// order that thread published it. The writing thread sleeps until something is published onto an empty list.
+    class MEZZ_LIB LogPublisher
+    {
+    private:
+        /// @brief One piece of published text waiting to be written.
+        struct PendingText
+        {
+            /// @brief What to write.
+            String Text;
+            /// @brief The text published before this one.
+            PendingText* Previous;
+        };
+
+        /// @brief Where the text goes, only the writing thread touches it until Finish returns.
+        std::ostream& Destination;
+        /// @brief The most recently published text, newest first.
+        std::atomic<PendingText*> Newest{nullptr};
+        /// @brief Set to tell the writing thread to write what is left and stop.
+        std::atomic<Boole> Finishing{false};
+        /// @brief Held while the writing thread decides to sleep, so a wake up cannot slip in before it does.
+        std::mutex WakeLock;
+        /// @brief Wakes the writing thread when the list stops being empty or it should finish.
+        std::condition_variable WakeWriter;
+        /// @brief The thread that writes to Destination.
+        std::thread Writer;
+
+        /// @brief Take everything published so far and write it.
+        void WritePending();
+        /// @brief What the writing thread executes until told to finish.
+        void WriterLoop();
+
+    public:
+        /// @brief Start a thread to write to a stream.
+        /// @param Output The stream to write to, no other thread should write to it until Finish returns.
+        explicit LogPublisher(std::ostream& Output);
+
+        /// @brief Copying a thread makes no sense.
+        LogPublisher(const LogPublisher&) = delete;
+        /// @brief Moving something other threads publish to makes no sense.
+        LogPublisher(LogPublisher&&) = delete;
+        /// @brief Copying a thread makes no sense.
+        LogPublisher& operator=(const LogPublisher&) = delete;
+        /// @brief Moving something other threads publish to makes no sense.
+        LogPublisher& operator=(LogPublisher&&) = delete;
+
+        /// @brief Calls Finish, so nothing published is lost.
+        ~LogPublisher();
+
+        /// @brief Queue some text to be written, this never waits on the stream or other publishers.
+        /// @param Text What to write, it is written exactly as is.
+        void Publish(String Text);
+
+        /// @brief Write everything published and stop the writing thread.
+        /// @details Only call this once nothing else will publish. Calling it more than once is harmless.
+        void Finish();
+    };// LogPublisher
+    RESTORE_WARNING_STATE
+
+}// Testing
+}// Mezzanine
+
+#endif
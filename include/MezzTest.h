@@ -49,15 +49,23 @@
 #include "BenchmarkTestGroup.h"
 #include "BenchmarkThreadTestGroup.h"
 #include "ConsoleLogic.h"
+#include "CpuPinningGuard.h"
+#include "CrashHandlers.h"
+#include "LogPublisher.h"
 #include "OutputBufferGuard.h"
 #include "ProcessTools.h"
+#include "ResourceLimitGuard.h"
+#include "ResultCache.h"
+#include "ResultRecords.h"
 #include "StringManipulation.h"
 #include "SilentTestGroup.h"
 #include "TestData.h"
+#include "TestHistory.h"
 #include "TestMacros.h"
 #include "TestEnumerations.h"
 #include "TimingTools.h"
 #include "UnitTestGroup.h"
+#include "WorkStealingPool.h"
 
 #include <stdexcept> // Used to throw for TEST_THROW
 
@@ -81,6 +89,14 @@ namespace Testing
             /// @brief A series of functions paired with command line arguments.
             CallingTableType CallingTable;
 
+            /// @brief Create a type for delegating work for arguments that carry a value, like "jobs=4".
+            /// @details The key is the lower case prefix of the argument and the function is passed everything after
+            /// the prefix, with its case preserved.
+            typedef std::map<Mezzanine::String, std::function<void(const Mezzanine::String&)>> ParameterTableType;
+
+            /// @brief A series of functions paired with the prefixes of command line arguments that carry a value.
+            ParameterTableType ParameterTable;
+
             /// @brief This will store the name of the command that launched this executable at run time.
             Mezzanine::String CommandName = "Mezz_Tester";
 
@@ -91,12 +107,60 @@ namespace Testing
             Boole InSubProcess = false ;
             /// @brief Force single threaded to help troubleshoot.
             Boole ForceSingleThread = false;
-            /// @brief Skip writing the log file.
+            /// @brief Skip writing the results file, ResultsFileName.
             Boole SkipFile = false;
+            /// @brief Neither read nor write the history of test group durations.
+            Boole SkipHistory = false;
+            /// @brief Neither replay results from nor store results in CacheFileName.
+            Boole SkipCache = false;
             /// @brief Skip writing the summary at the end.
             Boole SkipSummary = false;
             /// @brief Create Junit Xml output files?
             Boole EmitJunitXml = false;
+            /// @brief Run isolated test groups in long lived worker processes instead of one process per group.
+            Boole ReuseProcesses = false;
+            /// @brief This process is a worker, reading test group names from cin until it closes.
+            Boole IsWorkerProcess = false;
+            /// @brief Run isolated test groups in forks of this process instead of starting the executable again.
+            Boole ForkProcesses = false;
+
+            /// @brief How many threads to run parallel test groups on, defaults to the number of hardware threads.
+            Whole JobCount = WorkStealingPool::GetDefaultThreadCount();
+            /// @brief How many child processes may run test groups at once, defaults to the number of hardware threads.
+            Whole ProcessCount = WorkStealingPool::GetDefaultThreadCount();
+
+            /// @brief Which of the ShardCount shards to run, starting at 1.
+            Whole ShardIndex = 1;
+            /// @brief How many machines the scheduled test groups are split across, 1 means no sharding.
+            Whole ShardCount = 1;
+            /// @brief The history every shard splits the test groups by, empty to split by name alone.
+            /// @details This is only read, so machines that share it agree on the split whatever they ran before.
+            Mezzanine::String ShardHistoryFileName;
+            /// @brief Result files from shards to merge instead of running tests, empty when not merging.
+            std::vector<Mezzanine::String> MergeFileNames;
+            /// @brief Where a child process sends its results as records, -1 when it should not.
+            Integer ResultDescriptor = -1;
+            /// @brief How long an isolated test group may run before its process is killed, zero for no limit.
+            /// @details Test groups that return something other than zero from Timeout use that instead.
+            std::chrono::seconds Timeout{0};
+            /// @brief How many results may be Failed or worse before the run stops early, zero for no limit.
+            Whole MaxFailures = 0;
+            /// @brief Start test groups in a random order, rather than alphabetically or by history.
+            Boole Shuffle = false;
+            /// @brief What the shuffled order is made from, the same seed always gives the same order.
+            /// @details Chosen at random when shuffling is requested without one, zero otherwise.
+            Whole ShuffleSeed = 0;
+            /// @brief How many times to run each test group, tallying each test's results rather than keeping one.
+            Whole RepeatCount = 1;
+            /// @brief Keep repeating test groups until one of their results is Warning or worse.
+            Boole RepeatUntilFailure = false;
+            /// @brief Run the repeats of thread safe test groups as copies at once, rather than one after another.
+            Boole RepeatConcurrently = false;
+            /// @brief How many more times to run a test group that has a result that is Failed or Unknown.
+            Whole RetryCount = 0;
+            /// @brief The CPUs to pin benchmarks to, empty to leave them unpinned.
+            /// @details Test groups that return something from PinnedCpus use that instead.
+            CpuListType BenchmarkCpus;
 
             /// @brief User Requested benchmarks be run, defaults to false.
             Boole DoBenchmarkTests = false;
@@ -119,6 +183,19 @@ namespace Testing
             /// @param OneTest A single test to force skip, even if scheduled.
             void SkipTest(const CoreTestGroup::value_type& OneTest);
 
+            /// @brief Used internally to interpret the value of arguments that must be positive integers.
+            /// @param Value The text after the argument's prefix.
+            /// @param Destination Where to store the number if it is valid.
+            void ParsePositiveWhole(const Mezzanine::String& Value, Whole& Destination);
+
+            /// @brief Used internally to interpret a shard in the form "I/N".
+            /// @param Value The text after the argument's prefix.
+            void ParseShard(const Mezzanine::String& Value);
+
+            /// @brief Used internally to interpret a comma separated list of files to merge.
+            /// @param Value The text after the argument's prefix.
+            void ParseMergeFileNames(const Mezzanine::String& Value);
+
         };// ParsedCommandLineArgs
     RESTORE_WARNING_STATE
 
@@ -143,37 +220,360 @@ namespace Testing
     void MEZZ_LIB RenderTimingsSummary(const std::vector<NamedDuration>& AllTimings,
                                        std::ostream& SummaryStream);
 
+    /// @brief Print how often each test of the repeated test groups failed to a stream.
+    /// @param TestInstances The complete set of tests, only those that ran and were repeated are included.
+    /// @param SummaryStream Place to print the tallies.
+    void MEZZ_LIB RenderRepeatSummary(const CoreTestGroup& TestInstances, std::ostream& SummaryStream);
+
+    /// @brief A sequence of test groups in the order they should be started.
+    using OrderedTestGroups = std::vector<const CoreTestGroup::value_type*>;
+
+    /// @brief Put test groups in the order that should finish soonest, longest expected duration first.
+    /// @param TestInstances The test groups to order.
+    /// @param History The durations of previous runs, groups missing from it are put first.
+    /// @return Every test group, in the order they should be started.
+    OrderedTestGroups MEZZ_LIB OrderTestGroupsByHistory(const CoreTestGroup& TestInstances,
+                                                        const TestHistory& History);
+
+    /// @brief Put test groups in a random order that depends only on the seed and the names of the groups.
+    /// @details This uses std::mt19937_64 and its own shuffle, whose results the standard fully specifies, rather
+    /// than std::shuffle, so a seed gives the same order with every compiler and standard library.
+    /// @param TestInstances The test groups to order.
+    /// @param Seed Where the random order comes from.
+    /// @return Every test group, in the order they should be started.
+    OrderedTestGroups MEZZ_LIB ShuffleTestGroups(const CoreTestGroup& TestInstances, const Whole Seed);
+
+    /// @brief Pick the test groups one shard should run, so that every shard gets a disjoint part of the work.
+    /// @details Groups with history are dealt out longest first, each to the shard with the least expected work so
+    /// far. Groups without history are assigned by a StableStringHash of their name. Every shard must be given the
+    /// same candidates and the same history to agree on the split.
+    /// @param Candidates The test groups scheduled to run, before sharding.
+    /// @param History The durations of previous runs.
+    /// @param ShardIndex Which shard to select for, starting at 1.
+    /// @param ShardCount How many shards there are in total.
+    /// @return The candidates that belong to the requested shard, in the order they were passed.
+    OrderedTestGroups MEZZ_LIB SelectShard(const OrderedTestGroups& Candidates,
+                                           const TestHistory& History,
+                                           const Whole ShardIndex,
+                                           const Whole ShardCount);
+
+    /// @brief Get the name of the file one shard writes its results to.
+    /// @param ShardIndex Which shard, starting at 1.
+    /// @param ShardCount How many shards there are in total.
+    /// @return A file name like "Mezz_Test_Shard_2_of_4.txt".
+    String MEZZ_LIB GetShardResultsFileName(const Whole ShardIndex, const Whole ShardCount);
+
+    /// @brief Write the results of every test group that ran, each under a header line with the group's name.
+    /// @details This is the format of both shard results files and ResultsFileName.
+    /// @param TestInstances All the test groups, those that were not run are left out.
+    /// @param Destination Where to write the results.
+    void MEZZ_LIB EmitShardResults(const CoreTestGroup& TestInstances, std::ostream& Destination);
+
+    /// @brief Read every test result from a stream of text, like a shard's results file.
+    /// @param Source The stream to read until it ends, lines that are not results are skipped.
+    /// @return The results found.
+    UnitTestGroup::TestDataStorageType MEZZ_LIB ReadTestResults(std::istream& Source);
+
+    /// @brief Find the test groups that did badly in a results file written by EmitShardResults.
+    /// @param Source The stream to read until it ends.
+    /// @return The name of every group with a result worse than Warning, in the order they appear.
+    std::vector<String> MEZZ_LIB ReadFailedGroupNames(std::istream& Source);
+
+    /// @brief Combine the results files of several shards into one summary and one Junit XML file.
+    /// @param Options The options, whose MergeFileNames lists the files to read.
+    /// @return EXIT_SUCCESS if all files were read and nothing worse than a warning happened.
+    ExitCode MEZZ_LIB MergeShardResults(const ParsedCommandLineArgs& Options);
+
+    /// @brief Record the durations of test groups from the timings of this run.
+    /// @details Only timings with the suffixes RunParallelThreads and RunSerializedTests use are test groups,
+    /// anything else is ignored.
+    /// @param TestTimings The timings gathered while running tests.
+    /// @param History Where to record the durations.
+    void MEZZ_LIB RecordTestGroupTimings(const std::vector<NamedDuration>& TestTimings, TestHistory& History);
+
+    /// @brief Create the command that runs one test group in a child process.
+    /// @param Options The parsed command line options.
+    /// @param OneTestGroup The test group the child should execute.
+    /// @return A command suitable for RunCommand or a ProcessScheduler.
+    String MEZZ_LIB GetSubProcessCommand(const ParsedCommandLineArgs& Options,
+                                         const UnitTestGroup& OneTestGroup);
+
+    /// @brief Create the same command GetSubProcessCommand does, already split into its arguments.
+    /// @details Nothing needs to be split up or unquoted to launch this, so the executable's path may even contain
+    /// spaces.
+    /// @param Options The parsed command line options.
+    /// @param OneTestGroup The test group the child should execute.
+    /// @return The executable and its arguments, suitable for a ProcessScheduler.
+    ArgumentListType MEZZ_LIB GetSubProcessArguments(const ParsedCommandLineArgs& Options,
+                                                     const UnitTestGroup& OneTestGroup);
+
+    /// @brief Create the arguments that make a child process repeat test groups the way this process does.
+    /// @param Options The parsed command line options.
+    /// @return Nothing if not repeating, otherwise the arguments each preceded by a space.
+    String MEZZ_LIB GetRepeatArguments(const ParsedCommandLineArgs& Options);
+
+    /// @brief Run a test group in this process and send its results and log to the parent process.
+    /// @details Each result is sent as a result record as soon as it is stored, so a parent that kills this process
+    /// still has every result from before then. The whole log follows as a log record once the group is done.
+    /// @param OneTestGroup The test group to run.
+    /// @param Channel Where to send the records.
+    void MEZZ_LIB RunAndSendResultRecords(UnitTestGroup& OneTestGroup, const ResultRecordSink& Channel);
+
+#ifndef MEZZ_Windows
+    /// @brief What a child forked from this process runs, in place of a whole new test executable.
+    /// @details The child's copy of the group forgets anything it already had, so a retry starts as afresh as it
+    /// would in a new process. Then it is run and its records sent to ResultChannelDescriptor like
+    /// RunAndSendResultRecords does. Not available on Windows.
+    /// @param OneTestGroup The child's copy of the test group to run.
+    /// @return The exit code for the child.
+    ExitCode MEZZ_LIB RunForkedTestGroup(UnitTestGroup& OneTestGroup);
+#endif // MEZZ_Windows
+
+    /// @brief Create something to read the result records a child process sends about a test group.
+    /// @details Results are stored in the group as soon as their records are complete, without being logged, and
+    /// the child's log is appended to the group's log instead. If the records cannot be read an Unknown result is
+    /// added and the rest are ignored. Errors storing a result that was read, like a repeated name, are thrown.
+    /// @param OneTestGroup The test group the child is executing, it must outlive whatever this returns.
+    /// @param OnCrash Called with the crash record the child sends if it crashes, may be empty to ignore it.
+    /// @return A callback suitable for the result channel of a ProcessScheduler or WorkerProcessPool.
+    ResultChannelCallback MEZZ_LIB ReadResultRecordsInto(UnitTestGroup& OneTestGroup,
+                                                         ResultRecordDecoder::CrashCallback OnCrash = {});
+
+    /// @brief Work out how long the child process running a test group may take.
+    /// @param Options The parsed command line options.
+    /// @param OneTestGroup The test group the child would execute.
+    /// @return The test group's own Timeout if it has one, otherwise the one from the command line. Zero means none.
+    std::chrono::milliseconds MEZZ_LIB GetTimeLimit(const ParsedCommandLineArgs& Options,
+                                                    const UnitTestGroup& OneTestGroup);
+
+    /// @brief Gather the resource limits a test group asks for, to apply in the process running it.
+    /// @param OneTestGroup The test group about to run.
+    /// @return The group's MaxAddressSpace, MaxCpuSeconds and MaxOpenFiles, any of which may be zero for none.
+    ResourceLimits MEZZ_LIB GetResourceLimits(const UnitTestGroup& OneTestGroup);
+
+    /// @brief Work out which CPUs a test group should be pinned to.
+    /// @param Options The parsed command line options.
+    /// @param OneTestGroup The test group about to run.
+    /// @return Nothing if the group should not be pinned or this is a child process, which its parent pinned
+    /// already. Otherwise the group's own PinnedCpus if it has any, or the ones from the command line.
+    CpuListType MEZZ_LIB GetPinnedCpus(const ParsedCommandLineArgs& Options, const UnitTestGroup& OneTestGroup);
+
+    /// @brief Record which CPUs a test group ran on, in its log and as a result named for them.
+    /// @param OneTestGroup The test group that was pinned.
+    /// @param Cpus The CPUs it was meant to be pinned to.
+    /// @param Pinned Did pinning work? If not the result is NonPerformant, because its timings could be noisy, but
+    /// a limit of the machine running the tests does not fail the run.
+    void MEZZ_LIB RecordPinnedCpus(UnitTestGroup& OneTestGroup, const CpuListType& Cpus, const Boole Pinned);
+
+    /// @brief Record that the child process running a test group was killed for taking too long.
+    /// @details Results the child sent before that are left alone, this adds a Cancelled result and logs how long
+    /// it ran.
+    /// @param OneTestGroup The test group the child was executing.
+    /// @param Duration How long the child ran before it was killed.
+    void MEZZ_LIB RecordTimedOut(UnitTestGroup& OneTestGroup, const std::chrono::nanoseconds Duration);
+
+    /// @brief Record that the child process running a test group died of a signal it was not sent on purpose.
+    /// @details Results the child sent before that are left alone, this adds an Unknown result named for the crash
+    /// whose function is the one that crashed, if known, and logs the signal and the backtrace.
+    /// @param OneTestGroup The test group the child was executing.
+    /// @param Signal The signal that ended the child.
+    /// @param Crash What the child said about its crash, if it could. A Signal of zero here means it said nothing.
+    void MEZZ_LIB RecordCrashed(UnitTestGroup& OneTestGroup, const Integer Signal, const CrashReport& Crash);
+
+    /// @brief Decide if a test group that just finished should run again, and if so get it ready to.
+    /// @details A group is retried while some result of it has been Failed or Unknown every time it ran, it has
+    /// retries left and the run was not cancelled. Its results are tallied from then on, so each retry's results are
+    /// counted with the ones it already has.
+    /// @param Options The parsed command line options, whose RetryCount says how many retries a group gets.
+    /// @param OneTestGroup The test group that just finished.
+    /// @param RetriesDone How many times it was already retried.
+    /// @return True if it should be run again.
+    Boole MEZZ_LIB PrepareRetry(const ParsedCommandLineArgs& Options,
+                                UnitTestGroup& OneTestGroup,
+                                const Whole RetriesDone);
+
+    /// @brief Change the results of a retried test group that failed only some of the time to Flaky.
+    /// @details Each is logged with how many times it passed and failed. Results that were Failed or Unknown every
+    /// time are left alone, they are outright failures.
+    /// @param OneTestGroup The test group that is done being retried.
+    /// @param RetriesDone How many times it was retried, nothing is changed if it was not.
+    void MEZZ_LIB RecordFlakyResults(UnitTestGroup& OneTestGroup, const Whole RetriesDone);
+
+    /// @brief Share one cancellation token with every test group and cancel it once enough results are failures.
+    /// @details Every result stored in any group from then on is counted if it is Failed or worse, wherever it
+    /// came from. That includes results read from child processes, and the counting is safe from any thread.
+    /// @param TestInstances The complete set of tests.
+    /// @param MaxFailures How many failures to allow before cancelling, zero never cancels.
+    /// @param StopRunning The token to share and cancel.
+    void MEZZ_LIB CancelAfterFailures(const CoreTestGroup& TestInstances,
+                                      const Whole MaxFailures,
+                                      CancellationToken StopRunning);
+
+    /// @brief Record that a test group was stopped, or never started, because the run was cancelled.
+    /// @details Results the group already has are left alone, this adds a Cancelled result so the group still
+    /// shows up in the summary and the XML.
+    /// @param OneTestGroup The test group that was stopped.
+    void MEZZ_LIB RecordStoppedEarly(UnitTestGroup& OneTestGroup);
+
+    /// @brief Store a result a child process printed in the test group it ran, if the line holds one.
+    /// @details This is called for each line as it arrives from the child, so results are stored while the child
+    /// still runs and its whole output never needs to be held at once.
+    /// @param ProcessLine One line the child process sent to its standard output.
+    /// @param OneTestGroup The test group the child is executing.
+    void MEZZ_LIB ParseSubProcessLine(const StringView ProcessLine,
+                                      UnitTestGroup& OneTestGroup);
+
+    /// @brief Store the results a child process printed in the test group it ran.
+    /// @param ProcessLog Everything the child process sent to its standard output.
+    /// @param OneTestGroup The test group the child executed.
+    void MEZZ_LIB ParseSubProcessOutput(const String& ProcessLog,
+                                        UnitTestGroup& OneTestGroup);
+
+    /// @brief Create the command that starts a long lived worker process.
+    /// @param Options The parsed command line options.
+    /// @return A command suitable for a WorkerProcessPool.
+    String MEZZ_LIB GetWorkerProcessCommand(const ParsedCommandLineArgs& Options);
+
+    /// @brief The loop a worker process runs instead of the normal test execution.
+    /// @details Each line read is the name of a test group as it is keyed in TestInstances. The group is run and its
+    /// results sent to the result channel, or if there is none its log is written to Results. Either way that is
+    /// followed by WorkerGroupDoneMarker on a line of its own. Unknown names just get the marker.
+    /// @param TestInstances The complete set of tests.
+    /// @param Requests Where the test group names come from, normally cin.
+    /// @param Results Where markers go, normally cout.
+    /// @param ResultChannel Where to send result records, if anywhere.
+    /// @return EXIT_SUCCESS once Requests runs out.
+    ExitCode MEZZ_LIB RunWorkerProcess(const CoreTestGroup& TestInstances,
+                                       std::istream& Requests,
+                                       std::ostream& Results,
+                                       const ResultRecordSink& ResultChannel = {});
+
     /// @brief Run a single test that requires a subProcess.
+    /// @details A child process applies the group's resource limits to itself before running it, since only that
+    /// one group runs there.
     /// @param Options The parsed command line options.
     /// @param OneTestGroup The test group to execute.
-    void MEZZ_LIB RunSubProcessTest(const ParsedCommandLineArgs& Options,
-                                    UnitTestGroup& OneTestGroup);
+    /// @return What the child process used, if this started one and the operating system said.
+    ResourceUsage MEZZ_LIB RunSubProcessTest(const ParsedCommandLineArgs& Options,
+                                             UnitTestGroup& OneTestGroup);
 
-    /// @brief Run all the tests that run in other threads.
+    /// @brief Describe the options that could change the results of a test group, for keying a ResultCache.
+    /// @param Options The parsed command line options.
+    /// @return The arguments that matter, in a fixed order so equal options always give equal text.
+    String MEZZ_LIB GetCacheArguments(const ParsedCommandLineArgs& Options);
+
+    /// @brief Give every scheduled test group that has results in a cache those results, so it need not run.
+    /// @details Replayed results are logged like any others, after a line saying they came from the cache, and the
+    /// groups are marked with SetReplayedFromCache so RunParallelThreads and RunSerializedTests skip them.
+    /// @param TestInstances The complete set of tests, only scheduled groups that CanCacheResults are looked up.
+    /// @param Cache Where to look for results.
+    /// @param Arguments What GetCacheArguments returned for this run.
+    void MEZZ_LIB ReplayCachedResults(const CoreTestGroup& TestInstances,
+                                      const ResultCache& Cache,
+                                      const String& Arguments);
+
+    /// @brief Store the results of every test group that ran and passed, and forget any that did not pass.
+    /// @details Only Success and Skipped count as passing. Groups that were replayed are left as they were.
+    /// @param TestInstances The complete set of tests, only scheduled groups that CanCacheResults are stored.
+    /// @param Cache Where to store results.
+    /// @param Arguments What GetCacheArguments returned for this run.
+    void MEZZ_LIB StoreCachedResults(const CoreTestGroup& TestInstances,
+                                     ResultCache& Cache,
+                                     const String& Arguments);
+
+    /// @brief Run all the tests that run in other threads or in child processes.
+    /// @details Thread safe groups run on a WorkStealingPool while the groups that need their own process are run by
+    /// a ProcessScheduler on the calling thread, both at the same time. If the user asked to fork, those children
+    /// are forks of this process rather than new copies of the executable, and they all run before the pool starts,
+    /// because a fork made while other threads run keeps whatever locks they held. Otherwise, if the user asked to
+    /// reuse processes, the isolated groups are handed to a WorkerProcessPool instead. Groups are started longest
+    /// expected first, or in the order ShuffleTestGroups gives if shuffling. Groups pinned to CPUs are left for
+    /// RunSerializedTests.
+    /// @n @n
+    /// Each thread keeps the results and timings of the groups it finished to itself, and they are added to
+    /// AllResults and TestTimings once everything is done. Logs are written by a LogPublisher as groups finish.
+    /// @n @n
+    /// Once StopRunning is cancelled groups that have not started are skipped and, if the user set a failure limit,
+    /// child processes still running are killed. Either way those groups get a result from RecordStoppedEarly.
     /// @param TestInstances The tests to iterate over and run thread-safe tests.
     /// @param Options The options passed in by the user.
     /// @param AllResults The place to store test results.
     /// @param TestTimings The place to store all test timings.
+    /// @param History How long groups took before, used to decide what to start first.
+    /// @param StopRunning Cancelled when the run should stop early.
     void MEZZ_LIB RunParallelThreads(const CoreTestGroup& TestInstances,
                                      const ParsedCommandLineArgs& Options,
                                      UnitTestGroup::TestDataStorageType& AllResults,
-                                     std::vector<NamedDuration>& TestTimings);
+                                     std::vector<NamedDuration>& TestTimings,
+                                     const TestHistory& History,
+                                     const CancellationToken& StopRunning);
 
     /// @brief Run all the tests that DON'T run in other threads.
+    /// @details Groups run alphabetically, or in the order ShuffleTestGroups gives if shuffling. Groups that
+    /// GetPinnedCpus gives CPUs for run here too, one at a time with the thread running them,
+    /// and any child process it starts, pinned to those CPUs. Nothing else runs at the same time.
+    /// @n @n
+    /// Once StopRunning is cancelled the groups not yet run are skipped, with a result from
+    /// RecordStoppedEarly.
     /// @param TestInstances The tests to iterate over and run all the tests that must no be parallelized.
     /// @param Options The options passed in by the user.
     /// @param AllResults The place to store test results.
     /// @param TestTimings The place to store all test timings.
+    /// @param StopRunning Cancelled when the run should stop early.
     void MEZZ_LIB RunSerializedTests(const CoreTestGroup& TestInstances,
                                      const ParsedCommandLineArgs& Options,
                                      UnitTestGroup::TestDataStorageType& AllResults,
-                                     std::vector<NamedDuration>& TestTimings);
+                                     std::vector<NamedDuration>& TestTimings,
+                                     const CancellationToken& StopRunning);
+
+    /// @brief Names and values that describe a whole run, rather than any one test.
+    using JunitPropertyListType = std::vector<std::pair<String, String>>;
+
+    /// @brief What one test group printed while it ran in child processes.
+    struct MEZZ_LIB JunitGroupOutput
+    {
+        /// @brief The name of the group that printed it.
+        String GroupName;
+        /// @brief What it printed to standard output.
+        String Output;
+        /// @brief What it printed to standard error.
+        String Errors;
+    };
+    /// @brief The output of each test group that printed something, in the order it should be written.
+    using JunitOutputListType = std::vector<JunitGroupOutput>;
+
+    /// @brief Collect what each test group printed in child processes, see UnitTestGroup::AppendCapturedOutput.
+    /// @param TestInstances The test groups to check.
+    /// @return An entry for each group that printed anything, in the order of TestInstances.
+    [[nodiscard]]
+    JunitOutputListType MEZZ_LIB GetJunitOutputs(const CoreTestGroup& TestInstances);
+
+    /// @brief Write results as XML that Jenkins and other Junit compatible tools can use.
+    /// @details Output from the groups is written as the system-out and system-err of the test suite, each group's
+    /// under a line with its name.
+    /// @param Output Where to write the XML.
+    /// @param AllResults The results to write.
+    /// @param Properties Written as the properties of the test suite, if there are any.
+    /// @param Outputs What the test groups printed, if they printed anything.
+    void MEZZ_LIB WriteJunitResults(std::ostream& Output,
+                                    const UnitTestGroup::TestDataStorageType& AllResults,
+                                    const JunitPropertyListType& Properties = JunitPropertyListType{},
+                                    const JunitOutputListType& Outputs = JunitOutputListType{});
 
     /// @brief Write out results as an XML file that Jenkins and other Junit compatible tools can use.
     /// @param AllResults The results to write.
-    void MEZZ_LIB EmitJunitResults(const UnitTestGroup::TestDataStorageType& AllResults);
+    /// @param Properties Written as the properties of the test suite, if there are any.
+    /// @param Outputs What the test groups printed, if they printed anything.
+    void MEZZ_LIB EmitJunitResults(const UnitTestGroup::TestDataStorageType& AllResults,
+                                   const JunitPropertyListType& Properties = JunitPropertyListType{},
+                                   const JunitOutputListType& Outputs = JunitOutputListType{});
 
     /// @brief Run all the tests per their normal execution policies.
+    /// @details Unless told to skip it, this reads the durations of previous runs from HistoryFileName before
+    /// running anything and writes the updated durations back afterwards. Likewise groups with passing results in
+    /// CacheFileName from the same build are replayed instead of run, and new passing results are added to it.
+    /// When sharding only this shard's groups run and their results are also written to the file named by
+    /// GetShardResultsFileName.
     /// @param TestInstances The tests to iterate over run if appropriate.
     /// @param Options The options about what tests to run.
     /// @param TestTimings A collection of timings this will add to.
@@ -186,7 +586,7 @@ namespace Testing
     /// @details This will construct an AllUnitTestGroups with the listing of unit tests available from cmake
     /// generated source file. It will then interpret any command line arguments and direct the created
     /// AllUnitTestGroups about which tests to run and how to run them. In addition to sending the results to the
-    /// standard output a copy of the test results will be written to TestResults.txt, if not configured not to.
+    /// standard output a copy of the test results will be written to ResultsFileName, if not configured not to.
     /// @n @n
     /// If no arguments are passed this will add all the tests to the AllUnitTestGroups
     /// and execute all tests that are not interactive. Print out a default report of them.
@@ -215,6 +615,66 @@ namespace Testing
     /// @copydoc RunInThisProcessToken
     static const Mezzanine::String DebugBToken("debugtests");
 
+    /// @brief A string that if passed stops the run at the first failure.
+    static const Mezzanine::String FailFastToken("failfast");
+    /// @brief A prefix that sets how many failures stop the run, used like "maxfailures=5".
+    static const Mezzanine::String MaxFailuresToken("maxfailures=");
+
+    /// @brief A string that if passed starts test groups in a random order, and shows the seed to repeat it.
+    static const Mezzanine::String ShuffleToken("shuffle");
+    /// @brief A prefix that shuffles test groups into the order a seed gives, used like "seed=12345".
+    static const Mezzanine::String SeedToken("seed=");
+
+    /// @brief A prefix that sets how many times each test group runs, used like "repeat=100".
+    static const Mezzanine::String RepeatToken("repeat=");
+    /// @brief A string that if passed repeats test groups until one of their results is Warning or worse.
+    static const Mezzanine::String UntilFailToken("until-fail");
+    /// @brief A string that if passed runs the repeats of thread safe test groups at the same time.
+    static const Mezzanine::String ConcurrentToken("concurrent");
+
+    /// @brief A prefix that sets how many times a test group with Failed or Unknown results is retried, used like
+    /// "retries=2".
+    static const Mezzanine::String RetriesToken("retries=");
+
+    /// @brief A prefix that sets the CPUs benchmarks are pinned to, used like "benchcpus=2,4-7".
+    static const Mezzanine::String BenchmarkCpusToken("benchcpus=");
+
+    /// @brief A string that if passed runs isolated test groups in reusable worker processes.
+    static const Mezzanine::String ReuseProcessesToken("reuseprocesses");
+    /// @brief A string that if passed runs isolated test groups in forks of this process, rather than starting the
+    /// test executable again for each.
+    static const Mezzanine::String ForkToken("fork");
+    /// @brief A string passed to worker processes to tell them to read test group names from cin.
+    static const Mezzanine::String WorkerProcessToken("workerprocess");
+    /// @brief What a worker process prints on its own line after finishing each test group.
+    static const Mezzanine::String WorkerGroupDoneMarker("--= Mezz_Test worker finished group =--");
+    /// @brief A prefix passed to child processes naming the file descriptor to send result records to.
+    static const Mezzanine::String ResultDescriptorToken("resultfd=");
+
+    /// @brief A prefix that selects one part of the tests to run on this machine, used like "shard=2/4".
+    static const Mezzanine::String ShardToken("shard=");
+    /// @brief A prefix that merges shard results files rather than running tests, used like "merge=A.txt,B.txt".
+    static const Mezzanine::String MergeToken("merge=");
+    /// @brief A prefix that names the history shards are balanced by, used like "shardhistory=Durations.txt".
+    static const Mezzanine::String ShardHistoryToken("shardhistory=");
+
+    /// @brief A string that if passed keeps test group durations from being read or written.
+    static const Mezzanine::String NoHistoryToken("nohistory");
+    /// @brief The file that stores how long each test group took on previous runs.
+    static const Mezzanine::String HistoryFileName("Mezz_Test_History.txt");
+    /// @brief A string that if passed keeps results from being replayed from or stored in the cache.
+    static const Mezzanine::String NoCacheToken("nocache");
+    /// @brief The file that stores passing results for replay while the test binaries do not change.
+    static const Mezzanine::String CacheFileName("Mezz_Test_Cache.txt");
+    /// @brief The file that stores the results of the last run, unless skipped with SkipFileToken.
+    static const Mezzanine::String ResultsFileName("TestResults.txt");
+    /// @brief A string that if passed runs only the test groups that did worse than Warning in ResultsFileName.
+    static const Mezzanine::String FailedToken("failed");
+    /// @brief Appended to the name of a test group to name its timing when it ran in parallel.
+    static const Mezzanine::String ParallelTimingSuffix("-T ");
+    /// @brief Appended to the name of a test group to name its timing when it ran serialized.
+    static const Mezzanine::String SerialTimingSuffix("-S ");
+
     /// @brief A string that if passed on the command tells this to emit Junit XML test results.
     static const Mezzanine::String JunitXMLAToken("xml");
     /// @brief Another string that if passed on the command tells this to emit Junit XML test results.
@@ -223,6 +683,15 @@ namespace Testing
     /// @brief A string that if passed forces single threaded execution.
     static const Mezzanine::String NoThreads("nothreads");
 
+    /// @brief A prefix that sets how many threads run tests, used like "jobs=4".
+    static const Mezzanine::String JobsToken("jobs=");
+    /// @brief A shorter prefix that sets how many threads run tests, used like "-j4".
+    static const Mezzanine::String JobsShortToken("-j");
+    /// @brief A prefix that sets how many child processes run tests at once, used like "processes=4".
+    static const Mezzanine::String ProcessesToken("processes=");
+    /// @brief A prefix that sets how many seconds an isolated test group may run, used like "timeout=300".
+    static const Mezzanine::String TimeoutToken("timeout=");
+
     /// @brief A string that if passed on the command tells this to show the usage.
     static const Mezzanine::String HelpToken("help");
 
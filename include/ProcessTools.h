@@ -43,7 +43,14 @@
 /// @file
 /// @brief Tools for running commands and getting their output.
 
+#include "CancellationToken.h"
 #include "DataTypes.h"
+#include "TimingTools.h"
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <vector>
 
 namespace Mezzanine {
 namespace Testing {
@@ -56,10 +63,366 @@ SUPPRESS_CLANG_WARNING("-Wpadded")
     {
         /// @brief The output to cout from the called process.
         String ConsoleOutput;
+        /// @brief The output to cerr from the called process, read from a pipe of its own so it never mixes with
+        /// ConsoleOutput.
+        String ErrorOutput;
         /// @brief The code returned when the called process exited.
         Integer ExitCode = EXIT_FAILURE;
+        /// @brief The signal that ended the called process, or zero if it exited. ExitCode holds this too.
+        Integer Signal = 0;
+        /// @brief Was the called process killed for running past its time limit?
+        Boole TimedOut = false;
+        /// @brief Was the called process killed, or never started, because the work it was part of was cancelled?
+        Boole Cancelled = false;
+        /// @brief What the called process used while it ran, not measured on Windows.
+        ResourceUsage Usage;
     };//CommandResult
 
+    /// @brief A command already split into its arguments, the first of which is the executable.
+    /// @details Commands given like this are run exactly as split, so no argument needs quoting or escaping.
+    using ArgumentListType = std::vector<String>;
+
+    /// @brief What gets called with each line a child process prints, as soon as that whole line has arrived.
+    /// @details The line ending is not included. Output handed to one of these is not also kept in the
+    /// CommandResult, so memory use does not grow with the amount a child prints. Only standard output is passed
+    /// to these, standard error is always kept in the ErrorOutput of the CommandResult.
+    using OutputLineCallback = std::function<void(const StringView)>;
+
+    /// @brief The file descriptor a child is given for its result channel, when it has one.
+    /// @details A result channel is a second pipe from a child, kept apart from its standard output so nothing the
+    /// child prints can be mistaken for what it sends there. Result channels are not available on Windows.
+    constexpr Integer ResultChannelDescriptor = 3;
+
+    /// @brief What gets called with the bytes from a child's result channel, in the order they arrived.
+    using ResultChannelCallback = std::function<void(const StringView)>;
+
+    /// @brief Runs many commands at once, but never more than a fixed number of child processes.
+    /// @details All the children are watched from the thread that calls Run, their output pipes are polled rather
+    /// than each needing a blocked thread. The stdout, stderr and result channel of every child are polled
+    /// together, so a child never stalls on one full pipe while another is being read. As each child exits its
+    /// completion callback is called on that same thread, so callbacks can safely add more commands.
+    /// @n @n
+    /// A command can be given a time limit. A child that runs past it is killed along with its whole process group,
+    /// and its completion is called with whatever it produced before that and TimedOut set.
+    /// @n @n
+    /// Once a cancellation token given to this is cancelled, from any thread, running children are killed and
+    /// commands not yet started are completed without running. Either way their completion sees Cancelled set.
+    /// @n @n
+    /// On Windows there is no poll for pipes, so the commands are run one at a time with RunCommand and time limits
+    /// are ignored. A cancelled token only stops commands that have not started.
+    class MEZZ_LIB ProcessScheduler
+    {
+    public:
+        /// @brief What gets called with a command's results when it finishes.
+        /// @details The duration passed is the time from launching the child until it exited.
+        using CompletionType = std::function<void(CommandResult&&, std::chrono::nanoseconds)>;
+        /// @brief What a forked child runs instead of a command, it returns the child's exit code.
+        using ForkedWorkType = std::function<Integer()>;
+
+    private:
+        /// @brief A command waiting for a free process slot.
+        struct PendingCommand
+        {
+            /// @brief The whole command, including the executable, empty if this forks to do Work instead.
+            String Command;
+            /// @brief The command split into arguments, which is how it is launched everywhere except Windows.
+            ArgumentListType Arguments;
+            /// @brief What a forked child should do, if this forks rather than running a command.
+            ForkedWorkType Work;
+            /// @brief What to call when it is done.
+            CompletionType WhenDone;
+            /// @brief What to call with each line of output, if anything.
+            OutputLineCallback OnLine;
+            /// @brief What to call with bytes from the result channel, the child only gets one if this is set.
+            ResultChannelCallback OnResults;
+            /// @brief How long the child may run, zero for no limit.
+            std::chrono::nanoseconds TimeLimit;
+        };
+
+        /// @brief A child process that is running and being watched.
+        struct RunningCommand
+        {
+            /// @brief The read end of the pipe connected to the child's stdout, -1 once that closes.
+            Integer ChildPipe = -1;
+            /// @brief The read end of the pipe connected to the child's stderr, -1 once that closes.
+            Integer ErrorPipe = -1;
+            /// @brief The read end of the child's result channel, -1 if it has none or it closed.
+            Integer ResultPipe = -1;
+            /// @brief The operating system's identifier for the child process.
+            Integer ChildID = -1;
+            /// @brief When the child was launched.
+            std::chrono::high_resolution_clock::time_point Launched;
+            /// @brief How long the child may run, zero for no limit.
+            std::chrono::nanoseconds TimeLimit{0};
+            /// @brief Does the child lead its own process group, so the group can be killed with it?
+            Boole LeadsProcessGroup = false;
+            /// @brief Everything gathered so far from the child, or just an unfinished line when streaming.
+            CommandResult Result;
+            /// @brief What to call when it is done.
+            CompletionType WhenDone;
+            /// @brief What to call with each line of output, if anything.
+            OutputLineCallback OnLine;
+            /// @brief What to call with bytes from the result channel, if anything.
+            ResultChannelCallback OnResults;
+        };
+
+        /// @brief Commands not yet started, in the order they were added.
+        std::deque<PendingCommand> Pending;
+        /// @brief Children currently running.
+        std::vector<RunningCommand> Running;
+        /// @brief The most children that may run at once.
+        Whole MaxProcesses;
+        /// @brief Once cancelled nothing more is started and running children are killed.
+        CancellationToken StopToken;
+        /// @brief Was a token set that another thread might cancel while poll is waiting?
+        Boole WatchingStopToken = false;
+
+        /// @brief Start the oldest pending command.
+        void LaunchNext();
+        /// @brief Complete every command that has not started as cancelled.
+        void CancelPending();
+        /// @brief Kill every running child, its completion is called once its pipes close.
+        void KillRunning();
+        /// @brief Kill every child that has run past its time limit.
+        /// @return How long until the next child would run out of time, or a negative value if none can.
+        std::chrono::milliseconds KillOverdueChildren();
+        /// @brief Wait for output from any child and collect any that finished.
+        void WaitForChildren();
+        /// @brief Reap a child whose output and result channel have ended and call its completion.
+        /// @param Index Where in Running the finished child is.
+        void FinishChild(const std::vector<RunningCommand>::size_type Index);
+
+    public:
+        /// @brief Constructor.
+        /// @param ProcessLimit The most child processes to run at once, zero is treated as one.
+        explicit ProcessScheduler(const Whole ProcessLimit);
+        ProcessScheduler(const ProcessScheduler&) = delete;
+        ProcessScheduler(ProcessScheduler&&) = delete;
+        ~ProcessScheduler() = default;
+
+        /// @brief How many child processes this will run at once.
+        /// @return The process limit after clamping.
+        [[nodiscard]]
+        Whole GetMaxProcesses() const;
+
+        /// @brief Queue a command to be run.
+        /// @remarks This checks the command the same way RunCommand does and throws the same exceptions if it is
+        /// unsafe or malformed. This can be called before Run or from inside a completion callback, but not from
+        /// other threads while Run is executing.
+        /// @param Command The command to run, the text until the first space or tab is the executable.
+        /// @param WhenDone Called on the thread executing Run once the command exits.
+        /// @param OnLine If set, called on the thread executing Run with each line as the child prints it. That output
+        /// is then left out of the ConsoleOutput passed to WhenDone.
+        /// @param OnResults If set, the child gets a result channel and this is called on the thread executing Run with
+        /// whatever arrives on it. WhenDone is only called once both the output and the result channel have closed.
+        /// This is ignored on Windows.
+        /// @param TimeLimit How long the child may run before it and its process group are killed, zero for no limit.
+        void AddCommand(const StringView Command, CompletionType WhenDone,
+                        OutputLineCallback OnLine = {}, ResultChannelCallback OnResults = {},
+                        const std::chrono::nanoseconds TimeLimit = std::chrono::nanoseconds::zero());
+
+#ifndef MEZZ_Windows
+        /// @brief Queue a command that is already split into its arguments to be run.
+        /// @details This skips splitting up a command and checking it for unsafe characters, since nothing is
+        /// interpreted. Anything else about it is the same as a command added as text. This is not available on
+        /// Windows.
+        /// @exception std::invalid_argument If there are no arguments, since the first must be the executable.
+        /// @param Arguments The executable, searched for in the system PATH if it has no slash, and its arguments.
+        /// @param WhenDone Called on the thread executing Run once the command exits.
+        /// @param OnLine If set, called on the thread executing Run with each line the child prints.
+        /// @param OnResults If set, the child gets a result channel and this is called on the thread executing Run with
+        /// whatever arrives on it.
+        /// @param TimeLimit How long the child may run before it and its process group are killed, zero for no limit.
+        void AddCommand(ArgumentListType Arguments, CompletionType WhenDone,
+                        OutputLineCallback OnLine = {}, ResultChannelCallback OnResults = {},
+                        const std::chrono::nanoseconds TimeLimit = std::chrono::nanoseconds::zero());
+
+        /// @brief Queue some work to be done in a fork of this process, rather than in a new executable.
+        /// @details The child skips exec, dynamic linking and static initialization, so it starts far quicker
+        /// than a command would, but it has only the thread that called Run. Forking copies this process's page
+        /// tables, so unlike launching a command it gets slower as this process uses more memory. Anything else
+        /// about it is the same as a command added with AddCommand, including time limits and cancellation. Only
+        /// call Run with forks queued while no other thread is running, because the child keeps every lock other
+        /// threads held at the moment it was forked and nothing is left to release them. This is not available on
+        /// Windows.
+        /// @param Work What the child does before exiting, its return is the child's exit code. It is only called
+        /// in the child.
+        /// @param WhenDone Called on the thread executing Run once the child exits.
+        /// @param OnLine If set, called on the thread executing Run with each line the child prints.
+        /// @param OnResults If set, the child gets a result channel and this is called on the thread executing Run with
+        /// whatever arrives on it.
+        /// @param TimeLimit How long the child may run before it and its process group are killed, zero for no limit.
+        void AddFork(ForkedWorkType Work, CompletionType WhenDone,
+                     OutputLineCallback OnLine = {}, ResultChannelCallback OnResults = {},
+                     const std::chrono::nanoseconds TimeLimit = std::chrono::nanoseconds::zero());
+#endif // MEZZ_Windows
+
+        /// @brief Share a token that stops this early when cancelled.
+        /// @remarks Set this before calling Run, the token itself can then be cancelled from any thread.
+        /// @param Token The token to check while running.
+        void SetCancellationToken(CancellationToken Token);
+
+        /// @brief Run every queued command, returning only when all are done.
+        void Run();
+    };//ProcessScheduler
+
+#ifndef MEZZ_Windows
+    /// @brief Keeps a few long lived child processes around and hands them requests one line at a time.
+    /// @details Each worker is started once with the same command, then is sent one request per line on its cin.
+    /// When a worker finishes a request it must print the end marker on a line of its own, everything it printed
+    /// before that is the output for that request. Workers are started lazily, never more than the limit.
+    /// @n @n
+    /// Every worker also gets a result channel. Anything it sends there before printing the end marker belongs to
+    /// the current request.
+    /// @n @n
+    /// If a worker exits while handling a request its partial output is passed to the completion with a non-zero
+    /// ExitCode and a fresh worker is started for the remaining requests. Requests can have a time limit, a worker
+    /// that runs past it is killed along with its process group and the completion has TimedOut set. Cancelling a
+    /// token given to this works like the ProcessScheduler's. Once all requests are done every worker's cin is
+    /// closed so it can exit cleanly.
+    /// @n @n
+    /// Requests are written to a worker's cin even if it just died, so call IgnoreBrokenPipes before using this.
+    class MEZZ_LIB WorkerProcessPool
+    {
+    public:
+        /// @brief What gets called with the output of one request.
+        /// @details The ExitCode is EXIT_SUCCESS if the worker finished the request, otherwise whatever the worker
+        /// exited with, but never EXIT_SUCCESS. The duration is from sending the request to getting its answer.
+        using CompletionType = std::function<void(CommandResult&&, std::chrono::nanoseconds)>;
+
+    private:
+        /// @brief A request waiting for a free worker.
+        struct PendingRequest
+        {
+            /// @brief The line sent to the worker.
+            String Request;
+            /// @brief What to call when it is done.
+            CompletionType WhenDone;
+            /// @brief What to call with each line of output, if anything.
+            OutputLineCallback OnLine;
+            /// @brief What to call with bytes from the result channel, if anything.
+            ResultChannelCallback OnResults;
+            /// @brief How long the worker may take, zero for no limit.
+            std::chrono::nanoseconds TimeLimit;
+        };
+
+        /// @brief One long lived child process.
+        struct Worker
+        {
+            /// @brief The write end of the pipe connected to the worker's cin.
+            Integer ChildInput = -1;
+            /// @brief The read end of the pipe connected to the worker's cout.
+            Integer ChildOutput = -1;
+            /// @brief The read end of the pipe connected to the worker's cerr, -1 if it closed.
+            Integer ChildErrors = -1;
+            /// @brief The read end of the worker's result channel, -1 if it closed.
+            Integer ResultPipe = -1;
+            /// @brief The operating system's identifier for the worker.
+            Integer ChildID = -1;
+            /// @brief Is this working on a request?
+            Boole Busy = false;
+            /// @brief Was this killed for taking too long?
+            Boole TimedOut = false;
+            /// @brief Was this killed because the pool was cancelled?
+            Boole Cancelled = false;
+            /// @brief When the current request was sent.
+            std::chrono::high_resolution_clock::time_point Started;
+            /// @brief How long the current request may take, zero for no limit.
+            std::chrono::nanoseconds TimeLimit{0};
+            /// @brief Everything printed since the current request was sent, or just an unfinished line when streaming.
+            String Output;
+            /// @brief Everything printed to cerr since the current request was sent.
+            String Errors;
+            /// @brief What to call when the current request is done.
+            CompletionType WhenDone;
+            /// @brief What to call with each line of output from the current request, if anything.
+            OutputLineCallback OnLine;
+            /// @brief What to call with bytes from the result channel for the current request, if anything.
+            ResultChannelCallback OnResults;
+        };
+
+        /// @brief Requests not yet sent, in the order they were added.
+        std::deque<PendingRequest> Pending;
+        /// @brief Every worker currently alive.
+        std::vector<Worker> Workers;
+        /// @brief The command used to start every worker.
+        String WorkerCommand;
+        /// @brief The line workers print when done with a request.
+        String EndMarker;
+        /// @brief The most workers that may be alive at once.
+        Whole MaxWorkers;
+        /// @brief Once cancelled no more requests are sent and busy workers are killed.
+        CancellationToken StopToken;
+        /// @brief Was a token set that another thread might cancel while poll is waiting?
+        Boole WatchingStopToken = false;
+
+        /// @brief Send pending requests to idle workers, starting workers as needed.
+        void AssignRequests();
+        /// @brief Complete every request that has not been sent as cancelled.
+        void CancelPending();
+        /// @brief Kill every busy worker, its request is completed once its output closes.
+        void KillBusyWorkers();
+        /// @brief Wait for output from any worker and complete any finished requests.
+        void WaitForWorkers();
+        /// @brief Kill every busy worker that has run past the time limit of its request.
+        /// @return How long until the next request would run out of time, or a negative value if none can.
+        std::chrono::milliseconds KillOverdueWorkers();
+        /// @brief Pass on everything waiting in a worker's result channel without waiting for more.
+        /// @param OneWorker The worker to read from.
+        void DrainResults(Worker& OneWorker);
+        /// @brief Keep everything waiting in a worker's cerr for its current request, without waiting for more.
+        /// @param OneWorker The worker to read from, what it printed while idle is thrown away.
+        void DrainErrors(Worker& OneWorker);
+        /// @brief Complete a worker's current request if its output contains the end marker.
+        /// @param OneWorker The worker to check.
+        void CheckForEndMarker(Worker& OneWorker);
+        /// @brief Clean up after a worker that exited and fail its current request, if any.
+        /// @param Index Where in Workers the worker is.
+        void LoseWorker(const std::vector<Worker>::size_type Index);
+        /// @brief Close every worker's cin and wait for it to exit.
+        void StopWorkers() noexcept;
+
+    public:
+        /// @brief Constructor.
+        /// @param Command The command that starts a worker, checked like RunCommand checks commands.
+        /// @param WorkerLimit The most workers to run at once, zero is treated as one.
+        /// @param Marker The line each worker prints after finishing a request.
+        WorkerProcessPool(const StringView Command, const Whole WorkerLimit, const StringView Marker);
+        WorkerProcessPool(const WorkerProcessPool&) = delete;
+        WorkerProcessPool(WorkerProcessPool&&) = delete;
+        /// @brief Stops any workers still running.
+        ~WorkerProcessPool();
+
+        /// @brief How many workers this will run at once.
+        /// @return The worker limit after clamping.
+        [[nodiscard]]
+        Whole GetMaxWorkers() const;
+
+        /// @brief Queue a request for some worker.
+        /// @remarks This can be called before Run or from inside a completion callback, but not from other threads
+        /// while Run is executing.
+        /// @param Request A single line to send, it must not contain a newline.
+        /// @param WhenDone Called on the thread executing Run once a worker answers the request or dies trying.
+        /// @param OnLine If set, called on the thread executing Run with each line of the answer as the worker prints
+        /// it. That output is then left out of the ConsoleOutput passed to WhenDone.
+        /// @param OnResults If set, called on the thread executing Run with whatever the worker sends on its result
+        /// channel while handling this request. All of it is passed on before WhenDone is called.
+        /// @param TimeLimit How long a worker may take with this before it and its process group are killed, zero for
+        /// no limit.
+        void AddRequest(const StringView Request, CompletionType WhenDone,
+                        OutputLineCallback OnLine = {}, ResultChannelCallback OnResults = {},
+                        const std::chrono::nanoseconds TimeLimit = std::chrono::nanoseconds::zero());
+
+        /// @brief Share a token that stops this early when cancelled.
+        /// @remarks Set this before calling Run, the token itself can then be cancelled from any thread.
+        /// @param Token The token to check while running.
+        void SetCancellationToken(CancellationToken Token);
+
+        /// @brief Handle every queued request, returning only when all are done and the workers have exited.
+        void Run();
+    };//WorkerProcessPool
+#endif // MEZZ_Windows
+
 RESTORE_WARNING_STATE
 
     /// @brief Launches a different process on the system.
@@ -81,6 +444,29 @@ RESTORE_WARNING_STATE
     /// @return Returns the ExitCode and Cout output of the command that was run.
     [[nodiscard]]
     CommandResult MEZZ_LIB RunCommand(const StringView Command);
+    /// @brief Launches a different process on the system and hands over its output one line at a time.
+    /// @remarks This finds the executable the same way as the one parameter version of RunCommand. Each line is
+    /// passed on as soon as it arrives rather than once the process exits, so this suits long running commands
+    /// and commands with huge output.
+    /// @param Command The command to attempt to run and direct its output.
+    /// @param OnLine Called with each line of output, without the line ending.
+    /// @return Returns the ExitCode of the command that was run, the ConsoleOutput will be empty.
+    [[nodiscard]]
+    CommandResult MEZZ_LIB StreamCommand(const StringView Command, const OutputLineCallback& OnLine);
+
+    /// @brief Write all of some bytes to a file descriptor, such as a result channel.
+    /// @exception std::runtime_error If the bytes cannot all be written.
+    /// @param Descriptor The file descriptor to write to.
+    /// @param Bytes What to write.
+    void MEZZ_LIB WriteToDescriptor(const Integer Descriptor, const StringView Bytes);
+
+#ifndef MEZZ_Windows
+    /// @brief Make writing to a pipe nobody reads from an error instead of fatal, for the whole process.
+    /// @remarks What a signal does is shared by every thread, so this should be called once at start-up before
+    /// any threads exist. MainImplementation does this. Children started by these tools have SIGPIPE set back to its
+    /// default, so they still die quietly if their reader goes away.
+    void MEZZ_LIB IgnoreBrokenPipes();
+#endif // MEZZ_Windows
 
     /// @brief Launches a different process on the system through the system shell.
     /// @note ExecutableName cannot be empty on Posix systems or this function will fail.
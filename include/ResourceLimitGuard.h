@@ -0,0 +1,110 @@
+// © Copyright 2010 - 2021 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_ResourceLimitGuard_h
+#define Mezz_Test_ResourceLimitGuard_h
+
+/// @file
+/// @brief The declaration of a way to cap the memory, CPU time and files a process may use for a while.
+
+#include "DataTypes.h"
+
+namespace Mezzanine
+{
+namespace Testing
+{
+    /// @brief The most a process may use of a few things, where zero leaves that thing as it was.
+    struct MEZZ_LIB ResourceLimits
+    {
+        /// @brief The most address space, in bytes, the process may map at once.
+        UInt64 AddressSpaceBytes = 0;
+        /// @brief How many more seconds the process may spend on a CPU.
+        Whole CpuSeconds = 0;
+        /// @brief The highest file descriptor number, plus one, the process may open.
+        Whole OpenFiles = 0;
+
+        /// @brief Is anything limited?
+        /// @return False if every limit is zero.
+        [[nodiscard]]
+        Boole Any() const
+            { return 0 != AddressSpaceBytes || 0 != CpuSeconds || 0 != OpenFiles; }
+    };// ResourceLimits
+
+    /// @brief Used to apply RAII to the resource limits of the whole calling process.
+    /// @details While one of these exists the process, and any child process it starts, gets an error or a signal
+    /// when it goes over a limit. Running out of address space makes allocations fail, running out of CPU time sends
+    /// SIGXCPU which ends the process and running out of files makes opening more fail. Only the soft limits are
+    /// lowered, so they can be put back afterwards, and never past the hard limits. Windows does not support this,
+    /// there nothing is limited and IsLimited says so.
+    class MEZZ_LIB ResourceLimitGuard
+    {
+    private:
+        /// @brief The soft limits before, in the order AddressSpace, Cpu and OpenFiles, to put back when destroyed.
+        UInt64 PreviousLimits[3] = {0, 0, 0};
+        /// @brief Which of the limits were changed and need putting back, in the same order.
+        Boole Changed[3] = {false, false, false};
+        /// @brief Did every limit asked for get applied?
+        Boole Limited = false;
+
+    public:
+        /// @brief Copying this kind of guard would restore the limits twice, so the copy constructor is deleted.
+        ResourceLimitGuard(const ResourceLimitGuard&) = delete;
+        /// @brief Copying this kind of guard would restore the limits twice, so assignment is deleted.
+        ResourceLimitGuard& operator=(const ResourceLimitGuard&) = delete;
+        /// @brief Moving this kind of guard would restore the limits twice, so this is deleted.
+        ResourceLimitGuard(ResourceLimitGuard&&) = delete;
+        /// @brief Moving this kind of guard would restore the limits twice, so this is deleted.
+        ResourceLimitGuard& operator=(ResourceLimitGuard&&) = delete;
+
+        /// @brief Limit the calling process.
+        /// @param Limits The limits to apply, if none are given nothing is changed.
+        explicit ResourceLimitGuard(const ResourceLimits& Limits);
+        /// @brief Put back the limits the process had before.
+        ~ResourceLimitGuard();
+
+        /// @brief Is the process held to every limit asked for?
+        /// @return False if no limits were given, or the operating system refused or does not support one.
+        [[nodiscard]]
+        Boole IsLimited() const;
+    };// ResourceLimitGuard
+
+}// Testing
+}// Mezzanine
+
+#endif
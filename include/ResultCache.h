@@ -0,0 +1,137 @@
+// © Copyright 2010 - 2021 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_ResultCache_h
+#define Mezz_Test_ResultCache_h
+
+/// @file
+/// @brief The declaration of a store of passing results that can be replayed when nothing they depend on changed.
+
+#include "DataTypes.h"
+#include "TestData.h"
+
+#include <iosfwd>
+#include <map>
+#include <vector>
+
+namespace Mezzanine
+{
+namespace Testing
+{
+    /// @brief The passing results of test groups, kept so an unchanged group need not be run again.
+    /// @details Every cache belongs to one build of the tests, named by a fingerprint of the executable and the
+    /// libraries it loaded. Results are looked up by group name and by the arguments that could change them. This is
+    /// stored as plain text, a header line for each entry like "--= Fingerprint Count Arguments Group =--" followed
+    /// by Count results in the format TestData is streamed in. Entries for other fingerprints are dropped when
+    /// loading, so saving never keeps results from an older build, and so are entries with any other number of
+    /// results, because those were cut short or could not be read back.
+    class MEZZ_LIB ResultCache
+    {
+    public:
+        /// @brief The type the results of one group are kept in.
+        using ResultsType = std::vector<TestData>;
+        /// @brief The type used to map keys made by MakeKey to results.
+        using StorageType = std::map<String, ResultsType>;
+
+    private:
+        /// @brief Names the build these results came from.
+        String Fingerprint;
+        /// @brief The results of every group this knows about.
+        StorageType Entries;
+
+        /// @brief Combine a group name and arguments into one key.
+        /// @param GroupName The name of the test group.
+        /// @param Arguments The arguments that could change its results.
+        /// @return A hash of the arguments, a space and then the group name.
+        [[nodiscard]]
+        static String MakeKey(const String& GroupName, const String& Arguments);
+
+    public:
+        /// @brief Create an empty cache for one build of the tests.
+        /// @param BinaryFingerprint What GetLoadedBinariesFingerprint returned for the running tests.
+        explicit ResultCache(const String& BinaryFingerprint);
+
+        /// @brief Find the results stored for a group.
+        /// @param GroupName The name of the test group.
+        /// @param Arguments The arguments the group is about to run with.
+        /// @return The stored results, or nullptr if there are none.
+        [[nodiscard]]
+        const ResultsType* Find(const String& GroupName, const String& Arguments) const;
+        /// @brief Remember the results of a group, replacing anything previously stored for it.
+        /// @param GroupName The name of the test group.
+        /// @param Arguments The arguments the group ran with.
+        /// @param Results What the group produced, the caller is expected to store only passing results.
+        void Store(const String& GroupName, const String& Arguments, ResultsType Results);
+        /// @brief Drop the results of a group, if any are stored.
+        /// @param GroupName The name of the test group.
+        /// @param Arguments The arguments the group ran with.
+        void Forget(const String& GroupName, const String& Arguments);
+        /// @brief How many groups have stored results.
+        /// @return The count of entries.
+        [[nodiscard]]
+        Whole size() const;
+
+        /// @brief Add the entries for this fingerprint from a stream in the format this saves.
+        /// @param Source The stream to read until it ends.
+        void Load(std::istream& Source);
+        /// @brief Write every entry to a stream.
+        /// @param Destination The stream to write to.
+        void Save(std::ostream& Destination) const;
+
+        /// @brief Add the entries for this fingerprint from a file, missing files are treated as empty.
+        /// @param FileName The name of the file to read.
+        void LoadFile(const String& FileName);
+        /// @brief Replace a file with every entry in this cache.
+        /// @details A temporary file is written and then renamed over FileName, so the file is never half written.
+        /// @param FileName The name of the file to write.
+        void SaveFile(const String& FileName) const;
+    };//ResultCache
+
+    /// @brief Hash the contents of the running executable and every shared library it has loaded.
+    /// @details On Linux the files are found through /proc/self/maps. Elsewhere only the executable named by
+    /// CommandName is hashed, so changes to shared libraries go unnoticed there.
+    /// @param CommandName The name this process was started with.
+    /// @return 16 hex digits that change whenever any of those files do, or an empty string if a file could not be
+    /// read and so nothing should be cached.
+    String MEZZ_LIB GetLoadedBinariesFingerprint(const String& CommandName);
+
+}// Testing
+}// Mezzanine
+
+#endif
@@ -0,0 +1,183 @@
+// © Copyright 2010 - 2021 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_ResultRecords_h
+#define Mezz_Test_ResultRecords_h
+
+/// @file
+/// @brief The binary records a child process uses to send test results to its parent.
+
+#include "DataTypes.h"
+#include "TestData.h"
+
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+namespace Mezzanine
+{
+namespace Testing
+{
+    /// @brief What kind of thing a result record holds.
+    enum class ResultRecordType : UInt8
+    {
+        Result  = 1,    ///< One TestData.
+        Log     = 2,    ///< Free text that goes with the results, like the details of a failure.
+        Crash   = 3     ///< The signal that is ending the process and where it happened.
+    };
+
+    SAVE_WARNING_STATE
+    SUPPRESS_CLANG_WARNING("-Wpadded")
+
+    /// @brief One function that was being called when a process crashed.
+    struct MEZZ_LIB CrashFrame
+    {
+        /// @brief Where in memory the code being run was.
+        UInt64 Address = 0;
+        /// @brief How far Address is past the start of Symbol.
+        UInt64 Offset = 0;
+        /// @brief The name the linker knows the function by, still mangled, or empty if it is not exported.
+        String Symbol;
+        /// @brief The executable or library the code is in, if known.
+        String Module;
+    };// CrashFrame
+
+    /// @brief What a crashing process could say about itself before it died.
+    struct MEZZ_LIB CrashReport
+    {
+        /// @brief The signal that ended the process.
+        Integer Signal = 0;
+        /// @brief The address that caused the signal, like the one dereferenced for SIGSEGV. Zero for signals that
+        /// are not faults, like SIGABRT.
+        UInt64 FaultAddress = 0;
+        /// @brief The calls being made when it crashed, innermost first.
+        std::vector<CrashFrame> Frames;
+    };// CrashReport
+
+    RESTORE_WARNING_STATE
+
+    /// @brief Thrown when bytes cannot be decoded as records, so it can be told apart from errors storing them.
+    class MEZZ_LIB MalformedResultRecord : public std::runtime_error
+    {
+    public:
+        using std::runtime_error::runtime_error;
+    };//MalformedResultRecord
+
+    /// @brief Where encoded records are written, such as a pipe to the parent process.
+    using ResultRecordSink = std::function<void(const StringView)>;
+
+    /// @brief Encode one test result as a record.
+    /// @details Every record starts with its length as 4 little endian bytes and then one byte of ResultRecordType.
+    /// A result record follows that with one byte of TestResult, the line number as 8 little endian bytes, then the
+    /// test name, function name and file name, each as a 4 byte little endian length followed by the raw bytes.
+    /// Nothing is escaped, so names may contain anything.
+    /// @param ToEncode The result to encode.
+    /// @return The bytes of the record.
+    [[nodiscard]]
+    String MEZZ_LIB EncodeResultRecord(const TestData& ToEncode);
+
+    /// @brief Encode some log text as a record.
+    /// @details The record is the length and type like every record, followed by the raw bytes of the text.
+    /// @param Text The text to encode.
+    /// @return The bytes of the record.
+    [[nodiscard]]
+    String MEZZ_LIB EncodeLogRecord(const StringView Text);
+
+    /// @brief Encode what a crashing process knows about its crash as a record.
+    /// @details The record is the length and type like every record, then the signal as 4 little endian bytes, the
+    /// fault address as 8, and the count of frames as 4. Each frame follows with its address and offset as 8 bytes
+    /// each, then its symbol and module as sized strings like a result record's names.
+    /// @param ToEncode The crash to encode.
+    /// @return The bytes of the record.
+    [[nodiscard]]
+    String MEZZ_LIB EncodeCrashRecord(const CrashReport& ToEncode);
+
+    SAVE_WARNING_STATE
+    SUPPRESS_CLANG_WARNING("-Wpadded")
+
+    /// @brief Turns bytes back into results and logs, however the bytes happen to be split up as they arrive.
+    /// @details Records are passed on as soon as all of their bytes have been decoded, the bytes of any record not
+    /// yet complete are kept until more arrive.
+    class MEZZ_LIB ResultRecordDecoder
+    {
+    public:
+        /// @brief What gets called with each decoded result.
+        using ResultCallback = std::function<void(TestData&&)>;
+        /// @brief What gets called with each decoded log.
+        using LogCallback = std::function<void(const StringView)>;
+        /// @brief What gets called with each decoded crash.
+        using CrashCallback = std::function<void(CrashReport&&)>;
+
+    private:
+        /// @brief Bytes that do not make up a complete record yet.
+        String Unfinished;
+        /// @brief Where results go.
+        ResultCallback OnResult;
+        /// @brief Where logs go.
+        LogCallback OnLog;
+        /// @brief Where crashes go.
+        CrashCallback OnCrash;
+
+    public:
+        /// @brief Constructor.
+        /// @param ResultHandler Called with every result decoded.
+        /// @param LogHandler Called with every log decoded, may be empty to ignore logs.
+        /// @param CrashHandler Called with every crash decoded, may be empty to ignore crashes.
+        ResultRecordDecoder(ResultCallback ResultHandler,
+                            LogCallback LogHandler = {},
+                            CrashCallback CrashHandler = {});
+
+        /// @brief Decode more bytes.
+        /// @exception MalformedResultRecord If the bytes cannot be records, perhaps because something else wrote to the
+        /// same place. Nothing more should be decoded after this is thrown. Anything the callbacks throw is passed
+        /// on as it is.
+        /// @param Bytes The next bytes, in the order they were written.
+        void Decode(const StringView Bytes);
+
+        /// @brief Are there bytes left over that are not a complete record?
+        /// @return True if a record was cut off, which at the end of the input means the writer stopped early.
+        [[nodiscard]]
+        Boole HasUnfinishedRecord() const;
+    };//ResultRecordDecoder
+
+    RESTORE_WARNING_STATE
+}// Testing
+}// Mezzanine
+
+#endif
@@ -83,6 +83,16 @@ namespace Mezzanine
         /// @param OriginalProcess A string something like the process you want to launch.
         /// @return A string you can actually use as a file name.
         Mezzanine::String MEZZ_LIB SanitizeProcessCommand(const Mezzanine::StringView OriginalProcess);
+
+        /// @brief Get a hash of some text that is the same on every platform, compiler and run.
+        /// @details This is 64 bit FNV-1a, which is simple and spreads short names well. std::hash makes no
+        /// promises about stability so it cannot be used for anything that must agree between machines.
+        /// @param Text The text to hash.
+        /// @param Seed The result of an earlier call to continue from, so long data can be hashed in pieces. The
+        /// default starts a new hash.
+        /// @return A hash of the bytes in Text.
+        Mezzanine::UInt64 MEZZ_LIB StableStringHash(const Mezzanine::StringView Text,
+                                                    const Mezzanine::UInt64 Seed = 14695981039346656037ULL);
     }// Testing
 }// Mezzanine
 
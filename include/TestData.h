@@ -53,18 +53,86 @@ namespace Mezzanine
     /// @brief This contains all the items (except the tests themselves) that make the unit tests work.
     namespace Testing
     {
+        ///////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief A String stored once for the whole process, so each copy of it is only a pointer.
+        /// @details Every assertion records the function and file it was made in, and those come from the same
+        /// __FUNCTION__ and __FILE__ literals for thousands of assertions. Interning them means a TestData only
+        /// owns its name. Interned Strings are never freed, two InternedStrings with equal text always point at
+        /// the same String, so comparing them only compares pointers.
+        class MEZZ_LIB InternedString
+        {
+        private:
+            /// @brief The one copy of this text shared by the whole process.
+            const String* Interned;
+
+        public:
+            /// @brief Create an InternedString holding "".
+            InternedString() noexcept;
+            /// @brief Find or store some text.
+            /// @param ToIntern The text to share.
+            InternedString(const StringView ToIntern);
+            /// @copydoc InternedString(const StringView)
+            InternedString(const String& ToIntern);
+            /// @copydoc InternedString(const StringView)
+            InternedString(const char* ToIntern);
+
+            /// @brief Get the shared text.
+            /// @return A reference to a String that lives until the process exits.
+            const String& str() const noexcept
+                { return *Interned; }
+            /// @copydoc str
+            operator const String&() const noexcept
+                { return *Interned; }
+            /// @return How many characters the shared text has.
+            String::size_type size() const noexcept
+                { return Interned->size(); }
+            /// @return True if the shared text is "", false otherwise.
+            Boole empty() const noexcept
+                { return Interned->empty(); }
+
+            /// @param Rhs The other InternedString to compare.
+            /// @return True if both hold the same text, false otherwise.
+            Boole operator==(const InternedString& Rhs) const noexcept
+                { return Interned == Rhs.Interned; }
+            /// @param Rhs The other InternedString to compare.
+            /// @return True if the texts differ, false otherwise.
+            Boole operator!=(const InternedString& Rhs) const noexcept
+                { return Interned != Rhs.Interned; }
+        };// InternedString
+
+        /// @param Lhs An InternedString to compare.
+        /// @param Rhs A String to compare.
+        /// @return True if both have the same text, false otherwise.
+        Boole MEZZ_LIB operator==(const InternedString& Lhs, const String& Rhs);
+        /// @copydoc operator==(const InternedString&, const String&)
+        Boole MEZZ_LIB operator==(const String& Lhs, const InternedString& Rhs);
+        /// @param Lhs An InternedString to compare.
+        /// @param Rhs A String to compare.
+        /// @return True if the texts differ, false otherwise.
+        Boole MEZZ_LIB operator!=(const InternedString& Lhs, const String& Rhs);
+        /// @copydoc operator!=(const InternedString&, const String&)
+        Boole MEZZ_LIB operator!=(const String& Lhs, const InternedString& Rhs);
+
+        /// @brief Send the text of an InternedString down a stream.
+        /// @param Stream the stream to write to.
+        /// @param ToStream The InternedString to Write.
+        /// @return the stream after modification.
+        std::ostream& MEZZ_LIB operator<< (std::ostream& Stream, const InternedString& ToStream);
+
         SAVE_WARNING_STATE
         SUPPRESS_CLANG_WARNING("-Wpadded")
         ///////////////////////////////////////////////////////////////////////////////////////////
         /// @brief The information about a test and how to easily find it in the filesystem.
+        /// @details Only the name is owned by each TestData, the function and file are interned because they are
+        /// shared by every assertion made in the same place.
         struct MEZZ_LIB TestData
         {
             /// @brief The name of a given test.
             Mezzanine::String TestName;
             /// @brief The function the test was called from.
-            Mezzanine::String FunctionName;
+            InternedString FunctionName;
             /// @brief The File The test happened in.
-            Mezzanine::String FileName;
+            InternedString FileName;
             /// @brief What line in the file this test occurred when the test was compiled.
             Mezzanine::Whole LineNumber;
             /// @brief How did the test turn out.
@@ -78,8 +146,8 @@ namespace Mezzanine
             /// @param Line The line in the file in which the test exists, Defaults to 0.
             explicit TestData(const String& Name = "",
                               TestResult Result = Testing::TestResult::Success,
-                              const String& FuncName = "",
-                              const String& File = "",
+                              const StringView FuncName = "",
+                              const StringView File = "",
                               Mezzanine::Whole Line = 0);
 
             /// @brief Default copy constructible.
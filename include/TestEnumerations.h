@@ -62,12 +62,14 @@ namespace Mezzanine
             Cancelled       = 2,        ///< Was canceled by user, so success is unknown, but any user knows test was
                                         /// cancelled and the test is not failed.
             NonPerformant   = 3,        ///< The Test worked but did not have sufficient performance.
-            Warning         = 4,        ///< Technically the test passed but there is something that is not quite right.
-            Inconclusive    = 5,        ///< If a user answers that with "don't know" in a test that involved
+            Flaky           = 4,        ///< The test failed, but passed when its group was retried, so something
+                                        /// about it is unreliable rather than broken outright.
+            Warning         = 5,        ///< Technically the test passed but there is something that is not quite right.
+            Inconclusive    = 6,        ///< If a user answers that with "don't know" in a test that involved
                                         /// interaction, The user knows there is a potential issue.
-            Failed          = 6,        ///< Known failure.
-            Unknown         = 7,        ///< Since we don't know what happened this is the worst kind of failure.
-            NotApplicable   = 8,        ///< This is not even a kind of failure, This is used to when referencing a
+            Failed          = 7,        ///< Known failure.
+            Unknown         = 8,        ///< Since we don't know what happened this is the worst kind of failure.
+            NotApplicable   = 9,        ///< This is not even a kind of failure, This is used to when referencing a
                                         /// test, so if this winds up coming out of a test, then something has failed.
             Highest = TestResult::NotApplicable  ///< Highest will always match the highest value of the class enum,
                                                  /// to make it easier to inspect.
@@ -86,6 +88,8 @@ namespace Mezzanine
         const Mezzanine::StringView CancelledString         ("Cancelled");
         /// @brief Corresponds to TestResult::NonPerformant.
         const Mezzanine::StringView NonPerformantString     ("NonPerformant");
+        /// @brief Corresponds to TestResult::Flaky.
+        const Mezzanine::StringView FlakyString             ("Flaky");
         /// @brief Corresponds to TestResult::Warning.
         const Mezzanine::StringView WarningString           ("Warning");
         /// @brief Corresponds to TestResult::Inconclusive.
@@ -105,6 +109,8 @@ namespace Mezzanine
         const Mezzanine::StringView CancelledStringBox      ("[   Cancelled   ]");
         /// @brief Corresponds to TestResult::NonPerformant, but in a box. Must contain the non-box version.
         const Mezzanine::StringView NonPerformantStringBox  ("[ NonPerformant ]");
+        /// @brief Corresponds to TestResult::Flaky, but in a box. Must contain the non-box version.
+        const Mezzanine::StringView FlakyStringBox          ("[     Flaky     ]");
         /// @brief Corresponds to TestResult::Warning, but in a box. Must contain the non-box version.
         const Mezzanine::StringView WarningStringBox        ("[    Warning    ]");
         /// @brief Corresponds to TestResult::Inconclusive, but in a box. Must contain the non-box version.
@@ -152,7 +158,7 @@ namespace Mezzanine
         std::ostream& MEZZ_LIB operator<< (std::ostream& Stream, TestResult Output);
 
         /// @brief Roughly convert a String to a TestResult.
-        /// @param Text If this matches a word like "Success", "Skipped", "Cancelled", "Inconclusive", "Failed",
+        /// @param Text If this matches a word like "Success", "Skipped", "Cancelled", "Flaky", "Failed",
         /// "Unknown" or "N/A" exactly as returned by @ref TestResultToString then a valid result can be returned.
         /// @return The @ref TestResult corresponding to the String passed in.
         /// @throw std::invalid_argument If the string passed in does not match a valid TestResult then this will throw
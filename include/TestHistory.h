@@ -0,0 +1,119 @@
+// © Copyright 2010 - 2021 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_TestHistory_h
+#define Mezz_Test_TestHistory_h
+
+/// @file
+/// @brief The declaration of a record of how long each test group took on previous runs.
+
+#include "DataTypes.h"
+
+#include <chrono>
+#include <iosfwd>
+#include <map>
+
+namespace Mezzanine
+{
+namespace Testing
+{
+    /// @brief How long each test group took the last time it ran, so the slow ones can be started first.
+    /// @details This is stored as plain text with one group per line, the duration in nanoseconds, a space and then
+    /// the group name. Lines that cannot be read are ignored, so a damaged file just means less history.
+    class MEZZ_LIB TestHistory
+    {
+    public:
+        /// @brief The precision durations are stored with.
+        using DurationType = std::chrono::nanoseconds;
+        /// @brief The type used to map group names to their durations.
+        using StorageType = std::map<String, DurationType>;
+
+    private:
+        /// @brief The last known duration of every group this knows about.
+        StorageType Durations;
+
+    public:
+        /// @brief Remember how long a group took, replacing anything previously known.
+        /// @param GroupName The name of the test group as it appears in its timings.
+        /// @param Duration How long the group took.
+        void Record(const String& GroupName, const DurationType Duration);
+
+        /// @brief Is there any history for a group?
+        /// @param GroupName The name of the test group to check.
+        /// @return True if the group has a recorded duration.
+        [[nodiscard]]
+        Boole HasDuration(const String& GroupName) const;
+        /// @brief How long a group took last time.
+        /// @param GroupName The name of the test group to check.
+        /// @return The recorded duration, or zero if there is none.
+        [[nodiscard]]
+        DurationType GetDuration(const String& GroupName) const;
+        /// @brief How many groups have history.
+        /// @return The count of recorded groups.
+        [[nodiscard]]
+        Whole size() const;
+
+        /// @brief A sort order that starts groups expected to take longest first.
+        /// @details Groups with no history come before everything else, because they could be slow and finding out
+        /// early is cheap. After that longer groups come before shorter ones.
+        /// @param Left The name of one group.
+        /// @param Right The name of another group.
+        /// @return True if Left should be started before Right.
+        [[nodiscard]]
+        Boole ShouldRunBefore(const String& Left, const String& Right) const;
+
+        /// @brief Add history from a stream in the format this saves, later entries replace earlier ones.
+        /// @param Source The stream to read until it ends.
+        void Load(std::istream& Source);
+        /// @brief Write all the history to a stream.
+        /// @param Destination The stream to write to.
+        void Save(std::ostream& Destination) const;
+
+        /// @brief Add history from a file, missing files are treated as empty.
+        /// @param FileName The name of the file to read.
+        void LoadFile(const String& FileName);
+        /// @brief Replace a file with all of this history.
+        /// @param FileName The name of the file to write.
+        void SaveFile(const String& FileName) const;
+    };//TestHistory
+
+}// Testing
+}// Mezzanine
+
+#endif
@@ -194,14 +194,14 @@ namespace Mezzanine
             /// @param Conditional A boolean result of some kind.
             #ifdef __FUNCTION__
                 #define TEST(Name, Conditional);                                                                       \
-                    Test((Name), (Conditional),                                                                        \
-                         Mezzanine::Testing::TestResult::Failed, Mezzanine::Testing::TestResult::Success,              \
-                         __FUNCTION__, __FILE__, __LINE__ );
+                    TestAt((Name), (Conditional),                                                                      \
+                           Mezzanine::Testing::TestResult::Failed, Mezzanine::Testing::TestResult::Success,            \
+                           __FUNCTION__, __FILE__, __LINE__ );
             #else
                 #define TEST(Name, Conditional);                                                                       \
-                    Test((Name), (Conditional),                                                                        \
-                         Mezzanine::Testing::TestResult::Failed, Mezzanine::Testing::TestResult::Success,              \
-                         __func__, __FILE__, __LINE__ );
+                    TestAt((Name), (Conditional),                                                                      \
+                           Mezzanine::Testing::TestResult::Failed, Mezzanine::Testing::TestResult::Success,            \
+                           __func__, __FILE__, __LINE__ );
             #endif
         #endif
 
@@ -301,17 +301,52 @@ namespace Mezzanine
             /// @param Name The name of the current test.
             #ifdef __FUNCTION__
                 #define TEST_WARN(Name, Conditional)                                                                   \
-                        Test( (Name), (Conditional),                                                                   \
+                        TestAt( (Name), (Conditional),                                                                 \
                             Mezzanine::Testing::TestResult::Warning, Mezzanine::Testing::TestResult::Success,          \
                             __FUNCTION__, __FILE__, __LINE__ );
             #else
                 #define TEST_WARN(Name, Conditional)                                                                   \
-                        Test( (Name), (Conditional),                                                                   \
+                        TestAt( (Name), (Conditional),                                                                 \
                             Mezzanine::Testing::TestResult::Warning, Mezzanine::Testing::TestResult::Success,          \
                             __func__, __FILE__, __LINE__ );
             #endif
         #endif
 
+        #ifndef MEZZ_TEST_AGGREGATED_SITE
+            /// @def MEZZ_TEST_AGGREGATED_SITE
+            /// @brief Used by TEST_AGGREGATED to get what this thread remembers about the assertion being made.
+            /// @details This makes and calls a lambda. Every lambda has a type of its own, so each place this is used
+            /// gets its own thread_local UnitTestGroup::AggregatedSite.
+            #define MEZZ_TEST_AGGREGATED_SITE()                                                                        \
+                []() -> Mezzanine::Testing::UnitTestGroup::AggregatedSite&                                             \
+                    { thread_local Mezzanine::Testing::UnitTestGroup::AggregatedSite Site; return Site; }()
+        #endif
+
+        #ifndef TEST_AGGREGATED
+            /// @def TEST_AGGREGATED
+            /// @brief Just like TEST but for loops, every time this runs it adds to one result.
+            /// @details The first time this line runs it stores a result like TEST would, after that each pass is only
+            /// counted and each failure makes that result Failed. The Name is only evaluated the first time and on
+            /// failures, so it can be built from the loop's variables without slowing down passes. How many times it
+            /// passed and failed, and which iterations the first few failures were, are logged when the group is done
+            /// and can be had from UnitTestGroup::GetAggregatedAssertions. The one result is only passed on, such as to
+            /// the parent of an isolated group, once the group is done.
+            /// @note This calls a member function on the UnitTestGroup class, so it can only be used in UnitTestGroup
+            /// functions or in functions on classes inherited from UnitTestGroup, like BenchmarkTestGroup or
+            /// AutomaticTestGroup.
+            /// @param Name The name of the current test.
+            /// @param Conditional A boolean result of some kind.
+            #ifdef __FUNCTION__
+                #define TEST_AGGREGATED(Name, Conditional)                                                             \
+                        TestAggregated( MEZZ_TEST_AGGREGATED_SITE(), [&]{ return Mezzanine::String(Name); },           \
+                            (Conditional), Mezzanine::Testing::TestResult::Failed, __FUNCTION__, __FILE__, __LINE__ );
+            #else
+                #define TEST_AGGREGATED(Name, Conditional)                                                             \
+                        TestAggregated( MEZZ_TEST_AGGREGATED_SITE(), [&]{ return Mezzanine::String(Name); },           \
+                            (Conditional), Mezzanine::Testing::TestResult::Failed, __func__, __FILE__, __LINE__ );
+            #endif
+        #endif
+
         #ifndef TEST_PERF
             /// @def TEST_PERF
             /// @brief Just like TEST but if the test fails only a NonPerformant result is added.
@@ -326,12 +361,12 @@ namespace Mezzanine
             /// @param Name The name of the current test.
             #ifdef __FUNCTION__
                 #define TEST_PERF(Name, Conditional)                                                                   \
-                        Test( (Name), (Conditional),                                                                   \
+                        TestAt( (Name), (Conditional),                                                                 \
                             Mezzanine::Testing::TestResult::NonPerformant, Mezzanine::Testing::TestResult::Success,    \
                             __FUNCTION__, __FILE__, __LINE__ );
             #else
                 #define TEST_PERF(Name, Conditional)                                                                   \
-                        Test( (Name), (Conditional),                                                                   \
+                        TestAt( (Name), (Conditional),                                                                 \
                             Mezzanine::Testing::TestResult::NonPerformant, Mezzanine::Testing::TestResult::Success,    \
                             __func__, __FILE__, __LINE__ );
             #endif
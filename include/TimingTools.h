@@ -55,6 +55,28 @@ namespace Mezzanine
     {
         SAVE_WARNING_STATE
         SUPPRESS_CLANG_WARNING("-Wpadded") // Emscripten complains here.
+            /// @brief What a child process used while it ran, as the operating system counted it.
+            /// @details Only filled in for processes waited on where the system reports this, which excludes Windows.
+            struct MEZZ_LIB ResourceUsage
+            {
+                /// @brief Were these numbers read from the operating system, or are they all just zero?
+                Boole Measured = false;
+                /// @brief The most memory the process had resident at once, in kibibytes.
+                UInt64 PeakResidentKiB = 0;
+                /// @brief Time spent on a CPU running the process itself.
+                std::chrono::microseconds UserTime = std::chrono::microseconds::zero();
+                /// @brief Time spent on a CPU in the kernel on behalf of the process.
+                std::chrono::microseconds SystemTime = std::chrono::microseconds::zero();
+                /// @brief Page faults that had to wait on a disk.
+                UInt64 MajorFaults = 0;
+                /// @brief Page faults served without any disk, like first touches of fresh memory.
+                UInt64 MinorFaults = 0;
+                /// @brief How often the process gave up the CPU to wait on something, like a lock or a pipe.
+                UInt64 VoluntarySwitches = 0;
+                /// @brief How often the process was taken off the CPU to run something else.
+                UInt64 InvoluntarySwitches = 0;
+            };
+
             /// @brief A simple piece of data to represent the length of a named period of time.
             struct MEZZ_LIB NamedDuration
             {
@@ -63,6 +85,9 @@ namespace Mezzanine
 
                 /// @brief How long did it take.
                 std::chrono::nanoseconds Duration;
+
+                /// @brief What the process that did this used, if it had one to itself.
+                ResourceUsage Usage{};
             };
         RESTORE_WARNING_STATE
 
@@ -99,6 +124,12 @@ namespace Mezzanine
         /// @return The modified stream.
         std::ostream& MEZZ_LIB operator<<(std::ostream& Stream, const NamedDuration& TimingToStream);
 
+        /// @brief Pretty print what a process used, on one line.
+        /// @param Stream the stream, likely cout to send it.
+        /// @param UsageToStream What some process used, this prints nothing unless it was measured.
+        /// @return The modified stream.
+        std::ostream& MEZZ_LIB operator<<(std::ostream& Stream, const ResourceUsage& UsageToStream);
+
         SAVE_WARNING_STATE
         SUPPRESS_CLANG_WARNING("-Wpadded") // Emscripten complains about this and is not performance sensitive.
 
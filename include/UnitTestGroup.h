@@ -45,9 +45,21 @@
 
 
 #include "TestData.h"
+#include "CancellationToken.h"
+#include "CpuPinningGuard.h"
 #include "TestEnumerations.h"
 #include "DataTypes.h"
 
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 namespace Mezzanine
 {
     namespace Testing
@@ -64,10 +76,145 @@ namespace Mezzanine
         public:
             /// @brief The type use to store the results of tests, largely used to clarify derived types.
             typedef std::vector<TestData> TestDataStorageType;
+            /// @brief Something told about each result as it is stored.
+            typedef std::function<void(const TestData&)> ResultListenerType;
+
+            /// @brief How often one test ran and how often it was Warning or worse, while tallying results.
+            struct RepeatTally
+            {
+                /// @brief How many results with this name were stored.
+                Whole Runs = 0;
+                /// @brief How many of those were Warning or worse.
+                Whole Failures = 0;
+            };
+            /// @brief The tallies of every test stored while tallying results, by full test name.
+            typedef std::map<String, RepeatTally> RepeatTallyStorageType;
+
+            /// @brief Every run of one TEST_AGGREGATED assertion, folded into one result.
+            struct AggregatedAssertion
+            {
+                /// @brief The full name of the one result the assertion stored, from the first time it ran.
+                String TestName;
+                /// @brief Where in this group's results that one result is.
+                TestDataStorageType::size_type StorageIndex = 0;
+                /// @brief How many times the assertion passed.
+                Whole Passes = 0;
+                /// @brief How many times the assertion failed.
+                Whole Failures = 0;
+                /// @brief The first few times it failed, counting every time it ran from 0, see MaxAggregatedFailures.
+                std::vector<Whole> FailedIterations;
+            };
+            /// @brief Every assertion made with TEST_AGGREGATED, in the order each first ran.
+            typedef std::vector<AggregatedAssertion> AggregatedAssertionStorageType;
+
+            /// @brief What one thread remembers about one TEST_AGGREGATED assertion, so later passes need no lock.
+            /// @details TEST_AGGREGATED keeps one of these for each thread at each place it is used. It is only trusted
+            /// while it was filled in by the same group, and that group has not cleared its results since.
+            struct AggregatedSite
+            {
+                /// @brief The group that filled this in.
+                const UnitTestGroup* Group = nullptr;
+                /// @brief That group's AggregateGeneration when it filled this in.
+                Whole Generation = 0;
+                /// @brief That group's pass counter for this assertion.
+                std::atomic<Whole>* Passes = nullptr;
+            };
 
         private:
-            /// @brief The test macros will all store their data here.
+            /// @brief The test macros will all store their data here, in the order each name was first stored.
             TestDataStorageType TestDataStorage;
+            /// @brief Where in TestDataStorage the results are, by the hash of their names, so storing one never
+            /// searches or sorts.
+            /// @details Only the hash is kept, the names are only in TestDataStorage. This has one entry per stored
+            /// result, when it has fewer it was released and is rebuilt.
+            std::unordered_multimap<std::size_t, TestDataStorageType::size_type> TestNameIndex;
+            /// @brief Name() and "::", found once because every result stored with AddTestResult starts with it.
+            mutable String NamePrefix;
+            /// @brief Makes sure NamePrefix is found only once, even by copies of this running at once.
+            mutable std::once_flag NamePrefixFound;
+            /// @brief Told about each result as it is stored, if set.
+            ResultListenerType ResultListener;
+            /// @brief Shared with the rest of the run, so this can tell when it should stop early.
+            CancellationToken StopToken;
+            /// @brief How many times each test ran and failed, only filled while tallying results.
+            RepeatTallyStorageType RepeatTallies;
+            /// @brief One TEST_AGGREGATED assertion and the counter its passes add to without the RecordLock.
+            struct AggregatedState
+            {
+                /// @brief Everything but the passes, which are only copied in to hand this out.
+                AggregatedAssertion Assertion;
+                /// @brief How many times the assertion passed.
+                std::atomic<Whole> Passes{0};
+                /// @brief How many times it had run when this group's runs were last tallied.
+                Whole RunsAtLastTally = 0;
+                /// @brief How many times it had failed when this group's runs were last tallied.
+                Whole FailuresAtLastTally = 0;
+                /// @brief Has the ResultListener been told about this yet?
+                Boole ListenerTold = false;
+                /// @brief The result the ResultListener was last told about.
+                TestResult ListenerToldResult = TestResult::Success;
+            };
+            /// @brief Every assertion made with TEST_AGGREGATED so far, a deque so the counters never move.
+            std::deque<AggregatedState> AggregatedAssertions;
+            /// @brief Where in AggregatedAssertions each file and line's assertion is, the file is compared by address
+            /// because it is always the same __FILE__ literal.
+            std::map<std::pair<const char*, Whole>, std::deque<AggregatedState>::size_type> AggregatedSites;
+            /// @brief Different for every group and every time one clears its results, so AggregatedSite entries
+            /// filled in before then are not trusted.
+            Whole AggregateGeneration{ NewAggregateGeneration() };
+            /// @brief What child processes running this printed to their standard output.
+            String CapturedOutput;
+            /// @brief What child processes running this printed to their standard error.
+            String CapturedErrors;
+            /// @brief Keeps copies of this running at once from storing results or logging over each other.
+            mutable std::mutex RecordLock;
+
+            /// @brief Run copies of this at once on a pool of up to ConcurrentJobs threads, and wait for them all.
+            /// @param Copies How many copies to run.
+            void RunConcurrentCopies(const Whole Copies);
+
+            /// @brief Store a result, writing it to the TestLog under the same lock if asked.
+            /// @param CurrentTest The New test results.
+            /// @param LogResult Should CurrentTest be written to the TestLog if it is stored?
+            void StoreResult(TestData&& CurrentTest, const Boole LogResult);
+            /// @brief StoreResult for callers already holding the RecordLock.
+            /// @param CurrentTest The New test results.
+            /// @param LogResult Should CurrentTest be written to the TestLog if it is stored?
+            /// @param Aggregated Is this the first run of a TEST_AGGREGATED assertion? Those are tallied by
+            /// TallyAggregatedRun and told to the ResultListener by FinishAggregatedAssertions instead.
+            /// @return Where in TestDataStorage the result with this name now is.
+            TestDataStorageType::size_type StoreResultWhileLocked(TestData&& CurrentTest,
+                                                                  const Boole LogResult,
+                                                                  const Boole Aggregated = false);
+            /// @brief Find a stored result by name, for callers already holding the RecordLock.
+            /// @param TestName The full name of the result.
+            /// @param NameHash The std::hash of TestName.
+            /// @return Where in TestDataStorage the result is, or the size of TestDataStorage if there is none.
+            TestDataStorageType::size_type FindStoredResult(const StringView TestName,
+                                                            const std::size_t NameHash) const;
+
+            /// @brief Count one run of this group for each TEST_AGGREGATED assertion that ran in it, while tallying.
+            /// @details An assertion run many times in one run of the group is tallied as one run, failed if any of
+            /// those failed. That way a retry that passes makes it Flaky, like any other result.
+            void TallyAggregatedRun();
+
+            /// @brief Tell the ResultListener how every TEST_AGGREGATED assertion turned out, and write that to the
+            /// TestLog if results are emitted.
+            /// @details Aggregated results change while the group runs, so the listener only hears about each once
+            /// it is final. That way a child process sends each one only once. Running the group again, like when
+            /// it is retried, only tells the listener about results that changed since.
+            void FinishAggregatedAssertions();
+
+            /// @return A number no group has used as its AggregateGeneration yet.
+            static Whole NewAggregateGeneration();
+
+            /// @brief Get what every name stored by AddTestResult starts with.
+            /// @return Name() followed by "::", only calling Name() the first time.
+            const String& GetNamePrefix() const;
+
+            /// @brief Should Execute stop repeating before its next run?
+            /// @return True if cancelled, or if repeating until failure and a result is Warning or worse.
+            Boole ShouldStopRepeating() const;
 
         protected:
 
@@ -79,13 +226,32 @@ namespace Mezzanine
 
                 /// @brief Set if this test test is specifically set to run.
                 Boole ShouldExecute = false;
+
+                /// @brief Set if this test's results came from a ResultCache, so it need not be executed.
+                Boole ReplayedFromCache = false;
+
+                /// @brief Set if this keeps repeating until a result is Warning or worse.
+                Boole RepeatUntilFailure = false;
+
+                /// @brief Set if repeats may run as copies at once on their own threads.
+                Boole RepeatConcurrently = false;
+
+                /// @brief How many times Execute runs this, or how many at a time when repeating until failure.
+                Whole RepeatCount = 1;
+
+                /// @brief How many threads repeats running concurrently may use at once.
+                Whole ConcurrentJobs = 1;
+
+                /// @brief Set if results with the same name are tallied instead of refused, see StartTallyingResults.
+                Boole TallyResults = false;
             };
 
             /// @brief All the execution policy bits aligned (padded really) in a way trades space for warning fixes.
             alignas(std::stringstream) ExecutionBitsStruct ExecutionBits;
 
             /// @brief A place for each test to send its logs.
-            /// @details This should be strictly preferred to cout because this is thread safe.
+            /// @details This should be strictly preferred to cout because this is thread safe. Groups that may run
+            /// as several copies at once, see CanRunConcurrentCopies, should use AppendTestLog instead.
             std::stringstream TestLog;
 
         public:
@@ -106,6 +272,10 @@ namespace Mezzanine
             /// @brief Execution operator runs tests in derived classes.
             virtual void operator()() = 0;
 
+            /// @brief Run the tests in this group as many times as SetRepeats asked, once by default.
+            /// @details Exceptions from any run are rethrown once every copy running at the same time is done.
+            void Execute();
+
             /// @brief Get the name of the test group for command line args and other uesr interaction.
             /// @return Any string that uniquely identifies a test.
             virtual Mezzanine::String Name() const = 0;
@@ -128,12 +298,25 @@ namespace Mezzanine
             /// to return false.
             virtual Boole IsMultiThreadSafe() const;
 
+            /// @brief Can several runs of this one group run at once, on different threads?
+            /// @details Being MultiThreadSafe only means this can run alongside other groups. To run alongside itself
+            /// a group must also not change its own members or write to TestLog while it runs, and must log with
+            /// AppendTestLog instead. This is what SetRepeats needs to run repeats concurrently.
+            /// @return Defaults to false, groups that meet all of that can override this to return true.
+            virtual Boole CanRunConcurrentCopies() const;
+
             /// @brief Is it safe to run this test class in parrelel to other tests if done so in a process.
             /// @details If your test grabs a GPU, Sound card or other hardware context, it is probably not
             /// multiprocess safe. If you just spawn a bunch of thread or might segfault this should be safe.
             /// @return defaults to true. All tests that aren't should override this and return false.
             virtual Boole IsMultiProcessSafe() const;
 
+            /// @brief How long this may run in its own process before it is killed.
+            /// @details Only groups run in a child process can be stopped, and not on Windows. A group that runs out
+            /// of time keeps the results it already reported and gets a Cancelled result.
+            /// @return Defaults to zero, which means to use the timeout given on the command line, if any.
+            virtual std::chrono::milliseconds Timeout() const;
+
             /// @brief Decides it the test should run as part of a default invocation of the test suite.
             /// @return Defaults to true. All tests that are interactive or take an inordinate amount of time should
             /// override this and return false.
@@ -144,6 +327,43 @@ namespace Mezzanine
             /// is too unstable for normal
             virtual Boole IsBenchmark() const;
 
+            /// @brief May passing results be replayed from a ResultCache instead of running this again?
+            /// @return Defaults to true for groups that run automatically and are not benchmarks. Groups whose results
+            /// depend on anything besides the test binaries, like files, the network or the clock, should return false.
+            virtual Boole CanCacheResults() const;
+
+            /// @brief Should this run pinned to a few CPUs, while nothing else runs?
+            /// @details Pinned groups run one at a time after the parallel groups are done, so neither moving between
+            /// CPUs nor other tests disturb their timings.
+            /// @return Defaults to true for benchmarks. Nothing is pinned unless PinnedCpus or the command line says
+            /// which CPUs to use.
+            virtual Boole ShouldPinToCpus() const;
+
+            /// @brief Which CPUs to pin this to, if ShouldPinToCpus.
+            /// @return Defaults to an empty list, which means to use the CPUs given on the command line, if any.
+            virtual CpuListType PinnedCpus() const;
+
+            /// @brief The most address space, in bytes, this may map while it runs in its own process.
+            /// @details Like the other resource limits this only applies to groups run in a child process, and not on
+            /// Windows. Going over it makes allocations fail, which a test can catch or let fail the group.
+            /// @return Defaults to zero, which means no limit.
+            virtual UInt64 MaxAddressSpace() const;
+
+            /// @brief How many seconds of CPU time this may use while it runs in its own process.
+            /// @details A child process that uses more is sent SIGXCPU, which ends it.
+            /// @return Defaults to zero, which means no limit.
+            virtual Whole MaxCpuSeconds() const;
+
+            /// @brief How many files this may have open at once while it runs in its own process.
+            /// @details This counts every file descriptor, including the few the child starts with.
+            /// @return Defaults to zero, which means no limit.
+            virtual Whole MaxOpenFiles() const;
+
+            /// @brief How many failures of each TEST_AGGREGATED assertion are remembered and logged one by one.
+            /// @details Every failure is counted, only which iterations the first few were is kept.
+            /// @return Defaults to 10.
+            virtual Whole MaxAggregatedFailures() const;
+
             //////////////////////////////////////////////////////
             // MetaPolicy methods, don't override these, they use the policy methods.
 
@@ -167,6 +387,31 @@ namespace Mezzanine
             /// @brief Interprets the execution bits and returns whether or not this should run
             /// @return True is this should run, false if this should not.
             Boole ShouldRun() const;
+            /// @brief Mark this as having had its results replayed from a ResultCache instead of executing.
+            void SetReplayedFromCache();
+            /// @brief Did this get its results from a ResultCache?
+            /// @return True if SetReplayedFromCache was called, it still counts as run for ShouldRun.
+            Boole WasReplayedFromCache() const;
+            /// @brief Ask Execute to run this more than once, tallying results with the same name instead of
+            /// treating them as a mistake.
+            /// @param Count How many times to run, or how many runs to do between checks when repeating until
+            /// failure.
+            /// @param UntilFailure Keep repeating until a result is Warning or worse, or the run is cancelled.
+            /// @param Concurrently Run the repeats as copies at once, if CanRunConcurrentCopies.
+            /// @param Jobs How many of those copies may run at once, each on a thread of its own.
+            void SetRepeats(const Whole Count, const Boole UntilFailure, const Boole Concurrently,
+                            const Whole Jobs = 1);
+            /// @brief Was this asked to run more than once by SetRepeats?
+            /// @return True if SetRepeats asked for more than one run.
+            Boole IsRepeating() const;
+            /// @brief From now on tally results with the same name instead of treating them as a mistake.
+            /// @details This is how the results of running a group again, like when it is retried, are combined with
+            /// those it already has. Results already stored are counted as one run each. Repeating does this too.
+            void StartTallyingResults();
+            /// @brief Forget every result, tally, log line and captured output, as if this had never run.
+            /// @details This is how a forked copy of this starts afresh. Results are only tallied from then on if
+            /// this is repeating.
+            void ClearResults();
 
             ////////////////////////////////////////////////////////////////////////////////////////////////////////
             // Make all UnitTestGroups look like a container of TestDatas
@@ -191,13 +436,44 @@ namespace Mezzanine
             const_iterator cend() const;
 
             /// @brief If you have exactly the name you want in the report, use this the add the TestData.
+            /// @details While tallying results only those that are Warning or worse are logged.
             /// @param CurrentTest The New test results.
             void AddTestResultWithoutName(TestData&& CurrentTest);
 
+            /// @brief Set something to be told about every result as it is stored, as it happens.
+            /// @param Listener Called with each result after it is stored, an empty function stops this.
+            void SetResultListener(ResultListenerType Listener);
+
+            /// @brief Share a token with the rest of the run, so this can be asked to stop early.
+            /// @param Token The token cancelled when the run should stop.
+            void SetCancellationToken(CancellationToken Token);
+
+            /// @brief Get the token this checks to see if it should stop early.
+            /// @return A copy sharing the same flag.
+            CancellationToken GetCancellationToken() const;
+
+            /// @brief Has the run been asked to stop early?
+            /// @details Long running tests can check this between steps and return early, the results they already
+            /// stored are kept. Nothing forces a test to stop, so those that never check just run to completion.
+            /// @return True once the token shared with this has been cancelled.
+            Boole IsCancelled() const;
+
+            /// @brief Like AddTestResultWithoutName, but never writes to the TestLog.
+            /// @details This is for results that were logged somewhere else already, like by a child process whose
+            /// log is added with AppendTestLog. While tallying results one with the same name as one already stored
+            /// is counted and the worse of the two kept, otherwise that throws.
+            /// @param CurrentTest The New test results.
+            void StoreTestResultWithoutName(TestData&& CurrentTest);
+
             /// @brief Use this to add test results to the final report.
             /// @param CurrentTest The New test results.
             void AddTestResult(TestData&& CurrentTest);
 
+            /// @brief Free what is kept to find stored results by name, all at once.
+            /// @details Call this once the results are published and nothing more is likely to be stored. Storing
+            /// another result afterwards still works, it just has to index every result again first.
+            void ReleaseNameIndex();
+
             ////////////////////////////////////////////////////////////////////////////////////////////////////////
             // Other useful stuff.
 
@@ -209,6 +485,33 @@ namespace Mezzanine
             /// @return A string with the complete contents.
             Mezzanine::String GetTestLog() const;
 
+            /// @brief Add text to the end of the TestLog, such as the log from a child process that ran this group.
+            /// @param Text What to add, exactly as it should appear.
+            void AppendTestLog(const StringView Text);
+
+            /// @brief Keep what a child process printed while running this group and add it to the TestLog.
+            /// @details Output from each run, like retries, is kept after that of the runs before it. Nothing is
+            /// added to the TestLog for output that is empty.
+            /// @param Output What the child printed to its standard output.
+            /// @param Errors What the child printed to its standard error.
+            void AppendCapturedOutput(const StringView Output, const StringView Errors);
+            /// @brief Get what child processes running this printed to their standard output.
+            /// @return Everything kept by AppendCapturedOutput, empty if this never ran in a child or it printed
+            /// nothing.
+            Mezzanine::String GetCapturedOutput() const;
+            /// @brief Get what child processes running this printed to their standard error.
+            /// @return Everything kept by AppendCapturedOutput, empty if this never ran in a child or it printed
+            /// nothing.
+            Mezzanine::String GetCapturedErrors() const;
+
+            /// @brief Get how often each test ran and failed while tallying results.
+            /// @return A tally for every test name stored since tallying started, empty if it has not.
+            RepeatTallyStorageType GetRepeatTallies() const;
+
+            /// @brief Get how every assertion made with TEST_AGGREGATED turned out.
+            /// @return One entry per assertion that ran, in the order each first ran.
+            AggregatedAssertionStorageType GetAggregatedAssertions() const;
+
             ////////////////////////////////////////////////////////////////////////////////////////////////////////
             // Test Macro Functions Backing
 
@@ -236,6 +539,80 @@ namespace Mezzanine
                                     const String& File = "",
                                     Mezzanine::Whole Line = 0);
 
+            /// @copydoc Test
+            /// @details This is what the test macros call, taking the function and file names as views so the
+            /// __FUNCTION__ and __FILE__ literals are not copied into Strings on every assertion. It does not call
+            /// Test, so overriding Test changes only direct calls to it.
+            TestResult TestAt(const String& TestName,
+                              bool TestCondition,
+                              TestResult IfFalse = Testing::TestResult::Failed,
+                              TestResult IfTrue = Testing::TestResult::Success,
+                              const StringView FuncName = "",
+                              const StringView File = "",
+                              Mezzanine::Whole Line = 0);
+
+            /// @brief Like Test, but every run of the assertion at one file and line is folded into one result.
+            /// @details This is for assertions in loops that run many times. The first run stores a result like any
+            /// other, later runs only count passes and worsen that result if they fail. Once a thread has run the
+            /// assertion, its passes are only an atomic increment, the name is not even made. The first few failures
+            /// are logged as they happen and Execute logs the counts, both only if this emits intermediary results.
+            /// The ResultListener is told about the result once, when Execute is done.
+            /// @param Site What this thread remembers about this assertion, one per thread per assertion.
+            /// @param MakeName Called to make the name of the test only when it is needed.
+            /// @param TestCondition The test itself or the results of it.
+            /// @param IfFalse What the result becomes if this fails.
+            /// @param FuncName The function the test was called from.
+            /// @param File The __FILE__ the test is in, this is compared by address to tell assertions apart.
+            /// @param Line The line the test is on.
+            /// @tparam NameMakerType Something callable with no arguments that returns something a String can be
+            /// made from.
+            /// @return The result of this one run of the assertion.
+            template<typename NameMakerType>
+            TestResult TestAggregated(AggregatedSite& Site,
+                                      NameMakerType&& MakeName,
+                                      bool TestCondition,
+                                      TestResult IfFalse,
+                                      const char* FuncName,
+                                      const char* File,
+                                      Mezzanine::Whole Line)
+            {
+                if(TestCondition)
+                {
+                    if(this == Site.Group && AggregateGeneration == Site.Generation)
+                    {
+                        Site.Passes->fetch_add(1, std::memory_order_relaxed);
+                        return Testing::TestResult::Success;
+                    }
+                    if(CountAggregatedPass(Site, File, Line))
+                        { return Testing::TestResult::Success; }
+                }
+                return RecordAggregatedResult(Site, MakeName(), TestCondition, IfFalse, FuncName, File, Line);
+            }
+
+            /// @brief Count a pass of a TEST_AGGREGATED assertion this thread has not remembered yet.
+            /// @param Site Filled in so this thread's later passes need no lock, if the assertion already ran.
+            /// @param File The __FILE__ the test is in.
+            /// @param Line The line the test is on.
+            /// @return False if the assertion never ran before, so nothing was counted.
+            Boole CountAggregatedPass(AggregatedSite& Site, const char* File, const Mezzanine::Whole Line);
+
+            /// @brief Record a run of a TEST_AGGREGATED assertion that failed or that is the first run of it.
+            /// @param Site Filled in so this thread's later passes need no lock.
+            /// @param TestName The name of the test, without the group's name.
+            /// @param TestCondition The test itself or the results of it.
+            /// @param IfFalse What the result becomes if this fails.
+            /// @param FuncName The function the test was called from.
+            /// @param File The __FILE__ the test is in.
+            /// @param Line The line the test is on.
+            /// @return The result of this one run of the assertion.
+            TestResult RecordAggregatedResult(AggregatedSite& Site,
+                                              const String& TestName,
+                                              bool TestCondition,
+                                              TestResult IfFalse,
+                                              const char* FuncName,
+                                              const char* File,
+                                              Mezzanine::Whole Line);
+
             /// @copydoc Test
             /// @brief Test if an expected value and given value are equal.
             /// @param ExpectedResults The amount that the ActualResults must have to pass the test.
@@ -250,18 +627,20 @@ namespace Mezzanine
                            ActualResultsType ActualResults,
                            TestResult IfFalse = Testing::TestResult::Failed,
                            TestResult IfTrue = Testing::TestResult::Success,
-                           const String& FuncName = "",
-                           const String& File = "",
+                           const StringView FuncName = "",
+                           const StringView File = "",
                            Mezzanine::Whole Line = 0)
             {
-                TestResult Result = Test( TestName, (ExpectedResults == ActualResults),
+                TestResult Result = TestAt( TestName, (ExpectedResults == ActualResults),
                     IfFalse, IfTrue, FuncName, File, Line);
                 if(EmitIntermediaryTestResults() && Mezzanine::Testing::TestResult::Success != Result)
                 {
-                    TestLog << "Test - " << TestName << " failed: "
+                    std::stringstream Message;
+                    Message << "Test - " << TestName << " failed: "
                             << "Expected '" << ExpectedResults << "' "
                             << "but actually Received '" << ActualResults << "'."
                             << std::endl;
+                    AppendTestLog(Message.str());
                 }
              }
 
@@ -289,20 +668,22 @@ namespace Mezzanine
                                   Mezzanine::UInt32 EpsilonCount,
                                   TestResult IfFalse = Testing::TestResult::Failed,
                                   TestResult IfTrue = Testing::TestResult::Success,
-                                  const String& FuncName = "",
-                                  const String& File = "",
+                                  const StringView FuncName = "",
+                                  const StringView File = "",
                                   Mezzanine::Whole Line = 0)
             {
                 auto Epsilon( std::numeric_limits<ExpectedResultsType>::epsilon() );
                 Boole Within{ (ExpectedResults - Epsilon * ExpectedResultsType(EpsilonCount)) <= ActualResults &&
                               (ActualResults <= ExpectedResults + Epsilon * ExpectedResultsType(EpsilonCount)) };
-                TestResult Result = Test( TestName, Within, IfFalse, IfTrue, FuncName, File, Line);
+                TestResult Result = TestAt( TestName, Within, IfFalse, IfTrue, FuncName, File, Line);
                 if(EmitIntermediaryTestResults() && Mezzanine::Testing::TestResult::Success != Result)
                 {
-                    TestLog << "Test - " << TestName << " failed: "
+                    std::stringstream Message;
+                    Message << "Test - " << TestName << " failed: "
                             << "Expected '" << ExpectedResults << "' "
                             << "but actually Received '" << ActualResults << "'."
                             << std::endl;
+                    AppendTestLog(Message.str());
                 }
             }
 
@@ -323,19 +704,21 @@ namespace Mezzanine
 
                                  TestResult IfFalse = Testing::TestResult::Failed,
                                  TestResult IfTrue = Testing::TestResult::Success,
-                                 const String& FuncName = "",
-                                 const String& File = "",
+                                 const StringView FuncName = "",
+                                 const StringView File = "",
                                  Mezzanine::Whole Line = 0)
             {
-                TestResult Result = Test( TestName,
+                TestResult Result = TestAt( TestName,
                     (ExpectedLowerBound <= ActualResults) && (ActualResults <= ExpectedUpperBound),
                     IfFalse, IfTrue, FuncName, File, Line);
                 if(EmitIntermediaryTestResults() && Mezzanine::Testing::TestResult::Success != Result)
                 {
-                    TestLog << "Test - " << TestName << " failed: "
+                    std::stringstream Message;
+                    Message << "Test - " << TestName << " failed: "
                             << "Expected within '" << ExpectedLowerBound << "' - '" << ExpectedUpperBound << "' "
                             << "but actually Received '" << ActualResults << "'."
                             << std::endl;
+                    AppendTestLog(Message.str());
                 }
              }
 
@@ -348,8 +731,8 @@ namespace Mezzanine
                            std::function<void()> TestCallable,
                            TestResult IfFalse = Testing::TestResult::Failed,
                            TestResult IfTrue = Testing::TestResult::Success,
-                           const String& FuncName = "",
-                           const String& File = "",
+                           const StringView FuncName = "",
+                           const StringView File = "",
                            Mezzanine::Whole Line = 0)
             {
                 Boole Passed{false};
@@ -360,14 +743,14 @@ namespace Mezzanine
                 catch (const std::exception& e)
                 {
                     if(EmitIntermediaryTestResults())
-                        { TestLog << "Caught Unexpected Exception: " << e.what() << std::endl; }
+                        { AppendTestLog(String("Caught Unexpected Exception: ") + e.what() + "\n"); }
                 }
                 catch (...)
                 {
                     if(EmitIntermediaryTestResults())
-                        { TestLog << "Caught Unexpected Exception not derived of std::expection." << std::endl; }
+                        { AppendTestLog("Caught Unexpected Exception not derived of std::expection.\n"); }
                 }
-                Test(TestName, Passed, IfFalse, IfTrue, FuncName, File, Line);
+                TestAt(TestName, Passed, IfFalse, IfTrue, FuncName, File, Line);
             }
 
             /// @copydoc Test
@@ -377,8 +760,8 @@ namespace Mezzanine
                              std::function<void()> TestCallable,
                              TestResult IfFalse = Testing::TestResult::Failed,
                              TestResult IfTrue = Testing::TestResult::Success,
-                             const String& FuncName = "",
-                             const String& File = "",
+                             const StringView FuncName = "",
+                             const StringView File = "",
                              Mezzanine::Whole Line = 0);
 
             /// @copydoc Test
@@ -392,8 +775,8 @@ namespace Mezzanine
                            std::function<void()> TestCallable,
                            TestResult IfFalse = Testing::TestResult::Failed,
                            TestResult IfTrue = Testing::TestResult::Success,
-                           const String& FuncName = "",
-                           const String& File = "",
+                           const StringView FuncName = "",
+                           const StringView File = "",
                            Mezzanine::Whole Line = 0);
 
             /// @copydoc Test
@@ -410,8 +793,8 @@ namespace Mezzanine
                                 std::function<void()> TestCallable,
                                 TestResult IfFalse = Testing::TestResult::Failed,
                                 TestResult IfTrue = Testing::TestResult::Success,
-                                const String& FuncName = "",
-                                const String& File = "",
+                                const StringView FuncName = "",
+                                const StringView File = "",
                                 Mezzanine::Whole Line = 0);
 
             /// @copydoc Test
@@ -427,26 +810,28 @@ namespace Mezzanine
                                     ActualHaystackType ActualHaystack,
                                     TestResult IfFalse = Testing::TestResult::Failed,
                                     TestResult IfTrue = Testing::TestResult::Success,
-                                    const String& FuncName = "",
-                                    const String& File = "",
+                                    const StringView FuncName = "",
+                                    const StringView File = "",
                                     Mezzanine::Whole Line = 0)
             {
-                TestResult Result = Test( TestName,
-                                          (ExpectedNeedleType::npos != ActualHaystack.find(ExpectedNeedle)),
-                                          IfFalse, IfTrue, FuncName, File, Line);
+                TestResult Result = TestAt( TestName,
+                                            (ExpectedNeedleType::npos != ActualHaystack.find(ExpectedNeedle)),
+                                            IfFalse, IfTrue, FuncName, File, Line);
                 if(EmitIntermediaryTestResults() && Mezzanine::Testing::TestResult::Success != Result)
                 {
-                    TestLog << "Test - " << TestName << " failed: "
+                    std::stringstream Message;
+                    Message << "Test - " << TestName << " failed: "
                             << "Expected to find '" << ExpectedNeedle << "' "
                             << "but haystack was '" << ActualHaystack << "'."
                             << std::endl;
+                    AppendTestLog(Message.str());
                 }
             }
         };// UnitTestGroup
         RESTORE_WARNING_STATE
 
         /// @brief Sort a container of TestDatas and search it for the worst test results.
-        /// @return Scan every test and find the worst result among all test data.
+        /// @return Scan every test and find the worst result among all test data, Success if there are none.
         TestResult GetWorstResults(const UnitTestGroup::TestDataStorageType& ToSearch);
 
         /// @brief A group of testnames and the Actual class that implements those test(s).
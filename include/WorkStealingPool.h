@@ -0,0 +1,171 @@
+// © Copyright 2010 - 2021 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_WorkStealingPool_h
+#define Mezz_Test_WorkStealingPool_h
+
+/// @file
+/// @brief The declaration of a small fixed size thread pool used to run test groups in parallel.
+
+#include "DataTypes.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Mezzanine
+{
+    namespace Testing
+    {
+        SAVE_WARNING_STATE
+        SUPPRESS_CLANG_WARNING("-Wpadded")
+        SUPPRESS_GCC_WARNING("-Wpadded")
+
+        ////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief A fixed number of threads that each own a queue of work and steal from each other when idle.
+        /// @details Work is dealt round robin into one queue per thread. Each thread drains its own queue first then
+        /// takes work from the other queues, so a handful of slow tests cannot leave threads idle while work remains.
+        /// Both the owner and thieves take from the front of a queue, so work starts in roughly the order it was added.
+        /// @n @n
+        /// The thread that calls @ref Run is used as one of the workers, so a pool of one thread never creates any
+        /// threads at all. Work may add more work while the pool is running, and @ref Run only returns once every
+        /// piece of work, including any added that way, has finished.
+        class MEZZ_LIB WorkStealingPool
+        {
+        public:
+            /// @brief The type of a single unit of work the pool can execute.
+            using WorkType = std::function<void()>;
+
+        private:
+            /// @brief One queue per worker thread, each with its own lock so threads rarely contend.
+            struct WorkQueue
+            {
+                /// @brief Protects Work.
+                std::mutex QueueLock;
+                /// @brief Work waiting to be executed.
+                std::deque<WorkType> Work;
+            };
+
+            /// @brief Every worker's queue, indexed by the worker number.
+            std::vector<std::unique_ptr<WorkQueue>> Queues;
+
+            /// @brief Used to wake idle threads when new work arrives or all work is done.
+            std::condition_variable IdleSignal;
+            /// @brief The lock IdleSignal waits with.
+            std::mutex IdleLock;
+            /// @brief If any work threw, the first exception is kept here and rethrown from Run.
+            std::exception_ptr FirstFailure;
+            /// @brief Protects FirstFailure.
+            std::mutex FailureLock;
+
+            /// @brief Work that has been added but has not yet finished executing.
+            std::atomic<Whole> Outstanding{0};
+            /// @brief Work that has been added but has not been taken from a queue yet.
+            std::atomic<Whole> Queued{0};
+            /// @brief Where to deal the next piece of work added from outside the pool.
+            std::atomic<Whole> NextQueue{0};
+
+            /// @brief Try to get work from a specific queue.
+            /// @param QueueIndex Which queue to look in.
+            /// @param Output Where to put the work if any was found.
+            /// @return True if Output was filled with work, false if the queue was empty.
+            Boole TryTake(const Whole QueueIndex, WorkType& Output);
+
+            /// @brief Check this worker's queue, then every other queue for work.
+            /// @param WorkerIndex The worker looking for work.
+            /// @param Output Where to put the work if any was found.
+            /// @return True if Output was filled with work, false if all queues were empty.
+            Boole TryTakeOrSteal(const Whole WorkerIndex, WorkType& Output);
+
+            /// @brief The loop each worker executes until all work is done.
+            /// @param WorkerIndex The number of the worker, which also identifies its queue.
+            void WorkerLoop(const Whole WorkerIndex);
+
+        public:
+            /// @brief Create a pool, but do not start any threads yet.
+            /// @param ThreadCount How many threads to run work on, including the thread that calls Run. If 0 is passed
+            /// this will use 1 thread.
+            explicit WorkStealingPool(const Whole ThreadCount = GetDefaultThreadCount());
+
+            /// @brief Copying a pool of threads makes no sense.
+            WorkStealingPool(const WorkStealingPool&) = delete;
+            /// @brief Moving a pool with threads possibly running makes no sense.
+            WorkStealingPool(WorkStealingPool&&) = delete;
+            /// @brief Copying a pool of threads makes no sense.
+            WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+            /// @brief Moving a pool with threads possibly running makes no sense.
+            WorkStealingPool& operator=(WorkStealingPool&&) = delete;
+
+            /// @brief Default destructor, Run joins all threads so there is nothing to clean up.
+            ~WorkStealingPool() = default;
+
+            /// @brief How many threads will run work?
+            /// @return The number of threads, including the calling thread, that Run will use.
+            Whole GetThreadCount() const;
+
+            /// @brief Add one piece of work to be executed.
+            /// @details This is thread safe and may be called from inside work running on this pool. When called from
+            /// one of this pool's threads the work goes on that thread's own queue, otherwise queues are dealt to
+            /// round robin.
+            /// @param NewWork Some callable thing to execute on one of the pool's threads.
+            void AddWork(WorkType NewWork);
+
+            /// @brief Execute all work, blocking until every piece of work has completed.
+            /// @throw Whatever the first piece of work to throw threw, but only after every thread has finished.
+            void Run();
+
+            /// @brief Which worker is running the calling code?
+            /// @details Work can use this to pick storage of its own, so workers never share it and need not lock.
+            /// @return From 0 up to GetThreadCount() - 1 when called from work on any pool, 0 outside of one.
+            static Whole GetCurrentWorkerIndex();
+
+            /// @brief Get a good number of threads for this machine.
+            /// @return The number of hardware threads, or 1 if that cannot be determined.
+            static Whole GetDefaultThreadCount();
+        };// WorkStealingPool
+        RESTORE_WARNING_STATE
+    }// Testing
+}// Mezzanine
+
+#endif
@@ -81,7 +81,8 @@ namespace Mezzanine
                                          const Mezzanine::Testing::CoreTestGroup& TestGroups)
         {
             return Mezzanine::String("\nUsage: ") + ThisName + (
-                    " [help] [summary] [testlist] [interactive|automatic] [all]\n\t[skipfile] <Test Names>...\n\n"
+                    " [help] [summary] [testlist] [interactive|automatic] [all]\n\t[skipfile] [jobs=N] [processes=N]"
+                    " <Test Names>...\n\n"
                     "<Test Name>      Add this test to the list of tests to run.\n"
                     "Skip-<Test Name> Remove this from the list of tests to run.\n\n"
                     "All:             All test groups will be run.\n"
@@ -90,9 +91,49 @@ namespace Mezzanine
                     "Benchmark:       Run potentially long running benchmarks.\n"
                     "Summary:         Display a count of failures and successes.\n"
                     "SkipFile:        Do not store a copy of the results in TestResults.txt.\n"
+                    "Failed:          Run only the test groups with results worse than Warning in TestResults.txt.\n"
+                    "NoHistory:       Do not read or write Mezz_Test_History.txt, which is used to start the\n"
+                    "                 slowest test groups first.\n"
+                    "NoCache:         Do not replay or store results in Mezz_Test_Cache.txt. Normally groups that\n"
+                    "                 passed are not run again until the executable or its libraries change.\n"
                     "DebugTests:      Run tests in the current process in single thread. Skips crash protection,\n"
                     "                 but eases test debugging.\n"
-                    "NoThreads:       Half of Debugtests, forces single threaded, but allows subprocesses"
+                    "NoThreads:       Half of Debugtests, forces single threaded, but allows subprocesses\n"
+                    "Jobs=N or -jN:   Run parallel test groups on at most N threads, defaults to hardware threads.\n"
+                    "Processes=N:     Run at most N child processes for isolated test groups at once, defaults to\n"
+                    "                 hardware threads.\n"
+                    "Shard=I/N:       Split the scheduled test groups into N disjoint parts and run only part I,\n"
+                    "                 writing its results to Mezz_Test_Shard_I_of_N.txt. Groups are split by name\n"
+                    "                 unless ShardHistory is given.\n"
+                    "ShardHistory=F:  Balance shards by the durations in the history file F, which is only read.\n"
+                    "                 Every machine must be given the same file to agree on the split.\n"
+                    "Merge=A,B,...:   Combine shard results files into one summary and Mezz_Test_Results.xml.\n"
+                    "ReuseProcesses:  Run isolated test groups in long lived worker processes, rather than starting\n"
+                    "                 a process for each. Not available on Windows.\n"
+                    "Fork:            Run isolated test groups in forks of this process, rather than starting it\n"
+                    "                 again for each. This skips loading and static initialization, but the forks\n"
+                    "                 only have the thread that started them, so they all run before any\n"
+                    "                 test group runs on a thread. Not available on Windows.\n"
+                    "FailFast:        Stop at the first result that is Failed or worse, like MaxFailures=1.\n"
+                    "MaxFailures=N:   Stop once N results are Failed or worse. Groups not started are skipped,\n"
+                    "                 isolated groups still running are killed, and both are marked Cancelled.\n"
+                    "                 The summary and XML still cover everything that ran.\n"
+                    "Timeout=N:       Kill an isolated test group that runs longer than N seconds, keeping the\n"
+                    "                 results it already sent. Test groups can set their own. Ignored on Windows.\n"
+                    "Shuffle:         Start test groups in a random order, the summary shows the seed used.\n"
+                    "Seed=N:          Shuffle test groups into the order the seed N gives, to repeat a shuffle.\n"
+                    "Repeat=N:        Run each test group N times, in the same process, and show how often each\n"
+                    "                 test failed.\n"
+                    "Until-Fail:      Keep repeating test groups until a result is Warning or worse. With\n"
+                    "                 Repeat=N they run N times between checks.\n"
+                    "Concurrent:      Run the repeats of test groups that allow it at the same time, on up to\n"
+                    "                 Jobs=N threads.\n"
+                    "Retries=N:       Run test groups with Failed or Unknown results up to N more times, while\n"
+                    "                 other groups still run. Tests that passed on a retry are marked Flaky, which\n"
+                    "                 is shown in the summary but does not fail the run.\n"
+                    "BenchCpus=L:     Pin benchmarks to the CPUs in the list L, like 2,4-7. They run one at a time\n"
+                    "                 after the parallel test groups, and each records the CPUs it used. Only\n"
+                    "                 supported on Linux.\n"
                     "Help:            Display this message.\n\n"
                     "If only test group names are entered, then all tests in those groups are run.\n"
                     "This command is not case sensitive.\n\n"
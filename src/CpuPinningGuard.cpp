@@ -0,0 +1,178 @@
+// © Copyright 2010 - 2021 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+
+/// @file
+/// @brief The definition of a way to keep a thread, and any processes it starts, on chosen CPUs for a while.
+
+#include "CpuPinningGuard.h"
+
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+
+#ifdef MEZZ_Linux
+    #include <sched.h>
+#endif // MEZZ_Linux
+
+namespace
+{
+    using Mezzanine::Boole;
+    using Mezzanine::String;
+    using Mezzanine::Whole;
+
+    /// @brief No machine has this many CPUs, so a list that goes higher is a typo rather than a very long list.
+    constexpr Whole MaxCpuNumber{65535};
+
+    // Reads a CPU number, which unlike most arguments may be zero.
+    Boole ParseCpuNumber(const String& Text, Whole& Number)
+    {
+        const Boole AllDigits = !Text.empty() &&
+            std::all_of(Text.cbegin(), Text.cend(), [](char OneChar)
+                { return 0 != std::isdigit(static_cast<unsigned char>(OneChar)); });
+        std::istringstream Converter(Text);
+        return AllDigits && (Converter >> Number) && Number <= MaxCpuNumber;
+    }
+
+#ifdef MEZZ_Linux
+    Boole SetThreadCpus(const Mezzanine::Testing::CpuListType& Cpus)
+    {
+        cpu_set_t Allowed;
+        CPU_ZERO(&Allowed);
+        for(const Whole OneCpu : Cpus)
+        {
+            if(CPU_SETSIZE <= OneCpu)
+                { return false; }
+            CPU_SET(OneCpu, &Allowed);
+        }
+        return 0 == sched_setaffinity(0, sizeof(Allowed), &Allowed); // 0 is the calling thread.
+    }
+#endif // MEZZ_Linux
+}
+
+namespace Mezzanine
+{
+namespace Testing
+{
+    CpuPinningGuard::CpuPinningGuard(const CpuListType& Cpus)
+    {
+#ifdef MEZZ_Linux
+        if(Cpus.empty())
+            { return; }
+        PreviousCpus = GetThreadCpus();
+        Pinned = !PreviousCpus.empty() && SetThreadCpus(Cpus);
+#else // MEZZ_Linux
+        static_cast<void>(Cpus);
+#endif // MEZZ_Linux
+    }
+
+    CpuPinningGuard::~CpuPinningGuard()
+    {
+#ifdef MEZZ_Linux
+        if(Pinned)
+            { static_cast<void>(SetThreadCpus(PreviousCpus)); }
+#endif // MEZZ_Linux
+    }
+
+    Boole CpuPinningGuard::IsPinned() const
+        { return Pinned; }
+
+    CpuListType GetThreadCpus()
+    {
+        CpuListType Cpus;
+#ifdef MEZZ_Linux
+        cpu_set_t Allowed;
+        CPU_ZERO(&Allowed);
+        if(0 != sched_getaffinity(0, sizeof(Allowed), &Allowed))
+            { return Cpus; }
+        for(Whole OneCpu = 0; OneCpu < CPU_SETSIZE; ++OneCpu)
+        {
+            if(CPU_ISSET(OneCpu, &Allowed))
+                { Cpus.push_back(OneCpu); }
+        }
+#endif // MEZZ_Linux
+        return Cpus;
+    }
+
+    Boole ParseCpuList(const String& Text, CpuListType& Cpus)
+    {
+        CpuListType Parsed;
+        std::istringstream ListStream(Text);
+        String OneEntry;
+        while(std::getline(ListStream, OneEntry, ','))
+        {
+            const String::size_type Dash = OneEntry.find('-');
+            Whole First{0};
+            Whole Last{0};
+            if(String::npos == Dash)
+            {
+                if(!ParseCpuNumber(OneEntry, First))
+                    { return false; }
+                Last = First;
+            } else if(!ParseCpuNumber(OneEntry.substr(0, Dash), First) ||
+                      !ParseCpuNumber(OneEntry.substr(Dash + 1), Last) ||
+                      Last < First) {
+                return false;
+            }
+            for(Whole OneCpu = First; OneCpu <= Last; ++OneCpu)
+                { Parsed.push_back(OneCpu); }
+        }
+        if(Parsed.empty())
+            { return false; }
+
+        std::sort(Parsed.begin(), Parsed.end());
+        Parsed.erase(std::unique(Parsed.begin(), Parsed.end()), Parsed.end());
+        Cpus = std::move(Parsed);
+        return true;
+    }
+
+    String CpuListToString(const CpuListType& Cpus)
+    {
+        String Listed;
+        for(const Whole OneCpu : Cpus)
+        {
+            if(!Listed.empty())
+                { Listed += ','; }
+            Listed += std::to_string(OneCpu);
+        }
+        return Listed;
+    }
+
+}// Testing
+}// Mezzanine
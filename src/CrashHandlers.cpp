@@ -0,0 +1,469 @@
+// © Copyright 2010 - 2021 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+
+/// @file
+/// @brief The definition of a way for child processes to report how they crashed before they die.
+
+#include "CrashHandlers.h"
+
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+#include <cstdlib>
+#include <iomanip>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef MEZZ_Windows
+    #include <cxxabi.h>
+    #include <dlfcn.h>
+    #include <errno.h>
+    #include <execinfo.h>
+    #include <string.h>
+    #include <unistd.h>
+    #ifdef MEZZ_MacOSX
+        #include <mach-o/dyld.h>
+    #else // MEZZ_MacOSX
+        #include <link.h>
+    #endif // MEZZ_MacOSX
+#endif // MEZZ_Windows
+
+namespace
+{
+    using Mezzanine::String;
+    using Mezzanine::UInt64;
+
+    /// @brief The well known signals a test might die of, by name.
+    struct NamedSignal
+    {
+        /// @brief The signal number on this platform.
+        int Number;
+        /// @brief What it is usually called.
+        const char* Name;
+    };
+
+    /// @brief Every signal SignalName knows the name of.
+    const NamedSignal KnownSignals[] = {
+        { SIGABRT, "SIGABRT" }, { SIGFPE, "SIGFPE" }, { SIGILL, "SIGILL" }, { SIGINT, "SIGINT" },
+        { SIGSEGV, "SIGSEGV" }, { SIGTERM, "SIGTERM" },
+#ifndef MEZZ_Windows
+        { SIGBUS, "SIGBUS" }, { SIGKILL, "SIGKILL" }, { SIGPIPE, "SIGPIPE" }, { SIGXCPU, "SIGXCPU" },
+        { SIGXFSZ, "SIGXFSZ" }, { SIGHUP, "SIGHUP" }, { SIGQUIT, "SIGQUIT" }, { SIGTRAP, "SIGTRAP" },
+#endif // MEZZ_Windows
+    };
+
+    // Only these signals come with the address that caused them, the rest carry something else there.
+    bool IsFaultSignal(const int Signal)
+    {
+#ifndef MEZZ_Windows
+        if(SIGBUS == Signal)
+            { return true; }
+#endif // MEZZ_Windows
+        return SIGSEGV == Signal || SIGFPE == Signal || SIGILL == Signal;
+    }
+
+    // Gives back the name unchanged when it is not a mangled C++ name.
+    String Demangle(const String& Symbol)
+    {
+#ifndef MEZZ_Windows
+        int Status = -1;
+        const std::unique_ptr<char, void(*)(void*)> Demangled{
+            abi::__cxa_demangle(Symbol.c_str(), nullptr, nullptr, &Status), std::free };
+        if(0 == Status && Demangled)
+            { return String(Demangled.get()); }
+#endif // MEZZ_Windows
+        return Symbol;
+    }
+
+#ifndef MEZZ_Windows
+    /// @brief One executable or library loaded into a process, and the addresses its code was loaded at.
+    struct LoadedModule
+    {
+        /// @brief What addresses in it are relative to, so the same code has the same offset in every process.
+        UInt64 Base;
+        /// @brief The lowest address it was loaded at.
+        UInt64 Begin;
+        /// @brief One past the highest address it was loaded at.
+        UInt64 End;
+        /// @brief The file it was loaded from.
+        String Name;
+    };
+
+    // The path of the running executable, which the loader does not name itself.
+    String GetExecutableName()
+    {
+#ifdef MEZZ_MacOSX
+        return 0 < ::_dyld_image_count() ? String(::_dyld_get_image_name(0)) : String();
+#else // MEZZ_MacOSX
+        char Path[4096];
+        const ssize_t Length = ::readlink("/proc/self/exe", Path, sizeof(Path));
+        return 0 < Length ? String(Path, static_cast<String::size_type>(Length)) : String();
+#endif // MEZZ_MacOSX
+    }
+
+    // Every module loaded into this process right now. This allocates, so it is never used in a signal handler.
+    std::vector<LoadedModule> GetLoadedModules()
+    {
+        std::vector<LoadedModule> Modules;
+#ifdef MEZZ_MacOSX
+        // The loader only gives where each starts, so each is taken to end where the next one starts.
+        for(uint32_t Index = 0; Index < ::_dyld_image_count(); ++Index)
+        {
+            const UInt64 Header = reinterpret_cast<UInt64>(::_dyld_get_image_header(Index));
+            Modules.push_back(LoadedModule{ Header, Header, std::numeric_limits<UInt64>::max(),
+                                            ::_dyld_get_image_name(Index) });
+        }
+        std::sort(Modules.begin(), Modules.end(), [](const LoadedModule& Left, const LoadedModule& Right)
+            { return Left.Begin < Right.Begin; });
+        for(std::size_t Index = 1; Index < Modules.size(); ++Index)
+            { Modules[Index - 1].End = Modules[Index].Begin; }
+#else // MEZZ_MacOSX
+        ::dl_iterate_phdr([](dl_phdr_info* Info, size_t, void* Found) -> int
+            {
+                LoadedModule OneModule{ Info->dlpi_addr, std::numeric_limits<UInt64>::max(), 0,
+                                        nullptr == Info->dlpi_name ? "" : Info->dlpi_name };
+                for(decltype(Info->dlpi_phnum) Index = 0; Index < Info->dlpi_phnum; ++Index)
+                {
+                    const auto& Segment = Info->dlpi_phdr[Index];
+                    if(PT_LOAD != Segment.p_type)
+                        { continue; }
+                    const UInt64 Start = Info->dlpi_addr + Segment.p_vaddr;
+                    OneModule.Begin = std::min<UInt64>(OneModule.Begin, Start);
+                    OneModule.End = std::max<UInt64>(OneModule.End, Start + Segment.p_memsz);
+                }
+                if(OneModule.Begin < OneModule.End)
+                    { static_cast<std::vector<LoadedModule>*>(Found)->push_back(std::move(OneModule)); }
+                return 0;
+            }, &Modules);
+        // Only the executable comes without a name.
+        for(LoadedModule& OneModule : Modules)
+        {
+            if(OneModule.Name.empty())
+                { OneModule.Name = GetExecutableName(); }
+        }
+#endif // MEZZ_MacOSX
+        return Modules;
+    }
+
+    /// @brief The signals a crash record is sent for.
+    const int CrashSignals[] = { SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT, SIGXCPU };
+    /// @brief The most frames a crash record holds.
+    constexpr int MaxCrashFrames = 64;
+    /// @brief The handler and the signal trampoline the kernel returns through, neither of which crashed.
+    constexpr int HandlerFrames = 2;
+    /// @brief Space for the alternate stack, so a handler can run even if a thread overflowed its own.
+    constexpr std::size_t CrashStackSize = 64 * 1024;
+    /// @brief The most modules the handler knows the addresses of.
+    constexpr std::size_t MaxCrashModules = 256;
+    /// @brief The longest module name the handler keeps, longer ones are cut short.
+    constexpr std::size_t MaxCrashModuleName = 512;
+    /// @brief How long the handler may take before the process is ended anyway, in seconds.
+    constexpr unsigned CrashReportSeconds = 5;
+
+    /// @brief A LoadedModule the handler can read without allocating.
+    struct CrashModule
+    {
+        /// @brief What addresses in it are relative to.
+        UInt64 Base;
+        /// @brief The lowest address it was loaded at.
+        UInt64 Begin;
+        /// @brief One past the highest address it was loaded at.
+        UInt64 End;
+        /// @brief The file it was loaded from, ending in a null.
+        char Name[MaxCrashModuleName];
+    };
+
+    /// @brief Where crash records go, negative until handlers are installed.
+    volatile sig_atomic_t CrashDescriptor = -1;
+    /// @brief Set by the first thread to crash, so only it writes a record and the rest wait for it to finish.
+    std::atomic_flag CrashReported = ATOMIC_FLAG_INIT;
+    /// @brief The handler cannot allocate, so the crash record is built here.
+    char CrashRecordBuffer[64 * 1024];
+    /// @brief The stack the handler runs on for the thread that installed it.
+    char CrashStack[CrashStackSize];
+    /// @brief The modules loaded when handlers were installed.
+    CrashModule CrashModules[MaxCrashModules];
+    /// @brief How many of CrashModules are filled in.
+    std::size_t CrashModuleCount = 0;
+
+    /// @brief Builds a crash record in a fixed buffer, producing the same bytes as EncodeCrashRecord.
+    struct CrashRecordWriter
+    {
+        /// @brief Where the next byte goes.
+        char* Next;
+        /// @brief One past the last usable byte.
+        char* const End;
+
+        /// @brief Is there room for more bytes?
+        /// @param Size How many bytes.
+        /// @return True if they fit.
+        bool Fits(const std::size_t Size) const noexcept
+            { return static_cast<std::size_t>(End - Next) >= Size; }
+
+        /// @brief Write a number as little endian bytes, the caller must have checked it Fits.
+        /// @param Value The number.
+        /// @param Size How many bytes to use.
+        void Append(const UInt64 Value, const std::size_t Size) noexcept
+        {
+            for(std::size_t Index = 0; Index < Size; ++Index)
+                { *Next++ = static_cast<char>( (Value >> (8 * Index)) & 0xFF ); }
+        }
+
+        /// @brief Write a length and then the text, the caller must have checked it Fits.
+        /// @param Text The text, which must end in a null.
+        /// @param Length How many bytes of it to write.
+        void AppendSized(const char* Text, const std::size_t Length) noexcept
+        {
+            Append(Length, 4);
+            ::memcpy(Next, Text, Length);
+            Next += Length;
+        }
+    };
+
+    // Everything here but backtrace is async-signal-safe, there is no allocating, no stdio and no loader lock.
+    // backtrace is not on that list. It was warmed up when handlers were installed so it does not allocate, but a
+    // crash inside the unwinder or the dynamic loader can still leave it waiting forever on a lock, so an alarm ends
+    // the process if the record takes too long.
+    void CrashSignalHandler(int Signal, siginfo_t* Info, void*)
+    {
+        if(CrashReported.test_and_set())
+        {
+            // Another thread is writing its record, and ends the process once it is sent.
+            while(true)
+                { ::pause(); }
+        }
+
+        struct sigaction Default{};
+        Default.sa_handler = SIG_DFL;
+        sigemptyset(&Default.sa_mask);
+        static_cast<void>(::sigaction(SIGALRM, &Default, nullptr));
+        static_cast<void>(::alarm(CrashReportSeconds));
+
+        const int Descriptor = CrashDescriptor;
+        if(0 <= Descriptor)
+        {
+            void* Frames[MaxCrashFrames];
+            const int FrameCount = ::backtrace(Frames, MaxCrashFrames);
+
+            CrashRecordWriter Writer{ CrashRecordBuffer, CrashRecordBuffer + sizeof(CrashRecordBuffer) };
+            Writer.Next += 4; // The length goes here once it is known.
+            Writer.Append(static_cast<UInt64>(Mezzanine::Testing::ResultRecordType::Crash), 1);
+            Writer.Append(static_cast<UInt64>(Signal), 4);
+            const bool HasAddress{ nullptr != Info && IsFaultSignal(Signal) };
+            Writer.Append(reinterpret_cast<UInt64>(HasAddress ? Info->si_addr : nullptr), 8);
+            char* const CountPosition = Writer.Next;
+            Writer.Next += 4;
+
+            // Frames are sent as offsets into the modules they are in, the parent names them.
+            UInt64 Written = 0;
+            for(int Index = HandlerFrames; Index < FrameCount; ++Index)
+            {
+                const UInt64 Address = reinterpret_cast<UInt64>(Frames[Index]);
+                UInt64 Offset = Address;
+                const char* Module = "";
+                for(std::size_t ModuleIndex = 0; ModuleIndex < CrashModuleCount; ++ModuleIndex)
+                {
+                    const CrashModule& OneModule = CrashModules[ModuleIndex];
+                    if(OneModule.Begin <= Address && Address < OneModule.End)
+                    {
+                        Offset = Address - OneModule.Base;
+                        Module = OneModule.Name;
+                        break;
+                    }
+                }
+                const std::size_t ModuleLength = ::strlen(Module);
+                if(!Writer.Fits(8 + 8 + 4 + 4 + ModuleLength))
+                    { break; } // The innermost frames matter most, so just leave off the rest.
+                Writer.Append(Address, 8);
+                Writer.Append(Offset, 8);
+                Writer.AppendSized("", 0);
+                Writer.AppendSized(Module, ModuleLength);
+                ++Written;
+            }
+
+            const std::size_t RecordSize = static_cast<std::size_t>(Writer.Next - CrashRecordBuffer);
+            Writer.Next = CountPosition;
+            Writer.Append(Written, 4);
+            Writer.Next = CrashRecordBuffer;
+            Writer.Append(RecordSize - 4, 4);
+
+            const char* Unwritten = CrashRecordBuffer;
+            std::size_t Remaining = RecordSize;
+            while(0 < Remaining)
+            {
+                const ssize_t Sent = ::write(Descriptor, Unwritten, Remaining);
+                if(Sent < 0 && EINTR == errno)
+                    { continue; }
+                if(Sent <= 0)
+                    { break; }
+                Unwritten += Sent;
+                Remaining -= static_cast<std::size_t>(Sent);
+            }
+        }
+
+        // Die of the same signal, so the parent sees exactly what happened. The handler stays installed until now so
+        // other threads crashing at the same time wait above instead of dying before this record is sent.
+        static_cast<void>(::sigaction(Signal, &Default, nullptr));
+        ::raise(Signal);
+    }
+#endif // MEZZ_Windows
+}
+
+namespace Mezzanine
+{
+namespace Testing
+{
+#ifndef MEZZ_Windows
+    void InstallCrashHandlers(const int Descriptor)
+    {
+        // The first backtrace may load the unwinder, which allocates, so get that over with now.
+        void* Warmup[1];
+        static_cast<void>(::backtrace(Warmup, 1));
+
+        stack_t AlternateStack{};
+        AlternateStack.ss_sp = CrashStack;
+        AlternateStack.ss_size = sizeof(CrashStack);
+        static_cast<void>(::sigaltstack(&AlternateStack, nullptr));
+
+        // The handler cannot ask the loader where modules are, so they are found now.
+        CrashModuleCount = 0;
+        for(const LoadedModule& OneModule : GetLoadedModules())
+        {
+            if(MaxCrashModules == CrashModuleCount)
+                { break; }
+            CrashModule& Kept = CrashModules[CrashModuleCount++];
+            Kept.Base = OneModule.Base;
+            Kept.Begin = OneModule.Begin;
+            Kept.End = OneModule.End;
+            const std::size_t NameLength = std::min(OneModule.Name.size(), MaxCrashModuleName - 1);
+            ::memcpy(Kept.Name, OneModule.Name.data(), NameLength);
+            Kept.Name[NameLength] = '\0';
+        }
+
+        CrashDescriptor = Descriptor;
+        struct sigaction Action{};
+        Action.sa_sigaction = CrashSignalHandler;
+        Action.sa_flags = static_cast<int>(SA_SIGINFO | SA_ONSTACK);
+        sigemptyset(&Action.sa_mask);
+        for(const int OneSignal : CrashSignals)
+            { static_cast<void>(::sigaction(OneSignal, &Action, nullptr)); }
+    }
+#endif // MEZZ_Windows
+
+    String SignalName(const Integer Signal)
+    {
+        for(const NamedSignal& OneSignal : KnownSignals)
+        {
+            if(Signal == OneSignal.Number)
+                { return OneSignal.Name; }
+        }
+        return "signal " + std::to_string(Signal);
+    }
+
+    void NameCrashFrames(CrashReport& Crash)
+    {
+#ifndef MEZZ_Windows
+        const std::vector<LoadedModule> Modules{ GetLoadedModules() };
+        for(CrashFrame& OneFrame : Crash.Frames)
+        {
+            if(!OneFrame.Symbol.empty() || OneFrame.Module.empty())
+                { continue; }
+            const std::vector<LoadedModule>::const_iterator Found = std::find_if(Modules.begin(), Modules.end(),
+                [&OneFrame](const LoadedModule& OneModule){ return OneFrame.Module == OneModule.Name; });
+            if(Modules.end() == Found)
+                { continue; } // Not loaded here, so the offset into the module is the best there is.
+            const UInt64 Here = Found->Base + OneFrame.Offset;
+            Dl_info Named{};
+            if(0 != ::dladdr(reinterpret_cast<void*>(Here), &Named) && nullptr != Named.dli_sname)
+            {
+                OneFrame.Symbol = Named.dli_sname;
+                OneFrame.Offset = Here - reinterpret_cast<UInt64>(Named.dli_saddr);
+            }
+        }
+#endif // MEZZ_Windows
+
+        // Everything inside abort is the same for every abort, so start from whatever called it.
+        if(SIGABRT == Crash.Signal)
+        {
+            const std::vector<CrashFrame>::reverse_iterator Abort = std::find_if(Crash.Frames.rbegin(),
+                Crash.Frames.rend(), [](const CrashFrame& OneFrame){ return "abort" == OneFrame.Symbol; });
+            if(Crash.Frames.rend() != Abort)
+                { Crash.Frames.erase(Crash.Frames.begin(), Abort.base()); }
+        }
+    }
+
+    String GetCrashedFunction(const CrashReport& Crash)
+    {
+        if(Crash.Frames.empty() || Crash.Frames.front().Symbol.empty())
+            { return String(); }
+        return Demangle(Crash.Frames.front().Symbol);
+    }
+
+    String DescribeCrash(const CrashReport& Crash)
+    {
+        std::stringstream Description;
+        Description << "Crashed with " << SignalName(Crash.Signal) << " (" << Crash.Signal << ")";
+        if(IsFaultSignal(Crash.Signal))
+            { Description << " at address 0x" << std::hex << Crash.FaultAddress; }
+        Description << ", backtrace:\n";
+        Whole FrameNumber{0};
+        for(const CrashFrame& OneFrame : Crash.Frames)
+        {
+            Description << std::dec << "  #" << std::left << std::setw(3) << FrameNumber++ << std::hex
+                        << " 0x" << OneFrame.Address << ' ';
+            if(OneFrame.Symbol.empty())
+                { Description << "??"; }
+            else
+                { Description << Demangle(OneFrame.Symbol); }
+            Description << " + 0x" << OneFrame.Offset;
+            if(!OneFrame.Module.empty())
+                { Description << " in " << OneFrame.Module; }
+            Description << '\n';
+        }
+        if(Crash.Frames.empty())
+            { Description << "  No frames could be found.\n"; }
+        return Description.str();
+    }
+
+}// Testing
+}// Mezzanine
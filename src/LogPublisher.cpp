@@ -0,0 +1,134 @@
+// © Copyright 2010 - 2021 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+
+/// @file
+/// @brief The definition of a thread that writes test group logs so the threads running tests never wait on output.
+
+#include "LogPublisher.h"
+
+#include <ostream>
+
+namespace Mezzanine
+{
+namespace Testing
+{
+    LogPublisher::LogPublisher(std::ostream& Output) :
+        Destination(Output),
+        Writer(&LogPublisher::WriterLoop, this)
+        {}
+
+    LogPublisher::~LogPublisher()
+        { Finish(); }
+
+    void LogPublisher::WritePending()
+    {
+        PendingText* Taken = Newest.exchange(nullptr, std::memory_order_acquire);
+        if(nullptr == Taken)
+            { return; }
+
+        // The list is newest first, so reverse it to write things in the order they were published.
+        PendingText* Oldest = nullptr;
+        while(nullptr != Taken)
+        {
+            PendingText* Previous = Taken->Previous;
+            Taken->Previous = Oldest;
+            Oldest = Taken;
+            Taken = Previous;
+        }
+
+        while(nullptr != Oldest)
+        {
+            Destination << Oldest->Text;
+            PendingText* Written = Oldest;
+            Oldest = Oldest->Previous;
+            delete Written;
+        }
+        Destination.flush();
+    }
+
+    void LogPublisher::WriterLoop()
+    {
+        while(true)
+        {
+            {
+                std::unique_lock<std::mutex> Lock(WakeLock);
+                WakeWriter.wait(Lock, [this]()
+                {
+                    return Finishing.load(std::memory_order_acquire) ||
+                           nullptr != Newest.load(std::memory_order_acquire);
+                });
+            }
+            if(Finishing.load(std::memory_order_acquire))
+                { return; } // Finish writes whatever is left.
+            WritePending();
+        }
+    }
+
+    void LogPublisher::Publish(String Text)
+    {
+        PendingText* WasNewest = Newest.load(std::memory_order_relaxed);
+        PendingText* Added = new PendingText{std::move(Text), WasNewest};
+        while(!Newest.compare_exchange_weak(WasNewest, Added, std::memory_order_release, std::memory_order_relaxed))
+            { Added->Previous = WasNewest; }
+
+        // Added may already be written and deleted, so only WasNewest is safe to look at now. If the list was not
+        // empty the writing thread has already been woken and takes this with the rest.
+        if(nullptr == WasNewest)
+        {
+            // Once this gets the lock the writing thread is either waiting already or has yet to check the list.
+            { std::lock_guard<std::mutex> Lock(WakeLock); }
+            WakeWriter.notify_one();
+        }
+    }
+
+    void LogPublisher::Finish()
+    {
+        {
+            std::lock_guard<std::mutex> Lock(WakeLock);
+            Finishing.store(true, std::memory_order_release);
+        }
+        WakeWriter.notify_one();
+        if(Writer.joinable())
+            { Writer.join(); }
+        WritePending(); // Whatever was published after the writing thread last looked.
+    }
+
+}// Testing
+}// Mezzanine
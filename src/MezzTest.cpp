@@ -45,17 +45,38 @@
 #include "Trace.h"
 
 
+#include <algorithm>
+#include <atomic>
+#include <cctype>
 #include <cstdlib>
 #include <iostream>
 #include <iomanip>
+#include <fstream>
+#include <future>
 #include <thread>
-#include <mutex>
+#include <map>
+#include <memory>
+#include <random>
 #include <sstream>
 
 namespace
 {
     using namespace Mezzanine::Testing;
 
+    SAVE_WARNING_STATE
+    SUPPRESS_CLANG_WARNING("-Wpadded")
+    SUPPRESS_GCC_WARNING("-Wpadded")
+    /// @brief What one thread in RunParallelThreads collects from the groups it finished.
+    /// @details Aligned to a cache line so threads filling neighbouring buffers do not slow each other down.
+    struct alignas(64) FinishedGroupsBuffer
+    {
+        /// @brief The results of every group finished, in the order they finished.
+        UnitTestGroup::TestDataStorageType Results;
+        /// @brief How long each of those groups took, except those stopped early.
+        std::vector<NamedDuration> Timings;
+    };
+    RESTORE_WARNING_STATE
+
     Mezzanine::String SanitizeTestNameForJunit(const Mezzanine::String& ToSanitize)
     {
         Mezzanine::String Sanitized;
@@ -74,6 +95,99 @@ namespace
         }
         return Sanitized;
     }
+
+    /// @brief Make text printed by a test safe to put in a CDATA section of the JUnit XML.
+    /// @details A CDATA section cannot contain its own terminator, so that is split across two sections. Control
+    /// characters XML does not allow anywhere are replaced with a question mark.
+    /// @param ToSanitize The text to make safe.
+    /// @return The text, ready to go between a CDATA section's start and end.
+    Mezzanine::String SanitizeOutputForJunit(const Mezzanine::String& ToSanitize)
+    {
+        Mezzanine::String Sanitized;
+        Sanitized.reserve(ToSanitize.size());
+        for( Mezzanine::String::value_type CurrChar : ToSanitize )
+        {
+            const unsigned char Code{ static_cast<unsigned char>(CurrChar) };
+            if(Code < 0x20 && '\t' != CurrChar && '\n' != CurrChar && '\r' != CurrChar)
+                { Sanitized.push_back('?'); }
+            else if('>' == CurrChar && 2 <= Sanitized.size() && 0 == Sanitized.compare(Sanitized.size() - 2, 2, "]]"))
+                { Sanitized.append("]]><![CDATA[>"); }
+            else
+                { Sanitized.push_back(CurrChar); }
+        }
+        return Sanitized;
+    }
+
+    /// @brief Write the output of every group that printed to one stream as a JUnit system-out or system-err.
+    /// @param XmlContents Where the XML is being written.
+    /// @param ElementName The name of the element, either system-out or system-err.
+    /// @param Outputs The output of the groups.
+    /// @param Printed Picks the output of a group to write, standard output or standard error.
+    void WriteJunitGroupOutputs(std::ostream& XmlContents, const Mezzanine::String& ElementName,
+                                const JunitOutputListType& Outputs,
+                                Mezzanine::String JunitGroupOutput::* const Printed)
+    {
+        const Mezzanine::Boole AnyPrinted = std::any_of(Outputs.cbegin(), Outputs.cend(),
+            [Printed](const JunitGroupOutput& OneGroup){ return !(OneGroup.*Printed).empty(); });
+        if(!AnyPrinted)
+            { return; }
+        XmlContents << "    <" << ElementName << "><![CDATA[";
+        for(const JunitGroupOutput& OneGroup : Outputs)
+        {
+            if((OneGroup.*Printed).empty())
+                { continue; }
+            XmlContents << "\n--- " << SanitizeOutputForJunit(OneGroup.GroupName) << " ---\n"
+                        << SanitizeOutputForJunit(OneGroup.*Printed);
+        }
+        XmlContents << "]]></" << ElementName << ">\n";
+    }
+
+    /// @brief Does this process send the logs of its groups to a parent, so printing them too would only repeat them?
+    /// @details The parent keeps what a child prints as that child's output, which should only be what its tests
+    /// printed.
+    /// @param Options The parsed command line options.
+    /// @return True in a child process that has a result channel.
+    Mezzanine::Boole SendsLogsToParent(const ParsedCommandLineArgs& Options)
+        { return Options.InSubProcess && 0 <= Options.ResultDescriptor; }
+
+#ifndef MEZZ_Windows
+    /// @brief Queue a child process that runs one isolated test group and sends its results back.
+    /// @details The child is a fork of this process if the user asked for that, otherwise a new copy of the test
+    /// executable. Either way its results come from its result channel, and what it prints to its standard output
+    /// and error is kept with the group and added to its log.
+    /// @param Scheduler What runs the child.
+    /// @param Options The parsed command line options.
+    /// @param OneTestGroup The test group the child runs, its results are stored here as they arrive.
+    /// @param WhenDone Called once the child exits, after its output is kept and a crash is recorded if it crashed.
+    void AddTestGroupChild(ProcessScheduler& Scheduler,
+                           const ParsedCommandLineArgs& Options,
+                           UnitTestGroup& OneTestGroup,
+                           ProcessScheduler::CompletionType WhenDone)
+    {
+        // The crash record arrives on the result channel before the child is reaped, so it is kept until then.
+        auto Crash = std::make_shared<CrashReport>();
+        auto KeepCrash = [Crash](CrashReport&& Reported){ *Crash = std::move(Reported); };
+        auto WhenChildDone = [&OneTestGroup, Crash, WhenDone = std::move(WhenDone)]
+            (CommandResult&& Result, std::chrono::nanoseconds Duration)
+        {
+            OneTestGroup.AppendCapturedOutput(Result.ConsoleOutput, Result.ErrorOutput);
+            if(0 != Result.Signal && !Result.TimedOut && !Result.Cancelled)
+                { RecordCrashed(OneTestGroup, Result.Signal, *Crash); }
+            WhenDone(std::move(Result), Duration);
+        };
+
+        if(Options.ForkProcesses)
+        {
+            Scheduler.AddFork([&OneTestGroup]() -> Mezzanine::Integer { return RunForkedTestGroup(OneTestGroup); },
+                              WhenChildDone, {}, ReadResultRecordsInto(OneTestGroup, KeepCrash),
+                              GetTimeLimit(Options, OneTestGroup));
+        } else {
+            Scheduler.AddCommand(GetSubProcessArguments(Options, OneTestGroup),
+                                 WhenChildDone, {}, ReadResultRecordsInto(OneTestGroup, KeepCrash),
+                                 GetTimeLimit(Options, OneTestGroup));
+        }
+    }
+#endif // MEZZ_Windows
 }
 
 /// @file
@@ -102,6 +216,60 @@ namespace Testing
         CallingTable[JunitXMLBToken] = [this]() noexcept { EmitJunitXml = true; };
         CallingTable[SkipSummaryToken] = [this]() noexcept { SkipSummary = true; };
         CallingTable[SkipFileToken] = [this]() noexcept { SkipFile = true; };
+        CallingTable[NoHistoryToken] = [this]() noexcept { SkipHistory = true; };
+        CallingTable[NoCacheToken] = [this]() noexcept { SkipCache = true; };
+        CallingTable[ReuseProcessesToken] = [this]() noexcept { ReuseProcesses = true; };
+        CallingTable[WorkerProcessToken] = [this]() noexcept { IsWorkerProcess = true; };
+        CallingTable[ForkToken] = [this]() noexcept { ForkProcesses = true; };
+        CallingTable[FailFastToken] = [this]() noexcept { MaxFailures = 1; };
+        CallingTable[ShuffleToken] = [this]() noexcept { Shuffle = true; };
+        CallingTable[UntilFailToken] = [this]() noexcept { RepeatUntilFailure = true; };
+        CallingTable[ConcurrentToken] = [this]() noexcept { RepeatConcurrently = true; };
+
+        MEZZ_TRACE("Adding arguments with values to delegation table.")
+        ParameterTable[JobsToken] = [this](const String& Value) { ParsePositiveWhole(Value, JobCount); };
+        ParameterTable[JobsShortToken] = ParameterTable[JobsToken];
+        ParameterTable[ProcessesToken] = [this](const String& Value) { ParsePositiveWhole(Value, ProcessCount); };
+        ParameterTable[MaxFailuresToken] = [this](const String& Value) { ParsePositiveWhole(Value, MaxFailures); };
+        ParameterTable[RepeatToken] = [this](const String& Value) { ParsePositiveWhole(Value, RepeatCount); };
+        ParameterTable[RetriesToken] = [this](const String& Value) { ParsePositiveWhole(Value, RetryCount); };
+        ParameterTable[SeedToken] = [this](const String& Value)
+        {
+            Shuffle = true;
+            ParsePositiveWhole(Value, ShuffleSeed);
+        };
+        ParameterTable[TimeoutToken] = [this](const String& Value)
+        {
+            Whole Seconds{0};
+            ParsePositiveWhole(Value, Seconds);
+            Timeout = std::chrono::seconds(static_cast<std::chrono::seconds::rep>(Seconds));
+        };
+        ParameterTable[BenchmarkCpusToken] = [this](const String& Value)
+        {
+            if(!ParseCpuList(Value, BenchmarkCpus))
+            {
+                std::cerr << "CPU list '" << Value << "' should look like '2,4-7'." << std::endl;
+                ExitWithError = EXIT_FAILURE;
+            }
+        };
+        ParameterTable[ShardToken] = [this](const String& Value) { ParseShard(Value); };
+        ParameterTable[MergeToken] = [this](const String& Value) { ParseMergeFileNames(Value); };
+        ParameterTable[ShardHistoryToken] = [this](const String& Value)
+        {
+            if(!std::ifstream(Value))
+            {
+                std::cerr << "Could not read shard history from '" << Value << "'." << std::endl;
+                ExitWithError = EXIT_FAILURE;
+            }
+            ShardHistoryFileName = Value;
+        };
+        ParameterTable[ResultDescriptorToken] = [this](const String& Value)
+        {
+            Whole Descriptor{0};
+            ParsePositiveWhole(Value, Descriptor);
+            if(0 != Descriptor)
+                { ResultDescriptor = static_cast<Integer>(Descriptor); }
+        };
 
         MEZZ_TRACE("Adding debug options to delegation table.")
         auto RunHere = [this]() noexcept
@@ -151,6 +319,25 @@ namespace Testing
             }
         };
 
+        MEZZ_TRACE("Adding rerun failures switch to delegation table.")
+        CallingTable[FailedToken] = [this, &TestInstances]()
+        {
+            DoDefaultTests = false; // Nothing failing last time means nothing to run, not everything.
+            std::ifstream ResultsFile(ResultsFileName);
+            if(!ResultsFile)
+            {
+                std::cerr << "No results from a previous run in '" << ResultsFileName << "' to rerun." << std::endl;
+                ExitWithError = EXIT_FAILURE;
+                return;
+            }
+            const std::vector<String> FailedNames{ ReadFailedGroupNames(ResultsFile) };
+            for(const CoreTestGroup::value_type& OneTest : TestInstances)
+            {
+                if(FailedNames.end() != std::find(FailedNames.begin(), FailedNames.end(), OneTest.second->Name()))
+                    { ScheduleTest(OneTest); }
+            }
+        };
+
         MEZZ_TRACE("Adding interactive test switch to delegation table.")
         CallingTable[InteractiveToken] = [this, &TestInstances]()
         {
@@ -188,6 +375,65 @@ namespace Testing
         OneTest.second->SetForceSkip();
     }
 
+    void ParsedCommandLineArgs::ParsePositiveWhole(const String& Value, Whole& Destination)
+    {
+        const Boole AllDigits = !Value.empty() &&
+            std::all_of(Value.cbegin(), Value.cend(), [](char OneChar)
+                { return 0 != std::isdigit(static_cast<unsigned char>(OneChar)); });
+        std::stringstream Converter(Value);
+        Whole Parsed{0};
+        if(Value.empty())
+        {
+            std::cerr << "Argument is missing its value, it needs a positive whole number." << std::endl;
+            ExitWithError = EXIT_FAILURE;
+            return;
+        }
+        if(!AllDigits || !(Converter >> Parsed) || 0 == Parsed)
+        {
+            std::cerr << "Argument value '" << Value << "' is not a positive whole number." << std::endl;
+            ExitWithError = EXIT_FAILURE;
+            return;
+        }
+        Destination = Parsed;
+    }
+
+    void ParsedCommandLineArgs::ParseShard(const String& Value)
+    {
+        const String::size_type Slash = Value.find('/');
+        if(String::npos == Slash)
+        {
+            std::cerr << "Shard '" << Value << "' should look like 'I/N'." << std::endl;
+            ExitWithError = EXIT_FAILURE;
+            return;
+        }
+
+        Whole Index{0};
+        Whole Count{0};
+        ParsePositiveWhole(Value.substr(0, Slash), Index);
+        ParsePositiveWhole(Value.substr(Slash + 1), Count);
+        if(EXIT_SUCCESS != ExitWithError)
+            { return; }
+        if(Index > Count)
+        {
+            std::cerr << "Shard " << Index << " cannot be run when there are only " << Count << "." << std::endl;
+            ExitWithError = EXIT_FAILURE;
+            return;
+        }
+        ShardIndex = Index;
+        ShardCount = Count;
+    }
+
+    void ParsedCommandLineArgs::ParseMergeFileNames(const String& Value)
+    {
+        std::istringstream NameStream(Value);
+        String OneName;
+        while(std::getline(NameStream, OneName, ','))
+        {
+            if(!OneName.empty())
+                { MergeFileNames.push_back(OneName); }
+        }
+    }
+
     ParsedCommandLineArgs DealWithdCommandLineArgs(int argc, char** argv, const CoreTestGroup& TestInstances)
     {
         ParsedCommandLineArgs Results(TestInstances);
@@ -210,11 +456,22 @@ namespace Testing
             const Mezzanine::String ThisArg(AllLower(argv[c]));           // Insure case insensitivity
             MEZZ_TRACE("Processing argument: " + ThisArg)
             if(Results.CallingTable.count(ThisArg))                               // check for keywords that aren't tests.
-                { Results.CallingTable[ThisArg](); }
+                { Results.CallingTable[ThisArg](); continue; }
+
+            // Arguments with values keep the case of the value, only the prefix is case insensitive.
+            auto Parameter = std::find_if(
+                Results.ParameterTable.begin(), Results.ParameterTable.end(),
+                [&ThisArg](const ParsedCommandLineArgs::ParameterTableType::value_type& Entry)
+                {
+                    return ThisArg.size() >= Entry.first.size() &&
+                           0 == ThisArg.compare(0, Entry.first.size(), Entry.first);
+                }
+            );
+            if(Results.ParameterTable.end() != Parameter)
+                { Parameter->second(Mezzanine::String(argv[c]).substr(Parameter->first.size())); }
             else
             {
-                std::cerr << ThisArg.substr(SkipTestToken.size()) << std::endl
-                          << "Argument '" << ThisArg << "' not valid." << std::endl; // bogus
+                std::cerr << "Argument '" << ThisArg << "' not valid." << std::endl; // bogus
                 Results.ExitWithError = EXIT_FAILURE;
             }
         }
@@ -225,6 +482,14 @@ namespace Testing
             Results.CallingTable[DefaultToken]();
         }
 
+        if(Results.Shuffle && 0 == Results.ShuffleSeed)
+        {
+            MEZZ_TRACE("Choosing a seed to shuffle with.")
+            std::random_device Entropy;
+            const Whole Clock{ static_cast<Whole>(std::chrono::steady_clock::now().time_since_epoch().count()) };
+            Results.ShuffleSeed = ((static_cast<Whole>(Entropy()) << 16) ^ Clock) % 1000000000 + 1; // Easy to type.
+        }
+
         if(EXIT_SUCCESS != Results.ExitWithError) { Usage(Results.CommandName, TestInstances); }
         return Results;
     }
@@ -260,130 +525,937 @@ namespace Testing
             SummaryStream << std::right << std::setw(TimingNameColumnWidth) << OneTiming.Name << ": "
                           << std::left << std::setw(TimingNsColumnWidth) << OneTiming.Duration.count()
                           << PrettyDurationString(OneTiming.Duration) << '\n';
+            if(OneTiming.Usage.Measured)
+                { SummaryStream << std::setw(TimingNameColumnWidth + 2) << "" << OneTiming.Usage << '\n'; }
+        }
+    }
+
+    void RenderRepeatSummary(const CoreTestGroup& TestInstances, std::ostream& SummaryStream)
+    {
+        MEZZ_TRACE("Rendering repeated test tallies.")
+        SummaryStream << "    --= Repeats =--\n";
+        const std::ios_base::fmtflags OldFlags{ SummaryStream.flags() };
+        const std::streamsize OldPrecision{ SummaryStream.precision() };
+        Whole NeverFailed{0};
+        for(const CoreTestGroup::value_type& OneTestGroup : TestInstances)
+        {
+            if(!OneTestGroup.second->ShouldRun() || OneTestGroup.second->WasReplayedFromCache())
+                { continue; }
+            for(const UnitTestGroup::RepeatTallyStorageType::value_type& OneTally :
+                OneTestGroup.second->GetRepeatTallies())
+            {
+                const UnitTestGroup::RepeatTally& Tally = OneTally.second;
+                if(0 == Tally.Failures)
+                {
+                    NeverFailed++;
+                    continue;
+                }
+                const double FailureRate{ 100.0 * static_cast<double>(Tally.Failures) /
+                                                  static_cast<double>(Tally.Runs) };
+                SummaryStream << "  " << OneTally.first << " passed " << (Tally.Runs - Tally.Failures) << " of "
+                              << Tally.Runs << " run(s), a failure rate of " << std::fixed << std::setprecision(1)
+                              << FailureRate << "%.\n";
+            }
+        }
+        SummaryStream.flags(OldFlags);
+        SummaryStream.precision(OldPrecision);
+        SummaryStream << "  " << NeverFailed << " test(s) passed every time they ran.\n";
+    }
+
+    OrderedTestGroups OrderTestGroupsByHistory(const CoreTestGroup& TestInstances, const TestHistory& History)
+    {
+        OrderedTestGroups Ordered;
+        Ordered.reserve(TestInstances.size());
+        for(const CoreTestGroup::value_type& OneTestGroup : TestInstances)
+            { Ordered.push_back(&OneTestGroup); }
+
+        // Stable so groups that tie keep their usual alphabetical order.
+        std::stable_sort(Ordered.begin(), Ordered.end(),
+            [&History](const CoreTestGroup::value_type* Left, const CoreTestGroup::value_type* Right)
+                { return History.ShouldRunBefore(Left->second->Name(), Right->second->Name()); }
+        );
+        return Ordered;
+    }
+
+    OrderedTestGroups ShuffleTestGroups(const CoreTestGroup& TestInstances, const Whole Seed)
+    {
+        OrderedTestGroups Shuffled;
+        Shuffled.reserve(TestInstances.size());
+        for(const CoreTestGroup::value_type& OneTestGroup : TestInstances)
+            { Shuffled.push_back(&OneTestGroup); }
+
+        // Fisher-Yates, drawing each index by rejection so no index is favored and no library choice sneaks in.
+        std::mt19937_64 Generator(Seed);
+        for(Whole Remaining = Shuffled.size(); 1 < Remaining; --Remaining)
+        {
+            const UInt64 Limit = std::mt19937_64::max() - std::mt19937_64::max() % Remaining;
+            UInt64 Draw = Generator();
+            while(Limit <= Draw)
+                { Draw = Generator(); }
+            std::swap(Shuffled[Remaining - 1], Shuffled[static_cast<Whole>(Draw % Remaining)]);
+        }
+        return Shuffled;
+    }
+
+    OrderedTestGroups SelectShard(const OrderedTestGroups& Candidates,
+                                  const TestHistory& History,
+                                  const Whole ShardIndex,
+                                  const Whole ShardCount)
+    {
+        std::map<const CoreTestGroup::value_type*, Whole> Assignment;
+        OrderedTestGroups Known;
+        for(const CoreTestGroup::value_type* OneTestGroup : Candidates)
+        {
+            const String GroupName = OneTestGroup->second->Name();
+            if(History.HasDuration(GroupName))
+                { Known.push_back(OneTestGroup); }
+            else
+                { Assignment[OneTestGroup] = StableStringHash(GroupName) % ShardCount; }
+        }
+
+        // Longest processing time first, ties broken by name so every shard sorts the same way.
+        std::sort(Known.begin(), Known.end(),
+            [&History](const CoreTestGroup::value_type* Left, const CoreTestGroup::value_type* Right)
+            {
+                const TestHistory::DurationType LeftDuration = History.GetDuration(Left->second->Name());
+                const TestHistory::DurationType RightDuration = History.GetDuration(Right->second->Name());
+                if(LeftDuration != RightDuration)
+                    { return LeftDuration > RightDuration; }
+                return Left->second->Name() < Right->second->Name();
+            }
+        );
+        std::vector<TestHistory::DurationType> Loads(ShardCount, TestHistory::DurationType{0});
+        for(const CoreTestGroup::value_type* OneTestGroup : Known)
+        {
+            const Whole Lightest =
+                static_cast<Whole>(std::distance(Loads.begin(), std::min_element(Loads.begin(), Loads.end())));
+            Loads[Lightest] += History.GetDuration(OneTestGroup->second->Name());
+            Assignment[OneTestGroup] = Lightest;
+        }
+
+        OrderedTestGroups Selected;
+        for(const CoreTestGroup::value_type* OneTestGroup : Candidates)
+        {
+            if(ShardIndex - 1 == Assignment[OneTestGroup])
+                { Selected.push_back(OneTestGroup); }
+        }
+        return Selected;
+    }
+
+    String GetShardResultsFileName(const Whole ShardIndex, const Whole ShardCount)
+        { return "Mezz_Test_Shard_" + std::to_string(ShardIndex) + "_of_" + std::to_string(ShardCount) + ".txt"; }
+
+    void EmitShardResults(const CoreTestGroup& TestInstances, std::ostream& Destination)
+    {
+        for(const CoreTestGroup::value_type& OneTestGroup : TestInstances)
+        {
+            if(!OneTestGroup.second->ShouldRun())
+                { continue; }
+            Destination << "--= " << OneTestGroup.second->Name() << " =--\n";
+            for(const TestData& OneResult : *(OneTestGroup.second))
+                { Destination << OneResult; }
+        }
+    }
+
+    UnitTestGroup::TestDataStorageType ReadTestResults(std::istream& Source)
+    {
+        UnitTestGroup::TestDataStorageType Results;
+        String OneLine;
+        while(std::getline(Source, OneLine))
+        {
+            TestData PossibleResults( StringToTestData(OneLine) );
+            if(TestData{} != PossibleResults)
+                { Results.push_back(std::move(PossibleResults)); }
+        }
+        return Results;
+    }
+
+    std::vector<String> ReadFailedGroupNames(std::istream& Source)
+    {
+        const String HeaderStart("--= ");
+        const String HeaderEnd(" =--");
+        std::vector<String> FailedNames;
+        String CurrentGroup;
+        String OneLine;
+        while(std::getline(Source, OneLine))
+        {
+            if(OneLine.size() > HeaderStart.size() + HeaderEnd.size() &&
+               0 == OneLine.compare(0, HeaderStart.size(), HeaderStart) &&
+               0 == OneLine.compare(OneLine.size() - HeaderEnd.size(), HeaderEnd.size(), HeaderEnd))
+            {
+                CurrentGroup = OneLine.substr(HeaderStart.size(),
+                                              OneLine.size() - HeaderStart.size() - HeaderEnd.size());
+                continue;
+            }
+
+            const TestData PossibleResults( StringToTestData(OneLine) );
+            if(CurrentGroup.empty() || TestData{} == PossibleResults ||
+               TestResult::Warning >= PossibleResults.Results)
+                { continue; }
+            if(FailedNames.end() == std::find(FailedNames.begin(), FailedNames.end(), CurrentGroup))
+                { FailedNames.push_back(CurrentGroup); }
+        }
+        return FailedNames;
+    }
+
+    ExitCode MergeShardResults(const ParsedCommandLineArgs& Options)
+    {
+        MEZZ_TRACE("Merging shard results.")
+        UnitTestGroup::TestDataStorageType AllResults;
+        for(const String& OneFileName : Options.MergeFileNames)
+        {
+            std::ifstream ShardFile(OneFileName);
+            if(!ShardFile)
+            {
+                std::cerr << "Could not read shard results from '" << OneFileName << "'." << std::endl;
+                return EXIT_FAILURE;
+            }
+            UnitTestGroup::TestDataStorageType ShardResults = ReadTestResults(ShardFile);
+            AllResults.insert(AllResults.end(), ShardResults.begin(), ShardResults.end());
+        }
+
+        std::stringstream SummaryStream;
+        const TestResult Worst = RenderTestResultSummary(AllResults, SummaryStream);
+        std::cout << "Merged " << Options.MergeFileNames.size() << " shard results files.\n\n"
+                  << SummaryStream.str() << std::endl;
+        EmitJunitResults(AllResults);
+
+        if(TestResult::Warning > Worst)
+            { return EXIT_SUCCESS; }
+        return EXIT_FAILURE;
+    }
+
+    void RecordTestGroupTimings(const std::vector<NamedDuration>& TestTimings, TestHistory& History)
+    {
+        for(const NamedDuration& OneTiming : TestTimings)
+        {
+            for(const String& Suffix : {ParallelTimingSuffix, SerialTimingSuffix})
+            {
+                const String::size_type NameLength = OneTiming.Name.size() - Suffix.size();
+                if(OneTiming.Name.size() > Suffix.size() &&
+                   0 == OneTiming.Name.compare(NameLength, Suffix.size(), Suffix))
+                    { History.Record(OneTiming.Name.substr(0, NameLength), OneTiming.Duration); }
+            }
+        }
+    }
+
+    String GetSubProcessCommand(const ParsedCommandLineArgs& Options, const UnitTestGroup& OneTestGroup)
+    {
+        return Options.CommandName + " " +
+               OneTestGroup.Name() + " " +
+               RunInThisProcessToken + " " +
+               SkipSummaryToken + " " +
+               SkipFileToken +
+               GetRepeatArguments(Options)
+#ifndef MEZZ_Windows
+               + " " + ResultDescriptorToken + std::to_string(ResultChannelDescriptor)
+#endif // MEZZ_Windows
+               ;
+    }
+
+    ArgumentListType GetSubProcessArguments(const ParsedCommandLineArgs& Options, const UnitTestGroup& OneTestGroup)
+    {
+        ArgumentListType Arguments{ Options.CommandName, OneTestGroup.Name(),
+                                    RunInThisProcessToken, SkipSummaryToken, SkipFileToken };
+        std::istringstream RepeatArguments(GetRepeatArguments(Options));
+        for(String OneArgument; RepeatArguments >> OneArgument; )
+            { Arguments.push_back(OneArgument); }
+#ifndef MEZZ_Windows
+        Arguments.push_back(ResultDescriptorToken + std::to_string(ResultChannelDescriptor));
+#endif // MEZZ_Windows
+        return Arguments;
+    }
+
+    String GetRepeatArguments(const ParsedCommandLineArgs& Options)
+    {
+        String Arguments;
+        if(1 < Options.RepeatCount)
+            { Arguments += " " + RepeatToken + std::to_string(Options.RepeatCount); }
+        if(Options.RepeatUntilFailure)
+            { Arguments += " " + UntilFailToken; }
+        if(Options.RepeatConcurrently)
+            { Arguments += " " + ConcurrentToken; }
+        return Arguments;
+    }
+
+    void RunAndSendResultRecords(UnitTestGroup& OneTestGroup, const ResultRecordSink& Channel)
+    {
+        OneTestGroup.SetResultListener([&Channel](const TestData& OneResult)
+            { Channel(EncodeResultRecord(OneResult)); });
+        try {
+            OneTestGroup.Execute();
+        } catch(...) {
+            OneTestGroup.SetResultListener({});
+            throw;
+        }
+        OneTestGroup.SetResultListener({});
+        Channel(EncodeLogRecord(OneTestGroup.GetTestLog()));
+    }
+
+#ifndef MEZZ_Windows
+    ExitCode RunForkedTestGroup(UnitTestGroup& OneTestGroup)
+    {
+        InstallCrashHandlers(ResultChannelDescriptor);
+        OneTestGroup.ClearResults();
+        const ResourceLimitGuard Limits(GetResourceLimits(OneTestGroup));
+        RunAndSendResultRecords(OneTestGroup, [](const StringView Bytes)
+            { WriteToDescriptor(ResultChannelDescriptor, Bytes); });
+        return EXIT_SUCCESS;
+    }
+#endif // MEZZ_Windows
+
+    ResultChannelCallback ReadResultRecordsInto(UnitTestGroup& OneTestGroup,
+                                                ResultRecordDecoder::CrashCallback OnCrash)
+    {
+        ResultRecordDecoder::CrashCallback NameThenHandle;
+        if(OnCrash)
+        {
+            NameThenHandle = [OnCrash = std::move(OnCrash)](CrashReport&& Crash)
+            {
+                NameCrashFrames(Crash);
+                OnCrash(std::move(Crash));
+            };
+        }
+        auto Decoder = std::make_shared<ResultRecordDecoder>(
+            [&OneTestGroup](TestData&& OneResult)
+            {
+                OneResult.TestName = "SubProcess::" + OneResult.TestName;
+                OneTestGroup.StoreTestResultWithoutName(std::move(OneResult));
+            },
+            [&OneTestGroup](const StringView Log)
+                { OneTestGroup.AppendTestLog(Log); },
+            std::move(NameThenHandle)
+        );
+        auto Unreadable = std::make_shared<Boole>(false);
+        return [Decoder, Unreadable, &OneTestGroup](const StringView Bytes)
+        {
+            if(*Unreadable)
+                { return; }
+            try {
+                Decoder->Decode(Bytes);
+            } catch(const MalformedResultRecord&) {
+                *Unreadable = true; // Record it once, then ignore the rest since it cannot be trusted.
+                OneTestGroup.AddTestResultWithoutName(TestData(
+                    "SubProcess::" + OneTestGroup.Name() + "::UnreadableResults", TestResult::Unknown));
+            }
+        };
+    }
+
+    std::chrono::milliseconds GetTimeLimit(const ParsedCommandLineArgs& Options, const UnitTestGroup& OneTestGroup)
+    {
+        const std::chrono::milliseconds GroupLimit{ OneTestGroup.Timeout() };
+        if(GroupLimit > std::chrono::milliseconds::zero())
+            { return GroupLimit; }
+        return Options.Timeout;
+    }
+
+    ResourceLimits GetResourceLimits(const UnitTestGroup& OneTestGroup)
+    {
+        ResourceLimits Limits;
+        Limits.AddressSpaceBytes = OneTestGroup.MaxAddressSpace();
+        Limits.CpuSeconds = OneTestGroup.MaxCpuSeconds();
+        Limits.OpenFiles = OneTestGroup.MaxOpenFiles();
+        return Limits;
+    }
+
+    CpuListType GetPinnedCpus(const ParsedCommandLineArgs& Options, const UnitTestGroup& OneTestGroup)
+    {
+        if(Options.InSubProcess || !OneTestGroup.ShouldPinToCpus())
+            { return CpuListType{}; }
+        CpuListType OwnCpus{ OneTestGroup.PinnedCpus() };
+        if(!OwnCpus.empty())
+            { return OwnCpus; }
+        return Options.BenchmarkCpus;
+    }
+
+    void RecordPinnedCpus(UnitTestGroup& OneTestGroup, const CpuListType& Cpus, const Boole Pinned)
+    {
+        const String Listed{ CpuListToString(Cpus) };
+        if(Pinned)
+            { OneTestGroup.AppendTestLog("Running " + OneTestGroup.Name() + " pinned to CPUs " + Listed + ".\n"); }
+        else
+        {
+            OneTestGroup.AppendTestLog("Could not pin " + OneTestGroup.Name() + " to CPUs " + Listed +
+                                       ", its timings may be disturbed by other work.\n");
+        }
+        OneTestGroup.AddTestResultWithoutName(TestData(OneTestGroup.Name() + "::PinnedToCpus(" + Listed + ")",
+                                                       Pinned ? TestResult::Success : TestResult::NonPerformant));
+    }
+
+    void RecordTimedOut(UnitTestGroup& OneTestGroup, const std::chrono::nanoseconds Duration)
+    {
+        OneTestGroup.AppendTestLog("Killed the process running " + OneTestGroup.Name() + " for taking too long, "
+                                   "only results it sent before then are kept. It ran for" +
+                                   PrettyDurationString(Duration) + "\n");
+        OneTestGroup.AddTestResultWithoutName(TestData(
+            "SubProcess::" + OneTestGroup.Name() + "::TimedOut", TestResult::Cancelled));
+    }
+
+    void CancelAfterFailures(const CoreTestGroup& TestInstances,
+                             const Whole MaxFailures,
+                             CancellationToken StopRunning)
+    {
+        auto FailureCount = std::make_shared<std::atomic<Whole>>(0);
+        for(const CoreTestGroup::value_type& OneTestGroup : TestInstances)
+        {
+            OneTestGroup.second->SetCancellationToken(StopRunning);
+            if(0 == MaxFailures)
+                { continue; }
+            OneTestGroup.second->SetResultListener([FailureCount, MaxFailures, StopRunning](const TestData& OneResult)
+            {
+                if(TestResult::Failed <= OneResult.Results && MaxFailures <= ++(*FailureCount))
+                    { StopRunning.Cancel(); }
+            });
+        }
+    }
+
+    Boole PrepareRetry(const ParsedCommandLineArgs& Options, UnitTestGroup& OneTestGroup, const Whole RetriesDone)
+    {
+        if(Options.RetryCount <= RetriesDone || OneTestGroup.IsCancelled())
+            { return false; }
+
+        const UnitTestGroup::RepeatTallyStorageType Tallies{ OneTestGroup.GetRepeatTallies() };
+        const Boole FailingEveryTime = std::any_of(OneTestGroup.cbegin(), OneTestGroup.cend(),
+            [&Tallies](const TestData& OneResult)
+            {
+                if(TestResult::Failed > OneResult.Results || TestResult::Unknown < OneResult.Results)
+                    { return false; }
+                const UnitTestGroup::RepeatTallyStorageType::const_iterator Tally{ Tallies.find(OneResult.TestName) };
+                return Tallies.end() == Tally || Tally->second.Runs == Tally->second.Failures;
+            });
+        if(!FailingEveryTime)
+            { return false; }
+
+        OneTestGroup.AppendTestLog("Retrying " + OneTestGroup.Name() + " because it failed, retry " +
+                                   std::to_string(RetriesDone + 1) + " of " + std::to_string(Options.RetryCount) +
+                                   ".\n");
+        OneTestGroup.StartTallyingResults();
+        return true;
+    }
+
+    void RecordFlakyResults(UnitTestGroup& OneTestGroup, const Whole RetriesDone)
+    {
+        if(0 == RetriesDone)
+            { return; }
+
+        const UnitTestGroup::RepeatTallyStorageType Tallies{ OneTestGroup.GetRepeatTallies() };
+        for(TestData& OneResult : OneTestGroup)
+        {
+            if(TestResult::Failed > OneResult.Results || TestResult::Unknown < OneResult.Results)
+                { continue; }
+            const UnitTestGroup::RepeatTallyStorageType::const_iterator Tally{ Tallies.find(OneResult.TestName) };
+            if(Tallies.end() == Tally || Tally->second.Runs == Tally->second.Failures)
+                { continue; }
+            const UnitTestGroup::RepeatTally& Counts = Tally->second;
+            OneTestGroup.AppendTestLog(OneResult.TestName + " passed " + std::to_string(Counts.Runs - Counts.Failures) +
+                                       " of " + std::to_string(Counts.Runs) + " run(s), so it is Flaky.\n");
+            OneResult.Results = TestResult::Flaky;
+        }
+    }
+
+    void RecordCrashed(UnitTestGroup& OneTestGroup, const Integer Signal, const CrashReport& Crash)
+    {
+        if(0 == Crash.Signal) {
+            OneTestGroup.AppendTestLog("The process running " + OneTestGroup.Name() + " was ended by " +
+                                       SignalName(Signal) + " (" + std::to_string(Signal) + ") without saying "
+                                       "where, only results it sent before then are kept.\n");
+        } else {
+            OneTestGroup.AppendTestLog("The process running " + OneTestGroup.Name() + " crashed, only results it "
+                                       "sent before then are kept. " + DescribeCrash(Crash));
+        }
+        OneTestGroup.AddTestResultWithoutName(TestData(
+            "SubProcess::" + OneTestGroup.Name() + "::Crashed", TestResult::Unknown, GetCrashedFunction(Crash)));
+    }
+
+    void RecordStoppedEarly(UnitTestGroup& OneTestGroup)
+    {
+        OneTestGroup.AppendTestLog("Stopped " + OneTestGroup.Name() + " early because of failures elsewhere.\n");
+        OneTestGroup.AddTestResultWithoutName(TestData(
+            OneTestGroup.Name() + "::StoppedEarly", TestResult::Cancelled));
+    }
+
+    void ParseSubProcessLine(const StringView ProcessLine, UnitTestGroup& OneTestGroup)
+    {
+        TestData PossibleResults( StringToTestData(String(ProcessLine)) );
+        if(TestData{} != PossibleResults)
+        {
+            PossibleResults.TestName = "SubProcess::" + PossibleResults.TestName;
+            OneTestGroup.AddTestResultWithoutName(std::move(PossibleResults));
+        }
+    }
+
+    void ParseSubProcessOutput(const String& ProcessLog, UnitTestGroup& OneTestGroup)
+    {
+        std::istringstream LogStream(ProcessLog);
+        Mezzanine::String OneLine;
+        while( std::getline(LogStream, OneLine) )
+            { ParseSubProcessLine(OneLine, OneTestGroup); }
+    }
+
+    String GetWorkerProcessCommand(const ParsedCommandLineArgs& Options)
+    {
+        return Options.CommandName + " " + WorkerProcessToken + GetRepeatArguments(Options)
+#ifndef MEZZ_Windows
+               + " " + ResultDescriptorToken + std::to_string(ResultChannelDescriptor)
+#endif // MEZZ_Windows
+               ;
+    }
+
+    ExitCode RunWorkerProcess(const CoreTestGroup& TestInstances,
+                              std::istream& Requests,
+                              std::ostream& Results,
+                              const ResultRecordSink& ResultChannel)
+    {
+        MEZZ_TRACE("Waiting for test groups to run as a worker.")
+        Mezzanine::String GroupName;
+        while(std::getline(Requests, GroupName))
+        {
+            CoreTestGroup::const_iterator Found = TestInstances.find(GroupName);
+            if(TestInstances.end() != Found)
+            {
+                UnitTestGroup& TestGroupForWorker = *(Found->second);
+                const ResourceLimitGuard Limits(GetResourceLimits(TestGroupForWorker)); // Put back for the next.
+                if(ResultChannel) {
+                    RunAndSendResultRecords(TestGroupForWorker, ResultChannel);
+                } else {
+                    TestGroupForWorker.Execute();
+                    Results << TestGroupForWorker.GetTestLog();
+                }
+            }
+            Results << '\n' << WorkerGroupDoneMarker << std::endl; // The flush is what lets the parent move on.
         }
+        return EXIT_SUCCESS;
     }
 
-    void RunSubProcessTest(const ParsedCommandLineArgs& Options,
-                           UnitTestGroup& OneTestGroup)
+    ResourceUsage RunSubProcessTest(const ParsedCommandLineArgs& Options,
+                                    UnitTestGroup& OneTestGroup)
     {
+        ResourceUsage ChildUsage;
         MEZZ_TRACE("Preparing test to execute test in...")
         if(Options.InSubProcess)
         {
             MEZZ_TRACE("    the same process.")
-            OneTestGroup(); // Run tests and discard results, the parent process will grab it.
+            if(0 <= Options.ResultDescriptor) {
+                const ResourceLimitGuard Limits(GetResourceLimits(OneTestGroup)); // Only this group is in here.
+                RunAndSendResultRecords(OneTestGroup, [&Options](const StringView Bytes)
+                    { WriteToDescriptor(Options.ResultDescriptor, Bytes); });
+            } else {
+                OneTestGroup.Execute(); // Run tests and discard results, the parent process will grab it.
+            }
         } else {
             MEZZ_TRACE("    in an isolated process.")
-            String Command = Options.CommandName + " " +
-                             OneTestGroup.Name() + " " +
-                             RunInThisProcessToken + " " +
-                             SkipSummaryToken;
-            String ProcessLog = RunCommand(Command).ConsoleOutput;
-            std::istringstream LogStream(ProcessLog);
-            Mezzanine::String OneLine;
-            while( std::getline(LogStream, OneLine) )
-            {
-                TestData PossibleResults( StringToTestData(OneLine) );
-                if(TestData{} != PossibleResults)
-                {
-                    PossibleResults.TestName = "SubProcess::" + PossibleResults.TestName;
-                    OneTestGroup.AddTestResultWithoutName(std::move(PossibleResults));
-                }
-            }
+#ifdef MEZZ_Windows
+            // Only the results it printed and its errors matter, so the exit code is ignored.
+            const CommandResult Result{ StreamCommand(GetSubProcessCommand(Options, OneTestGroup),
+                [&OneTestGroup](const StringView Line){ ParseSubProcessLine(Line, OneTestGroup); }) };
+            OneTestGroup.AppendCapturedOutput(StringView{}, Result.ErrorOutput);
+#else // MEZZ_Windows
+            // Only the results it sent and what it printed matter, so its exit code is ignored.
+            ProcessScheduler OneChild(1);
+            if(0 != Options.MaxFailures)
+                { OneChild.SetCancellationToken(OneTestGroup.GetCancellationToken()); }
+            AddTestGroupChild(OneChild, Options, OneTestGroup,
+                              [&OneTestGroup, &ChildUsage](CommandResult&& Result, std::chrono::nanoseconds Duration)
+                              {
+                                  ChildUsage = Result.Usage;
+                                  if(Result.Cancelled)
+                                      { RecordStoppedEarly(OneTestGroup); }
+                                  else if(Result.TimedOut)
+                                      { RecordTimedOut(OneTestGroup, Duration); }
+                              });
+            OneChild.Run();
+#endif // MEZZ_Windows
+        }
+        return ChildUsage;
+    }
+
+    String GetCacheArguments(const ParsedCommandLineArgs& Options)
+    {
+        // Only what changes how groups are run, or whether they pass, belongs here. Selecting groups, sharding and
+        // how many run at once do not change the results of any one group.
+        String Arguments{ TimeoutToken + std::to_string(Options.Timeout.count()) };
+        if(Options.ForceSingleThread)
+            { Arguments += " " + NoThreads; }
+        if(Options.ReuseProcesses)
+            { Arguments += " " + ReuseProcessesToken; }
+        return Arguments;
+    }
+
+    void ReplayCachedResults(const CoreTestGroup& TestInstances,
+                             const ResultCache& Cache,
+                             const String& Arguments)
+    {
+        for(const CoreTestGroup::value_type& OneTestGroup : TestInstances)
+        {
+            UnitTestGroup& CachedGroup = *(OneTestGroup.second);
+            if(!CachedGroup.ShouldRun() || !CachedGroup.CanCacheResults())
+                { continue; }
+            const ResultCache::ResultsType* CachedResults = Cache.Find(CachedGroup.Name(), Arguments);
+            if(nullptr == CachedResults)
+                { continue; }
+
+            CachedGroup.SetReplayedFromCache();
+            CachedGroup.AppendTestLog("Replaying results of " + CachedGroup.Name() + " from " + CacheFileName +
+                                      ", the test binaries have not changed since they passed.\n");
+            for(const TestData& OneResult : *CachedResults)
+                { CachedGroup.AddTestResultWithoutName(TestData(OneResult)); }
+        }
+    }
+
+    void StoreCachedResults(const CoreTestGroup& TestInstances,
+                            ResultCache& Cache,
+                            const String& Arguments)
+    {
+        for(const CoreTestGroup::value_type& OneTestGroup : TestInstances)
+        {
+            const UnitTestGroup& RanGroup = *(OneTestGroup.second);
+            if(!RanGroup.ShouldRun() || RanGroup.WasReplayedFromCache() || !RanGroup.CanCacheResults())
+                { continue; }
+            if(TestResult::Cancelled > RanGroup.GetWorstResults())
+                { Cache.Store(RanGroup.Name(), Arguments, ResultCache::ResultsType(RanGroup.begin(), RanGroup.end())); }
+            else
+                { Cache.Forget(RanGroup.Name(), Arguments); }
         }
     }
 
     void RunParallelThreads(const CoreTestGroup& TestInstances,
                             const ParsedCommandLineArgs& Options,
                             UnitTestGroup::TestDataStorageType& AllResults,
-                            std::vector<NamedDuration>& TestTimings)
+                            std::vector<NamedDuration>& TestTimings,
+                            const TestHistory& History,
+                            const CancellationToken& StopRunning)
     {
         MEZZ_TRACE("Scheduling tests in ...")
-        std::mutex ResultsMutex;
-        std::vector<std::thread> TestThreads;
+        WorkStealingPool TestPool(Options.ForceSingleThread ? 1 : Options.JobCount);
+        ProcessScheduler ChildProcesses(Options.ProcessCount);
+#ifndef MEZZ_Windows
+        WorkerProcessPool Workers(GetWorkerProcessCommand(Options), Options.ProcessCount, WorkerGroupDoneMarker);
+#endif // MEZZ_Windows
+        if(0 != Options.MaxFailures)
+        {
+            // Without a failure limit nothing cancels the token, so the children need not be watched for it.
+            ChildProcesses.SetCancellationToken(StopRunning);
+#ifndef MEZZ_Windows
+            Workers.SetCancellationToken(StopRunning);
+#endif // MEZZ_Windows
+        }
 
-        for(const CoreTestGroup::value_type& OneTestGroup : TestInstances)
+#ifdef MEZZ_Windows
+        // Children print results as they go, this stores each one in its group as soon as its line arrives.
+        auto StoreResultLines = [](UnitTestGroup& RunningGroup)
+            { return [&RunningGroup](const StringView Line){ ParseSubProcessLine(Line, RunningGroup); }; };
+#endif // MEZZ_Windows
+
+        // Every pool thread gets a buffer of its own and the last is for the thread handling child processes, so
+        // finishing a group never waits on another. They are merged once everything is done.
+        std::vector<FinishedGroupsBuffer> Buffers(TestPool.GetThreadCount() + 1);
+        FinishedGroupsBuffer& ChildBuffer = Buffers.back();
+        // Logs go to the console from a thread of its own, so a slow console never holds up a test. Until that
+        // thread starts only this one is running, so logs are written right here.
+        std::unique_ptr<LogPublisher> Logs;
+        const Boole PrintLogs{ !SendsLogsToParent(Options) };
+        auto PublishLog = [&Logs, PrintLogs](String Log)
         {
-            UnitTestGroup& TestGroupForThread = *(OneTestGroup.second);
+            if(!PrintLogs)
+                { return; }
+            if(Logs)
+                { Logs->Publish(std::move(Log)); }
+            else
+                { std::cout << Log << std::flush; }
+        };
 
-            // Skip the ones that cannot be run here. Run only the tests that love massive parallelism.
-            if(TestGroupForThread.MustBeSerialized()) { continue; }
-            if(!TestGroupForThread.ShouldRun()) { continue; }
+        auto PublishResults = [&PublishLog]
+            (FinishedGroupsBuffer& Buffer, UnitTestGroup& FinishedGroup, std::chrono::nanoseconds Duration,
+             const ResourceUsage& Usage)
+        {
+            Buffer.Results.insert(Buffer.Results.end(), FinishedGroup.begin(), FinishedGroup.end());
+            Buffer.Timings.push_back(NamedDuration{FinishedGroup.Name() + ParallelTimingSuffix, Duration, Usage});
+            PublishLog(FinishedGroup.GetTestLog()); // Publish the Thread Specific TestLogs.
+            FinishedGroup.ReleaseNameIndex();
+        };
 
-            // Store the test and any synchronization inside it.
-            auto DoAndTimeThisTest = [&]()
+        // Groups cut short have no meaningful duration, so they are kept out of the timings and history.
+        auto PublishStoppedEarly = [&PublishLog](FinishedGroupsBuffer& Buffer, UnitTestGroup& StoppedGroup)
+        {
+            RecordStoppedEarly(StoppedGroup);
+            Buffer.Results.insert(Buffer.Results.end(), StoppedGroup.begin(), StoppedGroup.end());
+            PublishLog(StoppedGroup.GetTestLog());
+            StoppedGroup.ReleaseNameIndex();
+        };
+
+        // Groups that failed are run again while the rest are still running, so a retry adds as little as it can to
+        // the whole run. Each is given how many retries the group had before it, so it can tell when to stop.
+        std::function<void(UnitTestGroup&, const Whole)> RunOnPool;
+        RunOnPool = [&TestPool, &Options, &Buffers, &PublishResults, &PublishStoppedEarly, &RunOnPool]
+            (UnitTestGroup& TestGroupForThread, const Whole RetriesDone)
+        {
+            FinishedGroupsBuffer& Buffer = Buffers[WorkStealingPool::GetCurrentWorkerIndex()];
+            if(TestGroupForThread.IsCancelled())
+            {
+                PublishStoppedEarly(Buffer, TestGroupForThread);
+                return;
+            }
+            TestTimer SingleThreadTimer;
+            if(TestGroupForThread.IsMultiThreadSafe())
+                { TestGroupForThread.Execute(); }
+            else
+                { RunSubProcessTest(Options, TestGroupForThread); } // Already a child, so this runs here.
+            if(PrepareRetry(Options, TestGroupForThread, RetriesDone))
             {
-                // Multithreaded part
-                TestTimer SingleThreadTimer;
-                if(TestGroupForThread.IsMultiThreadSafe())
+                TestPool.AddWork([&RunOnPool, &TestGroupForThread, RetriesDone]()
+                    { RunOnPool(TestGroupForThread, RetriesDone + 1); });
+                return;
+            }
+            RecordFlakyResults(TestGroupForThread, RetriesDone);
+            PublishResults(Buffer, TestGroupForThread, SingleThreadTimer.GetLength(), ResourceUsage{});
+        };
+
+        // Retrying an isolated group always gets it a fresh child process, even when processes are reused.
+        std::function<void(UnitTestGroup&, const Whole)> StartChild;
+#ifdef MEZZ_Windows
+        StartChild = [&ChildProcesses, &Options, &ChildBuffer, &PublishResults, &PublishStoppedEarly, &StartChild,
+                      &StoreResultLines]
+#else // MEZZ_Windows
+        StartChild = [&ChildProcesses, &Options, &ChildBuffer, &PublishResults, &PublishStoppedEarly, &StartChild]
+#endif // MEZZ_Windows
+            (UnitTestGroup& TestGroupForThread, const Whole RetriesDone)
+        {
+            auto WhenDone = [&Options, &TestGroupForThread, &ChildBuffer, &PublishResults, &PublishStoppedEarly,
+                             &StartChild, RetriesDone]
+                (CommandResult&& Result, std::chrono::nanoseconds Duration)
                 {
-                    TestGroupForThread.operator()();
-                } else {
-                    RunSubProcessTest(Options, TestGroupForThread);
-                }
+                    if(Result.Cancelled)
+                    {
+                        PublishStoppedEarly(ChildBuffer, TestGroupForThread);
+                        return;
+                    }
+                    if(Result.TimedOut)
+                        { RecordTimedOut(TestGroupForThread, Duration); }
+                    if(PrepareRetry(Options, TestGroupForThread, RetriesDone))
+                    {
+                        StartChild(TestGroupForThread, RetriesDone + 1);
+                        return;
+                    }
+                    RecordFlakyResults(TestGroupForThread, RetriesDone);
+                    PublishResults(ChildBuffer, TestGroupForThread, Duration, Result.Usage);
+                };
+#ifdef MEZZ_Windows
+            // Its output is all results, so only its errors are kept with the group.
+            ChildProcesses.AddCommand(GetSubProcessCommand(Options, TestGroupForThread),
+                                      [&TestGroupForThread, WhenDone]
+                                      (CommandResult&& Result, std::chrono::nanoseconds Duration)
+                                      {
+                                          TestGroupForThread.AppendCapturedOutput(StringView{}, Result.ErrorOutput);
+                                          WhenDone(std::move(Result), Duration);
+                                      },
+                                      StoreResultLines(TestGroupForThread));
+#else // MEZZ_Windows
+            AddTestGroupChild(ChildProcesses, Options, TestGroupForThread, WhenDone);
+#endif // MEZZ_Windows
+        };
 
-                // Synchronize with single threaded part.
-                std::lock_guard<std::mutex> Lock(ResultsMutex);
-                AllResults.insert(AllResults.end(), TestGroupForThread.begin(), TestGroupForThread.end());
-                std::cout << TestGroupForThread.GetTestLog(); // Publish the Thread Specific TestLogs.
-                TestTimings.emplace_back (SingleThreadTimer.GetNameDuration(TestGroupForThread.Name() + "-T "));
-            };
+        // The pool and the schedulers both start work in the order it was added, so add the slow stuff first.
+        const OrderedTestGroups DispatchOrder{ Options.Shuffle ? ShuffleTestGroups(TestInstances, Options.ShuffleSeed)
+                                                               : OrderTestGroupsByHistory(TestInstances, History) };
+        for(const CoreTestGroup::value_type* OneTestGroup : DispatchOrder)
+        {
+            UnitTestGroup& TestGroupForThread = *(OneTestGroup->second);
+
+            // Skip the ones that cannot be run here. Run only the tests that love massive parallelism.
+            if(TestGroupForThread.MustBeSerialized()) { continue; }
+            if(!TestGroupForThread.ShouldRun()) { continue; }
+            if(TestGroupForThread.WasReplayedFromCache()) { continue; }
+            if(!GetPinnedCpus(Options, TestGroupForThread).empty()) { continue; }
 
-            // Run it here if forced or in a thread otherwise.
-            if(Options.ForceSingleThread)
+            if(TestGroupForThread.IsMultiThreadSafe() || Options.InSubProcess)
             {
-                MEZZ_TRACE("    to run in one thread.")
-                DoAndTimeThisTest();
+                MEZZ_TRACE("    the thread pool: " + TestGroupForThread.Name())
+                TestPool.AddWork([&RunOnPool, &TestGroupForThread]() { RunOnPool(TestGroupForThread, 0); });
             }
+#ifndef MEZZ_Windows
+            else if(Options.ReuseProcesses && !Options.ForkProcesses) // Forking is quicker still, so it wins.
+            {
+                MEZZ_TRACE("    a worker process: " + TestGroupForThread.Name())
+                Workers.AddRequest(OneTestGroup->first,
+                    [&Options, &TestGroupForThread, &ChildBuffer, &PublishResults, &PublishStoppedEarly, &StartChild]
+                    (CommandResult&& Result, std::chrono::nanoseconds Duration)
+                    {
+                        TestGroupForThread.AppendCapturedOutput(Result.ConsoleOutput, Result.ErrorOutput);
+                        if(Result.Cancelled)
+                        {
+                            PublishStoppedEarly(ChildBuffer, TestGroupForThread);
+                            return;
+                        }
+                        if(Result.TimedOut)
+                        {
+                            RecordTimedOut(TestGroupForThread, Duration);
+                        } else if(EXIT_SUCCESS != Result.ExitCode) {
+                            TestGroupForThread.AddTestResultWithoutName(TestData(
+                                "SubProcess::" + TestGroupForThread.Name() + "::WorkerProcessExited",
+                                TestResult::Unknown));
+                        }
+                        if(PrepareRetry(Options, TestGroupForThread, 0))
+                        {
+                            StartChild(TestGroupForThread, 1); // Run by ChildProcesses once the workers are done.
+                            return;
+                        }
+                        // Workers run many groups each, so what one used cannot be told apart from the rest.
+                        PublishResults(ChildBuffer, TestGroupForThread, Duration, ResourceUsage{});
+                    },
+                    {},
+                    ReadResultRecordsInto(TestGroupForThread, [&TestGroupForThread](CrashReport&& Crash)
+                        { RecordCrashed(TestGroupForThread, Crash.Signal, Crash); }),
+                    GetTimeLimit(Options, TestGroupForThread));
+            }
+#endif // MEZZ_Windows
             else
             {
-                MEZZ_TRACE("    to run in a thread per test.")
-                TestThreads.emplace_back(DoAndTimeThisTest);
+                MEZZ_TRACE("    a child process: " + TestGroupForThread.Name())
+                StartChild(TestGroupForThread, 0);
             }
+        }
 
+        MEZZ_TRACE("Running a pool of " + std::to_string(TestPool.GetThreadCount()) + " thread(s) and up to " +
+                   std::to_string(ChildProcesses.GetMaxProcesses()) + " child process(es).")
+#ifdef MEZZ_Windows
+        const Boole ForkFirst{ false };
+#else // MEZZ_Windows
+        // A fork keeps every lock another thread held when it was made, like the one guarding interned text,
+        // and would wait on it forever. So forks all run before any other thread starts, retries included.
+        const Boole ForkFirst{ Options.ForkProcesses };
+        if(ForkFirst)
+            { ChildProcesses.Run(); }
+#endif // MEZZ_Windows
+        Logs = std::make_unique<LogPublisher>(std::cout);
+        if(Options.ForceSingleThread)
+        {
+            // A pool of one thread runs everything right here, then the children are handled one after the other.
+            TestPool.Run();
+#ifndef MEZZ_Windows
+            Workers.Run();
+#endif // MEZZ_Windows
+            if(!ForkFirst)
+                { ChildProcesses.Run(); }
+        } else {
+            // The future waits for the pool even if the children throw, and rethrows anything from the pool.
+            // Workers go first, because the groups they fail are retried in fresh processes by ChildProcesses.
+            std::future<void> PoolDone = std::async(std::launch::async, [&TestPool](){ TestPool.Run(); });
+#ifndef MEZZ_Windows
+            Workers.Run();
+#endif // MEZZ_Windows
+            if(!ForkFirst)
+                { ChildProcesses.Run(); }
+            PoolDone.get();
+        }
 
+        MEZZ_TRACE("Merging results from every thread.")
+        Logs->Finish();
+        for(FinishedGroupsBuffer& OneBuffer : Buffers)
+        {
+            AllResults.insert(AllResults.end(), OneBuffer.Results.begin(), OneBuffer.Results.end());
+            TestTimings.insert(TestTimings.end(), OneBuffer.Timings.begin(), OneBuffer.Timings.end());
         }
-        for(std::thread& OneTestThread : TestThreads) { OneTestThread.join(); }
     }
 
     void RunSerializedTests(const CoreTestGroup& TestInstances,
                             const ParsedCommandLineArgs& Options,
                             UnitTestGroup::TestDataStorageType& AllResults,
-                            std::vector<NamedDuration>& TestTimings)
+                            std::vector<NamedDuration>& TestTimings,
+                            const CancellationToken& StopRunning)
     {
-        for(const CoreTestGroup::value_type& OneTestGroup : TestInstances)
+        OrderedTestGroups SerialOrder;
+        if(Options.Shuffle)
+            { SerialOrder = ShuffleTestGroups(TestInstances, Options.ShuffleSeed); }
+        else
         {
-            UnitTestGroup& TestGroupForThread = *(OneTestGroup.second);
+            for(const CoreTestGroup::value_type& OneTestGroup : TestInstances)
+                { SerialOrder.push_back(&OneTestGroup); }
+        }
+
+        for(const CoreTestGroup::value_type* OneTestGroup : SerialOrder)
+        {
+            UnitTestGroup& TestGroupForThread = *(OneTestGroup->second);
 
-            // Skip the ones that cannot be run here because they can't stand parrellelism.
-            if(TestGroupForThread.CanBeParallel()) { continue; }
+            // Skip the ones that cannot be run here because they can't stand parrellelism, unless they are pinned.
+            const CpuListType PinnedCpus{ GetPinnedCpus(Options, TestGroupForThread) };
+            if(TestGroupForThread.CanBeParallel() && PinnedCpus.empty()) { continue; }
             if(!TestGroupForThread.ShouldRun()) { continue; }
+            if(TestGroupForThread.WasReplayedFromCache()) { continue; }
 
-            // Run all of the rest tests right here.
+            if(StopRunning.IsCancelled())
+            {
+                RecordStoppedEarly(TestGroupForThread);
+                AllResults.insert(AllResults.end(), TestGroupForThread.begin(), TestGroupForThread.end());
+                if(!SendsLogsToParent(Options))
+                    { std::cout << TestGroupForThread.GetTestLog(); }
+                TestGroupForThread.ReleaseNameIndex();
+                continue;
+            }
+
+            // Run all of the rest tests right here, on the chosen CPUs if any were chosen.
+            CpuPinningGuard Pinning(PinnedCpus);
+            if(!PinnedCpus.empty())
+                { RecordPinnedCpus(TestGroupForThread, PinnedCpus, Pinning.IsPinned()); }
             TestTimer SingleThreadTimer;
 
-            // Force into a process or not.
-            if(TestGroupForThread.IsMultiProcessSafe())
+            // Force into a process or not, and again for as long as it should be retried.
+            Whole RetriesDone{0};
+            ResourceUsage ChildUsage;
+            while(true)
             {
-                RunSubProcessTest(Options, TestGroupForThread);
-            } else {
-                TestGroupForThread.operator()();
+                if(TestGroupForThread.IsMultiProcessSafe())
+                {
+                    ChildUsage = RunSubProcessTest(Options, TestGroupForThread);
+                } else {
+                    TestGroupForThread.Execute();
+                }
+                if(!PrepareRetry(Options, TestGroupForThread, RetriesDone))
+                    { break; }
+                RetriesDone++;
             }
+            RecordFlakyResults(TestGroupForThread, RetriesDone);
 
             // Synchronize with single threaded part.
             AllResults.insert(AllResults.end(), TestGroupForThread.begin(), TestGroupForThread.end());
-            std::cout << TestGroupForThread.GetTestLog(); // Publish the Test Specific Logs.
-            TestTimings.emplace_back (SingleThreadTimer.GetNameDuration(TestGroupForThread.Name() + "-S "));
+            if(!SendsLogsToParent(Options))
+                { std::cout << TestGroupForThread.GetTestLog(); } // Publish the Test Specific Logs.
+            TestGroupForThread.ReleaseNameIndex();
+            TestTimings.emplace_back (SingleThreadTimer.GetNameDuration(TestGroupForThread.Name() + SerialTimingSuffix));
+            TestTimings.back().Usage = ChildUsage;
 
         }
     }
 
 
-    void EmitJunitResults(const UnitTestGroup::TestDataStorageType& AllResults)
+    JunitOutputListType GetJunitOutputs(const CoreTestGroup& TestInstances)
     {
-        MEZZ_TRACE("Preparing JUnit compatible XML.")
-        std::stringstream XmlContents;
+        JunitOutputListType Outputs;
+        for(const CoreTestGroup::value_type& OneTestGroup : TestInstances)
+        {
+            JunitGroupOutput Printed{ OneTestGroup.second->Name(), OneTestGroup.second->GetCapturedOutput(),
+                                      OneTestGroup.second->GetCapturedErrors() };
+            if(!Printed.Output.empty() || !Printed.Errors.empty())
+                { Outputs.push_back(std::move(Printed)); }
+        }
+        return Outputs;
+    }
 
+    void WriteJunitResults(std::ostream& XmlContents,
+                           const UnitTestGroup::TestDataStorageType& AllResults,
+                           const JunitPropertyListType& Properties,
+                           const JunitOutputListType& Outputs)
+    {
         XmlContents << "<testsuite tests=\"" << AllResults.size() << "\">\n";
+        if(!Properties.empty())
+        {
+            XmlContents << "    <properties>\n";
+            for(const JunitPropertyListType::value_type& OneProperty : Properties)
+            {
+                XmlContents << "        <property name=\"" << SanitizeTestNameForJunit(OneProperty.first)
+                            << "\" value=\"" << SanitizeTestNameForJunit(OneProperty.second) << "\" />\n";
+            }
+            XmlContents << "    </properties>\n";
+        }
         for(UnitTestGroup::TestDataStorageType::value_type OneResult : AllResults)
         {
             switch(OneResult.Results)
@@ -400,6 +1472,15 @@ namespace Testing
                                 << "    </testcase>\n";
                     break;
 
+                case TestResult::Flaky:
+                    XmlContents << "    <testcase classname=\"" << OneResult.FileName<< "\" name=\""
+                                    << SanitizeTestNameForJunit(OneResult.TestName) << "\">\n"
+                                << "        <flakyFailure type=\"" << OneResult.Results << "\">\n"
+                                << "            " << OneResult
+                                << "        </flakyFailure>\n"
+                                << "    </testcase>\n";
+                    break;
+
                 case TestResult::Cancelled:
                 case TestResult::Failed:
                 case TestResult::Inconclusive:
@@ -415,7 +1496,18 @@ namespace Testing
                                 << "    </testcase>\n";
             }
         }
+        WriteJunitGroupOutputs(XmlContents, "system-out", Outputs, &JunitGroupOutput::Output);
+        WriteJunitGroupOutputs(XmlContents, "system-err", Outputs, &JunitGroupOutput::Errors);
         XmlContents << "</testsuite>";
+    }
+
+    void EmitJunitResults(const UnitTestGroup::TestDataStorageType& AllResults,
+                          const JunitPropertyListType& Properties,
+                          const JunitOutputListType& Outputs)
+    {
+        MEZZ_TRACE("Preparing JUnit compatible XML.")
+        std::stringstream XmlContents;
+        WriteJunitResults(XmlContents, AllResults, Properties, Outputs);
 
         MEZZ_TRACE("Emitting JUnit compatible XML.")
         std::ofstream JunitCompatibleXML("Mezz_Test_Results.xml");
@@ -430,14 +1522,101 @@ namespace Testing
         MEZZ_TRACE("Preparing storage of test results.")
         UnitTestGroup::TestDataStorageType AllResults;
 
+        TestHistory History;
+        const Boole UseHistory = !Options.SkipHistory && !Options.InSubProcess;
+        if(UseHistory)
+        {
+            MEZZ_TRACE("Loading test group durations from previous runs.")
+            History.LoadFile(HistoryFileName);
+        }
+
+        if(1 < Options.ShardCount)
+        {
+            MEZZ_TRACE("Skipping tests that belong to other shards.")
+            OrderedTestGroups Scheduled;
+            for(const CoreTestGroup::value_type& OneTestGroup : TestInstances)
+            {
+                if(OneTestGroup.second->ShouldRun())
+                    { Scheduled.push_back(&OneTestGroup); }
+            }
+            // Not the local history, each machine saves durations only for the groups it ran, so those differ.
+            TestHistory ShardHistory;
+            if(!Options.ShardHistoryFileName.empty())
+                { ShardHistory.LoadFile(Options.ShardHistoryFileName); }
+            const OrderedTestGroups InShard =
+                SelectShard(Scheduled, ShardHistory, Options.ShardIndex, Options.ShardCount);
+            for(const CoreTestGroup::value_type* OneTestGroup : Scheduled)
+            {
+                if(InShard.end() == std::find(InShard.begin(), InShard.end(), OneTestGroup))
+                    { OneTestGroup->second->SetForceSkip(); }
+            }
+        }
+
+        // Repeating is for finding tests that only fail sometimes, so a pass from before says nothing about them.
+        const Boole Repeating{ 1 < Options.RepeatCount || Options.RepeatUntilFailure };
+        const String Fingerprint{ Options.SkipCache || Options.InSubProcess || Repeating
+                                      ? String{} : GetLoadedBinariesFingerprint(Options.CommandName) };
+        const Boole UseCache = !Fingerprint.empty();
+        const String CacheArguments{ GetCacheArguments(Options) };
+        ResultCache Cache(Fingerprint);
+        if(UseCache)
+        {
+            MEZZ_TRACE("Replaying results of test groups that passed with these same test binaries.")
+            Cache.LoadFile(CacheFileName);
+            ReplayCachedResults(TestInstances, Cache, CacheArguments);
+            for(const CoreTestGroup::value_type& OneTestGroup : TestInstances)
+            {
+                if(!OneTestGroup.second->WasReplayedFromCache())
+                    { continue; }
+                AllResults.insert(AllResults.end(), OneTestGroup.second->begin(), OneTestGroup.second->end());
+                std::cout << OneTestGroup.second->GetTestLog();
+            }
+        }
+
+        MEZZ_TRACE("Preparing to stop early after failures, if asked to.")
+        CancellationToken StopRunning;
+        CancelAfterFailures(TestInstances, Options.MaxFailures, StopRunning);
+
         MEZZ_TRACE("Running all parallel tests.")
-        RunParallelThreads(TestInstances, Options, AllResults, TestTimings);
+        RunParallelThreads(TestInstances, Options, AllResults, TestTimings, History, StopRunning);
 
         MEZZ_TRACE("Running all single threaded tests.")
-        RunSerializedTests(TestInstances, Options, AllResults, TestTimings);
+        RunSerializedTests(TestInstances, Options, AllResults, TestTimings, StopRunning);
+
+        if(StopRunning.IsCancelled())
+        {
+            std::cout << "\nStopped early after " << Options.MaxFailures
+                      << " failure(s), unfinished test groups are marked Cancelled.\n";
+        }
+
+        if(1 < Options.ShardCount)
+        {
+            MEZZ_TRACE("Writing this shard's results.")
+            std::ofstream ShardFile(GetShardResultsFileName(Options.ShardIndex, Options.ShardCount));
+            EmitShardResults(TestInstances, ShardFile);
+        }
+
+        if(UseHistory)
+        {
+            MEZZ_TRACE("Saving test group durations for later runs.")
+            RecordTestGroupTimings(TestTimings, History);
+            History.SaveFile(HistoryFileName);
+        }
+
+        if(UseCache)
+        {
+            MEZZ_TRACE("Saving passing results for later runs.")
+            StoreCachedResults(TestInstances, Cache, CacheArguments);
+            Cache.SaveFile(CacheFileName);
+        }
 
         if(Options.EmitJunitXml)
-            { EmitJunitResults(AllResults); }
+        {
+            JunitPropertyListType Properties;
+            if(Options.Shuffle)
+                { Properties.emplace_back("seed", std::to_string(Options.ShuffleSeed)); }
+            EmitJunitResults(AllResults, Properties, GetJunitOutputs(TestInstances));
+        }
 
         return AllResults;
     }
@@ -456,6 +1635,29 @@ namespace Testing
             ParsedCommandLineArgs Options = DealWithdCommandLineArgs(argc, argv, TestInstances);
             if(EXIT_SUCCESS != Options.ExitWithError)
                 { return Options.ExitWithError; }
+#ifndef MEZZ_Windows
+            IgnoreBrokenPipes(); // Worker pools write to children that may have died, that must not kill us.
+            if((Options.InSubProcess || Options.IsWorkerProcess) && 0 <= Options.ResultDescriptor)
+                { InstallCrashHandlers(Options.ResultDescriptor); } // Only children have a parent to tell.
+#endif // MEZZ_Windows
+            for(const CoreTestGroup::value_type& OneTestGroup : TestInstances)
+            {
+                OneTestGroup.second->SetRepeats(Options.RepeatCount, Options.RepeatUntilFailure,
+                                                Options.RepeatConcurrently,
+                                                Options.ForceSingleThread ? 1 : Options.JobCount);
+            }
+            if(Options.IsWorkerProcess)
+            {
+                ResultRecordSink ResultChannel;
+                if(0 <= Options.ResultDescriptor)
+                {
+                    ResultChannel = [&Options](const StringView Bytes)
+                        { WriteToDescriptor(Options.ResultDescriptor, Bytes); };
+                }
+                return RunWorkerProcess(TestInstances, std::cin, std::cout, ResultChannel);
+            }
+            if(!Options.MergeFileNames.empty())
+                { return MergeShardResults(Options); }
 
             // Reserve a fairly arbitrary amount of space for storing the timings of the work to be done, make sure
             // it is a power of two for maximum legitimacy.
@@ -470,6 +1672,13 @@ namespace Testing
             UnitTestGroup::TestDataStorageType AllResults = RunTests(TestInstances, Options, VariousTimings);
             VariousTimings.emplace_back(TestExecutionTimer.GetNameDuration("Test Execution Time"));
 
+            if(!Options.SkipFile)
+            {
+                MEZZ_TRACE("Writing results for later runs.")
+                std::ofstream ResultsFile(ResultsFileName);
+                EmitShardResults(TestInstances, ResultsFile);
+            }
+
             MEZZ_TRACE("Rendering final.")
             TestResult Worst;
             if(!Options.SkipSummary)
@@ -477,7 +1686,22 @@ namespace Testing
                 MEZZ_TRACE("Formatting test results.")
                 TestTimer SummaryTimer;
                 std::stringstream SummaryStream;
+                if(1 < Options.RepeatCount || Options.RepeatUntilFailure || 0 < Options.RetryCount)
+                    { RenderRepeatSummary(TestInstances, SummaryStream); }
                 Worst = RenderTestResultSummary(AllResults, SummaryStream);
+                const auto ReplayedCount = std::count_if(TestInstances.cbegin(), TestInstances.cend(),
+                    [](const CoreTestGroup::value_type& OneTestGroup)
+                        { return OneTestGroup.second->WasReplayedFromCache(); });
+                if(0 < ReplayedCount)
+                {
+                    SummaryStream << "  " << ReplayedCount << " test group(s) replayed results from " << CacheFileName
+                                  << " instead of running, pass " << NoCacheToken << " to run everything.\n";
+                }
+                if(Options.Shuffle)
+                {
+                    SummaryStream << "  Test groups started in a shuffled order, pass " << SeedToken
+                                  << Options.ShuffleSeed << " to repeat it.\n";
+                }
                 VariousTimings.push_back(SummaryTimer.GetNameDuration("Summary Reporting Time"));
 
                 MEZZ_TRACE("Formatting Times.")
@@ -53,11 +53,20 @@ SUPPRESS_VC_WARNING(4668) // _WIN32_WINNT_WIN10_RS5 isn't defined causing a warn
                           // is escalated into an error.
 #ifdef MEZZ_Windows
     #include "windows.h"
+    #include <io.h>
+    #include <thread>
 #else // MEZZ_Windows
     #include "unistd.h"
+    #include <fcntl.h>
+    #include <poll.h>
+    #include <signal.h>
+    #include <spawn.h>
     #include <string.h>
+    #include <sys/resource.h>
     #include <sys/types.h>
     #include <sys/wait.h>
+
+    extern char** environ; // Not every unistd.h declares this.
 #endif // MEZZ_Windows
 
 RESTORE_WARNING_STATE
@@ -70,6 +79,8 @@ RESTORE_WARNING_STATE
 #undef min
 #endif // max
 
+#include <algorithm>
+#include <cerrno>
 #include <exception>
 #include <cstdlib>
 
@@ -79,6 +90,42 @@ RESTORE_WARNING_STATE
 
 namespace {
     using namespace Mezzanine;
+
+    /// @brief Passes on a line of child output, dropping the carriage return Windows may leave at the end.
+    /// @param Line One line without its newline.
+    /// @param OnLine Where to pass the line.
+    void DeliverLine(StringView Line, const Testing::OutputLineCallback& OnLine)
+    {
+        if( !Line.empty() && '\r' == Line.back() )
+            { Line.remove_suffix(1); }
+        OnLine(Line);
+    }
+
+    /// @brief Passes on every complete line in some output, keeping only the unfinished line at the end.
+    /// @param Unfinished Output not passed on yet, complete lines are removed from it.
+    /// @param OnLine Where to pass each line.
+    void DeliverCompleteLines(String& Unfinished, const Testing::OutputLineCallback& OnLine)
+    {
+        String::size_type LineStart = 0;
+        for( String::size_type LineEnd = Unfinished.find('\n') ;
+             String::npos != LineEnd ;
+             LineEnd = Unfinished.find('\n', LineStart) )
+        {
+            DeliverLine( StringView(Unfinished.data() + LineStart, LineEnd - LineStart), OnLine );
+            LineStart = LineEnd + 1;
+        }
+        Unfinished.erase(0, LineStart);
+    }
+
+    /// @brief Passes on what is left of an unfinished line once the output has ended.
+    /// @param Unfinished Output not passed on yet, this is emptied.
+    /// @param OnLine Where to pass the line.
+    void DeliverLastLine(String& Unfinished, const Testing::OutputLineCallback& OnLine)
+    {
+        if( !Unfinished.empty() )
+            { DeliverLine(Unfinished, OnLine); }
+        Unfinished.clear();
+    }
 #ifdef MEZZ_Windows
     /// @brief Convenience type because Windows likes fatty Strings.
     using WideString = std::wstring;
@@ -95,6 +142,8 @@ namespace {
     {
         /// @brief A HANDLE belonging to the output end of the child processes cout pipe.
         HANDLE ChildPipe = 0;
+        /// @brief A HANDLE belonging to the output end of the child processes cerr pipe.
+        HANDLE ErrorPipe = 0;
         /// @brief A HANDLE belonging to the child process itself.
         HANDLE ChildProcess = 0;
         /// @brief The error code given if the process failed to launch.
@@ -174,6 +223,8 @@ namespace {
     {
         HANDLE Child_STDOUT_Read = NULL;
         HANDLE Child_STDOUT_Write = NULL;
+        HANDLE Child_STDERR_Read = NULL;
+        HANDLE Child_STDERR_Write = NULL;
 
         // SECURITY_ATTRIBUTES setup
         SECURITY_ATTRIBUTES SecurityAttrib;
@@ -181,12 +232,18 @@ namespace {
         SecurityAttrib.bInheritHandle = TRUE;
         SecurityAttrib.lpSecurityDescriptor = NULL;
 
-        // Create our Pipe
+        // Create our Pipes
         if( !::CreatePipe(&Child_STDOUT_Read,&Child_STDOUT_Write,&SecurityAttrib,0) ) {
             throw std::runtime_error("Unable to create pipes for child process.");
         }
-        // Ensure handle isn't inherited.
-        if( !::SetHandleInformation(Child_STDOUT_Read,HANDLE_FLAG_INHERIT,0) ) {
+        if( !::CreatePipe(&Child_STDERR_Read,&Child_STDERR_Write,&SecurityAttrib,0) ) {
+            ::CloseHandle(Child_STDOUT_Read);
+            ::CloseHandle(Child_STDOUT_Write);
+            throw std::runtime_error("Unable to create pipes for child process.");
+        }
+        // Ensure handles aren't inherited.
+        if( !::SetHandleInformation(Child_STDOUT_Read,HANDLE_FLAG_INHERIT,0) ||
+            !::SetHandleInformation(Child_STDERR_Read,HANDLE_FLAG_INHERIT,0) ) {
             throw std::runtime_error("Unable to set handle information for child process pipe.");
         }
 
@@ -198,7 +255,7 @@ namespace {
         STARTUPINFOW ProcessStartUp;
         ZeroMemory(&ProcessStartUp,sizeof(ProcessStartUp));
         ProcessStartUp.cb = sizeof(ProcessStartUp);
-        //ProcessStartUp.hStdError = Child_STDOUT_Write;
+        ProcessStartUp.hStdError = Child_STDERR_Write;
         ProcessStartUp.hStdOutput = Child_STDOUT_Write;
         ProcessStartUp.dwFlags |= STARTF_USESTDHANDLES;
 
@@ -216,8 +273,10 @@ namespace {
         );
 
         ::CloseHandle(Child_STDOUT_Write);
+        ::CloseHandle(Child_STDERR_Write);
         if( !ChildLaunch ) {
             ::CloseHandle(Child_STDOUT_Read);
+            ::CloseHandle(Child_STDERR_Read);
             DWORD ErrorNum = GetLastError();
             StringStream ErrorStream;
             ErrorStream << "Process Error: ";
@@ -230,17 +289,22 @@ namespace {
                                                 sizeof(WideBuffer) / sizeof(wchar_t),
                                                 nullptr);
             ErrorStream << ConvertToNarrowString(WideBuffer,WrittenChars);
-            return { 0, 0, ErrorNum, ErrorStream.str() };
+            return { 0, 0, 0, ErrorNum, ErrorStream.str() };
         }
-        return { Child_STDOUT_Read, ProcessInfo.hProcess, 0, String() };
+        return { Child_STDOUT_Read, Child_STDERR_Read, ProcessInfo.hProcess, 0, String() };
     }
 
     /// @brief Launches a new process with the given command and collects it's output.
+    /// @remarks Anonymous pipes cannot be polled on Windows, so cerr is read on a thread of its own while cout is
+    /// read here. A child that fills one pipe while the other is being read can never deadlock.
     /// @param ExePathName The absolute path, relative path, or file name in the system path to be executed.
     /// @param Command The arguments given to the launched executable.
-    /// @return Returns a command result, containing the exit code and console output of the launched executable.
+    /// @param OnLine If set, each line of output is passed here as it arrives instead of being collected.
+    /// @return Returns a command result, containing the exit code, console output and error output of the launched
+    /// executable.
     [[nodiscard]]
-    Testing::CommandResult RunCommandImpl(const WideString& ExePathName, WideString& Command)
+    Testing::CommandResult RunCommandImpl(const WideString& ExePathName, WideString& Command,
+                                          const Testing::OutputLineCallback& OnLine = {})
     {
         Testing::CommandResult Result;
 
@@ -248,9 +312,20 @@ namespace {
         if( ChildInfo.ErrorNum != 0 ) {
             Result.ExitCode = 1;
             Result.ConsoleOutput = ChildInfo.ErrorStr;
+            if( OnLine )
+                { DeliverLastLine(Result.ConsoleOutput, OnLine); }
             return Result;
         }
 
+        std::thread ErrorReader([&ChildInfo, &Result]()
+        {
+            DWORD ErrorBytesRead = 0;
+            CHAR ErrorBuf[1024];
+            while( ::ReadFile(ChildInfo.ErrorPipe,ErrorBuf,sizeof(ErrorBuf),&ErrorBytesRead,NULL) &&
+                   ErrorBytesRead != 0 )
+                { Result.ErrorOutput.append(ErrorBuf,ErrorBytesRead); }
+        });
+
         DWORD BytesRead = 0;
         CHAR PipeBuf[1024];
         while( ::ReadFile(ChildInfo.ChildPipe,PipeBuf,sizeof(PipeBuf),&BytesRead,NULL) )
@@ -259,8 +334,14 @@ namespace {
                 break;
             }
             Result.ConsoleOutput.append(PipeBuf,BytesRead);
+            if( OnLine )
+                { DeliverCompleteLines(Result.ConsoleOutput, OnLine); }
         }
         ::CloseHandle(ChildInfo.ChildPipe);
+        ErrorReader.join();
+        ::CloseHandle(ChildInfo.ErrorPipe);
+        if( OnLine )
+            { DeliverLastLine(Result.ConsoleOutput, OnLine); }
 
         DWORD ExitStatus;
         ::GetExitCodeProcess(ChildInfo.ChildProcess,&ExitStatus);
@@ -270,6 +351,8 @@ namespace {
         // Trim newlines
         while( CanTrimBack(Result.ConsoleOutput) )
             { Result.ConsoleOutput.pop_back(); }
+        while( CanTrimBack(Result.ErrorOutput) )
+            { Result.ErrorOutput.pop_back(); }
         return Result;
     }
 #else // Mezz_Windows
@@ -278,6 +361,9 @@ namespace {
     {
         int ChildPipe = 0;
         int ChildPID = 0;
+        int ChildInput = -1;
+        int ChildResults = -1;
+        int ChildErrors = -1;
     };//ProcessInfo
 
     /// @brief An internal only methods for tokenizing command line args and respecting quotes.
@@ -348,87 +434,438 @@ namespace {
         return String{ ExtractFrom.substr(0,SplitPos) };
     }
 
-    /// @brief Creates and launches a new process.
-    /// @remarks The path to the executable to be launched must appear in both parameters to this function.
-    /// @param ExePathName Specifies the exe that will be launched. MUST contain the path to the executable
-    /// being launched.
-    /// @param Arguments The space separated arguments given to the exe being launched. This MUST include
-    /// the path the executable as the first argument.
-    /// @return Returns a ProcessInfo struct containing information about the launched process.
+    /// @brief The pipes between this process and a child about to be launched, -1 where there is no pipe.
+    struct ChildPipeSet
+    {
+        /// @brief The read and write ends of the pipe for the child's cout.
+        int Output[2] = { -1, -1 };
+        /// @brief The read and write ends of the pipe for the child's cerr.
+        int Errors[2] = { -1, -1 };
+        /// @brief The read and write ends of the pipe for the child's cin, if it has one.
+        int Input[2] = { -1, -1 };
+        /// @brief The read and write ends of the child's result channel, if it has one.
+        int Results[2] = { -1, -1 };
+
+        /// @brief Close every pipe end still open, for when the child could not be launched.
+        void CloseAll() noexcept
+        {
+            for( int* const End : { &Output[0], &Output[1], &Errors[0], &Errors[1],
+                                    &Input[0], &Input[1], &Results[0], &Results[1] } )
+            {
+                if( 0 <= *End )
+                    { ::close( *End ); }
+                *End = -1;
+            }
+        }
+    };//ChildPipeSet
+
+    /// @brief Creates the pipes a child will use to talk to this process.
+    /// @remarks Every end is close on exec, so other children launched while this one runs do not inherit and hold
+    /// them open. Only the read ends of the cerr pipe and the result channel are non-blocking, those can be drained
+    /// without knowing if more is coming.
+    /// @param WithInput If true a pipe for the child's cin is created too.
+    /// @param WithResults If true a pipe for the child's result channel is created too.
+    /// @return The pipes created.
     [[nodiscard]]
-    ProcessInfo CreateCommandProcess(StringView ExePathName, const StringView Arguments)
+    ChildPipeSet CreateChildPipes(const Boole WithInput, const Boole WithResults)
     {
-        int Pipes[2];
-        if( ::pipe(Pipes) < 0 ) {
+        ChildPipeSet Pipes;
+        if( ::pipe(Pipes.Output) < 0 ) {
             throw std::runtime_error("Unable to create pipe for child process.");
         }
+        ::fcntl( Pipes.Output[0], F_SETFD, FD_CLOEXEC );
+        ::fcntl( Pipes.Output[1], F_SETFD, FD_CLOEXEC );
+
+        if( ::pipe(Pipes.Errors) < 0 ) {
+            Pipes.CloseAll();
+            throw std::runtime_error("Unable to create error pipe for child process.");
+        }
+        ::fcntl( Pipes.Errors[0], F_SETFD, FD_CLOEXEC );
+        ::fcntl( Pipes.Errors[1], F_SETFD, FD_CLOEXEC );
+        ::fcntl( Pipes.Errors[0], F_SETFL, O_NONBLOCK );
 
-        // Tokenizing might throw, so we do it in the parent process to allow graceful error handling.
-        std::vector<Mezzanine::String> ArgVector = TokenizeProcessArguments(Arguments);
+        if( WithInput ) {
+            if( ::pipe(Pipes.Input) < 0 ) {
+                Pipes.CloseAll();
+                throw std::runtime_error("Unable to create input pipe for child process.");
+            }
+            ::fcntl( Pipes.Input[0], F_SETFD, FD_CLOEXEC );
+            ::fcntl( Pipes.Input[1], F_SETFD, FD_CLOEXEC );
+        }
+
+        if( WithResults ) {
+            if( ::pipe(Pipes.Results) < 0 ) {
+                Pipes.CloseAll();
+                throw std::runtime_error("Unable to create result pipe for child process.");
+            }
+            ::fcntl( Pipes.Results[0], F_SETFD, FD_CLOEXEC );
+            ::fcntl( Pipes.Results[1], F_SETFD, FD_CLOEXEC );
+            ::fcntl( Pipes.Results[0], F_SETFL, O_NONBLOCK );
+            if( Testing::ResultChannelDescriptor == Pipes.Results[1] ) {
+                // Moved out of the way, so it can be duplicated onto the descriptor like any other pipe.
+                const int Moved = ::fcntl( Pipes.Results[1], F_DUPFD_CLOEXEC, Testing::ResultChannelDescriptor + 1 );
+                ::close( Pipes.Results[1] );
+                Pipes.Results[1] = Moved;
+                if( Moved < 0 ) {
+                    Pipes.CloseAll();
+                    throw std::runtime_error("Unable to move result pipe for child process.");
+                }
+            }
+        }
+        return Pipes;
+    }
 
+    /// @brief Keep this process's ends of the pipes to a child that was just launched and close the child's ends.
+    /// @param Pipes The pipes the child was launched with.
+    /// @param ProcessID The operating system's identifier for the child.
+    /// @param OwnProcessGroup Was the child launched to lead its own process group?
+    /// @return Returns a ProcessInfo struct containing information about the launched process.
+    [[nodiscard]]
+    ProcessInfo AdoptChild(const ChildPipeSet& Pipes, const pid_t ProcessID, const Boole OwnProcessGroup)
+    {
+        if( OwnProcessGroup )
+            { ::setpgid( ProcessID, ProcessID ); } // Also done here so it is certain before anything is killed.
+        ::close( Pipes.Output[1] ); // Close Write end of pipe
+        ::close( Pipes.Errors[1] ); // Close Write end of error pipe
+        if( 0 <= Pipes.Input[0] )
+            { ::close( Pipes.Input[0] ); } // Close Read end of input pipe
+        if( 0 <= Pipes.Results[1] )
+            { ::close( Pipes.Results[1] ); } // Close Write end of result pipe
+        return { Pipes.Output[0], ProcessID, Pipes.Input[1], Pipes.Results[0], Pipes.Errors[0] };
+    }
+
+    /// @brief Forks a child process connected to this one by some pipes.
+    /// @param InChild Called in the child once its pipes are connected, it must exec or exit rather than return.
+    /// @param Pipes The pipes to connect the child to, they are closed if the fork fails.
+    /// @param OwnProcessGroup If true the child leads a new process group, so it and anything it starts can be
+    /// killed together. Such children no longer get signals sent to the terminal's process group, like Ctrl-C.
+    /// @return Returns a ProcessInfo struct containing information about the forked process.
+    [[nodiscard]]
+    ProcessInfo ForkChildProcess(const std::function<void()>& InChild,
+                                 ChildPipeSet& Pipes,
+                                 const Boole OwnProcessGroup)
+    {
         std::cout.flush(); // Clean out the pipes before they may be important.
         pid_t ProcessID = ::fork();
         if( ProcessID == 0 ) { // Child
-            ::close( Pipes[0] ); // Close Read end of pipe.
-            ::dup2( Pipes[1], 1 ); // Direct cout file descriptor to our pipe.
-            //::dup2( Pipes[1], 2 ); // Direct cerr file descriptor to our pipe.
-            ::close( Pipes[1] ); // Done mangling pipes.
+            if( OwnProcessGroup )
+                { ::setpgid( 0, 0 ); }
+            // Closed as well as close on exec, because a child that does not exec must not hold its own cin open.
+            ::close( Pipes.Output[0] ); // Close Read end of pipe.
+            ::dup2( Pipes.Output[1], 1 ); // Direct cout file descriptor to our pipe.
+            ::close( Pipes.Output[1] );
+            ::close( Pipes.Errors[0] );
+            ::dup2( Pipes.Errors[1], 2 ); // Direct cerr file descriptor to a pipe of its own.
+            ::close( Pipes.Errors[1] ); // Done mangling pipes.
+            if( 0 <= Pipes.Input[0] ) {
+                ::dup2( Pipes.Input[0], 0 ); // Direct cin file descriptor from the parent.
+                ::close( Pipes.Input[0] );
+                ::close( Pipes.Input[1] );
+            }
+            if( 0 <= Pipes.Results[1] ) {
+                // Done last so closing the other pipes cannot close it, and dup2 clears close on exec.
+                ::close( Pipes.Results[0] );
+                ::dup2( Pipes.Results[1], Testing::ResultChannelDescriptor );
+                ::close( Pipes.Results[1] );
+            }
+            ::signal( SIGPIPE, SIG_DFL ); // The parent may be ignoring this, but ignored signals survive exec.
+
+            InChild();
+            // If all goes well we disappear into a puff of logic at this point
+            // But to appease compilers, we'll write code that pretends we didn't
+            std::exit(EXIT_FAILURE);
+        }else if( ProcessID > 0 ) { // Parent
+            return AdoptChild( Pipes, ProcessID, OwnProcessGroup );
+        }else{
+            Pipes.CloseAll();
+            throw std::runtime_error("Unable to create forked process.");
+        }
+    }
+
+    /// @brief Creates and launches a new process from arguments that are already split up.
+    /// @remarks This uses posix_spawnp, which does not copy this process's memory the way fork does, so launching
+    /// takes as long however much memory this process uses. The pipes are connected by spawn file actions.
+    /// @param ExePathName Specifies the exe that will be launched, searched for in the system PATH if it has no
+    /// slash.
+    /// @param Arguments Every argument the exe gets, starting with the path to the executable.
+    /// @param WithInput If true the child's cin is connected to a pipe returned as ChildInput, otherwise it is
+    /// inherited.
+    /// @param WithResults If true the child gets a result channel on ResultChannelDescriptor, whose non-blocking
+    /// read end is returned as ChildResults.
+    /// @param OwnProcessGroup If true the child leads a new process group, so it and anything it starts can be
+    /// killed together. Such children no longer get signals sent to the terminal's process group, like Ctrl-C.
+    /// @return Returns a ProcessInfo struct containing information about the launched process, its cout and cerr
+    /// are always connected to pipes.
+    [[nodiscard]]
+    ProcessInfo SpawnCommandProcess(const String& ExePathName, const Testing::ArgumentListType& Arguments,
+                                    const Boole WithInput = false, const Boole WithResults = false,
+                                    const Boole OwnProcessGroup = false)
+    {
+        ChildPipeSet Pipes = CreateChildPipes(WithInput, WithResults);
+
+        // Both the exec below and the fallback need these, and building them cannot fail part way through a launch.
+        std::vector<Mezzanine::String> ArgVector(Arguments);
+        std::vector<char*> ArgV(ArgVector.size() + 1); // +1 for the nullptr at end.
+        for( size_t Idx = 0 ; Idx < ArgVector.size() ; ++Idx )
+            { ArgV[Idx] = ArgVector[Idx].data(); }
+        ArgV[ArgVector.size()] = nullptr;
 
-            std::vector<char*> ArgV(ArgVector.size() + 1); // +1 for the nullptr at end.
-            for( size_t Idx = 0 ; Idx < ArgVector.size() ; ++Idx )
-                { ArgV[Idx] = ArgVector[Idx].data(); }
-            ArgV[ArgVector.size()] = nullptr;
+        posix_spawn_file_actions_t Actions;
+        ::posix_spawn_file_actions_init( &Actions );
+        ::posix_spawn_file_actions_adddup2( &Actions, Pipes.Output[1], 1 );
+        ::posix_spawn_file_actions_adddup2( &Actions, Pipes.Errors[1], 2 );
+        if( 0 <= Pipes.Input[0] )
+            { ::posix_spawn_file_actions_adddup2( &Actions, Pipes.Input[0], 0 ); }
+        if( 0 <= Pipes.Results[1] )
+            { ::posix_spawn_file_actions_adddup2( &Actions, Pipes.Results[1], Testing::ResultChannelDescriptor ); }
 
-            if( execvp(ExePathName.data(), ArgV.data()) < 0 ) {
+        posix_spawnattr_t Attributes;
+        ::posix_spawnattr_init( &Attributes );
+        sigset_t DefaultSignals;
+        ::sigemptyset( &DefaultSignals );
+        ::sigaddset( &DefaultSignals, SIGPIPE ); // The parent may be ignoring this, but ignored signals survive exec.
+        ::posix_spawnattr_setsigdefault( &Attributes, &DefaultSignals );
+        short Flags = POSIX_SPAWN_SETSIGDEF;
+        if( OwnProcessGroup ) {
+            Flags |= POSIX_SPAWN_SETPGROUP;
+            ::posix_spawnattr_setpgroup( &Attributes, 0 );
+        }
+        ::posix_spawnattr_setflags( &Attributes, Flags );
+
+        pid_t ProcessID = -1;
+        const int SpawnError = ::posix_spawnp( &ProcessID, ExePathName.c_str(), &Actions, &Attributes,
+                                               ArgV.data(), environ );
+        ::posix_spawnattr_destroy( &Attributes );
+        ::posix_spawn_file_actions_destroy( &Actions );
+        if( 0 == SpawnError )
+            { return AdoptChild( Pipes, ProcessID, OwnProcessGroup ); }
+
+        // Most likely the executable could not be found. Forking lets a child report that the same way it always
+        // has, as its output and exit code, rather than every caller needing to handle another kind of failure.
+        return ForkChildProcess( [&ExePathName, &ArgV]()
+        {
+            if( execvp(ExePathName.c_str(), ArgV.data()) < 0 ) {
                 // Welp...it's been a good ride.
                 int ErrorNum = errno;
                 std::cout << "Process Error: " << ::strerror(ErrorNum);
                 std::exit(EXIT_FAILURE);
             }
-            // If all goes well we disappear into a puff of logic at this point
-            // But to appease compilers, we'll write code that pretends we didn't
-            return { 0, 0 };
-        }else if( ProcessID > 0 ) { // Parent
-            ::close( Pipes[1] ); // Close Write end of pipe
-            return { Pipes[0], ProcessID };
-        }else{
-            throw std::runtime_error("Unable to create forked process.");
+        }, Pipes, OwnProcessGroup );
+    }
+
+    /// @brief Creates and launches a new process.
+    /// @remarks The path to the executable to be launched must appear in both parameters to this function.
+    /// @param ExePathName Specifies the exe that will be launched. MUST contain the path to the executable
+    /// being launched.
+    /// @param Arguments The space separated arguments given to the exe being launched. This MUST include
+    /// the path the executable as the first argument.
+    /// @param WithInput If true the child's cin is connected to a pipe returned as ChildInput, otherwise it is
+    /// inherited.
+    /// @param WithResults If true the child gets a result channel on ResultChannelDescriptor, whose non-blocking
+    /// read end is returned as ChildResults.
+    /// @param OwnProcessGroup If true the child leads a new process group, so it and anything it starts can be
+    /// killed together. Such children no longer get signals sent to the terminal's process group, like Ctrl-C.
+    /// @return Returns a ProcessInfo struct containing information about the launched process.
+    [[nodiscard]]
+    ProcessInfo CreateCommandProcess(StringView ExePathName, const StringView Arguments,
+                                     const Boole WithInput = false, const Boole WithResults = false,
+                                     const Boole OwnProcessGroup = false)
+    {
+        // Tokenizing might throw, so we do it before anything is created to allow graceful error handling.
+        return SpawnCommandProcess( String{ExePathName}, TokenizeProcessArguments(Arguments),
+                                    WithInput, WithResults, OwnProcessGroup );
+    }
+
+    /// @brief Forks a copy of this process that does some work instead of running another executable.
+    /// @remarks The child skips exec, so it keeps everything this process already set up, but only the thread that
+    /// forked it. It leaves with _exit, so no destructors or atexit handlers run twice.
+    /// @param Work What the child does, its return value is the child's exit code. If it throws the child exits with
+    /// EXIT_FAILURE.
+    /// @param WithResults If true the child gets a result channel on ResultChannelDescriptor, whose non-blocking
+    /// read end is returned as ChildResults.
+    /// @param OwnProcessGroup If true the child leads a new process group, so it and anything it starts can be
+    /// killed together.
+    /// @return Returns a ProcessInfo struct containing information about the forked process.
+    [[nodiscard]]
+    ProcessInfo CreateForkedProcess(const Testing::ProcessScheduler::ForkedWorkType& Work,
+                                    const Boole WithResults, const Boole OwnProcessGroup)
+    {
+        ChildPipeSet Pipes = CreateChildPipes(false, WithResults);
+        return ForkChildProcess( [&Work]()
+        {
+            Integer Code = EXIT_FAILURE;
+            try {
+                Code = Work();
+            } catch(...) {
+                Code = EXIT_FAILURE;
+            }
+            std::cout.flush();
+            ::_exit( static_cast<int>(Code) );
+        }, Pipes, OwnProcessGroup );
+    }
+
+    /// @brief Converts the status waitpid reports into something like an exit code.
+    /// @param Status The raw status from waitpid.
+    /// @return The exit code if the child exited, or the signal number if a signal ended it.
+    [[nodiscard]]
+    Integer DecodeWaitStatus(const int Status)
+    {
+        if( WIFEXITED(Status) ) {
+            return WEXITSTATUS(Status);
+        }else if( WIFSIGNALED(Status) ) {
+            return WTERMSIG(Status);
+        }
+        // No idea what else could have happened
+        return Status;
+    }
+
+    /// @brief Wait for a child to end and find out how it ended and what it used while it ran.
+    /// @param ChildID The process to wait on.
+    /// @param Result Where to put the exit code, the signal that ended it if any, and the usage.
+    void WaitForChild(const pid_t ChildID, Testing::CommandResult& Result)
+    {
+        int Status = -1;
+        struct rusage Used{};
+        const Boole Waited{ ::wait4(ChildID,&Status,0,&Used) == ChildID };
+        Result.ExitCode = DecodeWaitStatus(Status);
+        if( !Waited )
+            { return; }
+        if( WIFSIGNALED(Status) )
+            { Result.Signal = WTERMSIG(Status); }
+
+        Testing::ResourceUsage& Usage = Result.Usage;
+        Usage.Measured = true;
+#ifdef MEZZ_MacOSX
+        Usage.PeakResidentKiB = static_cast<UInt64>(Used.ru_maxrss) / 1024; // Apple counts bytes, not kibibytes.
+#else // MEZZ_MacOSX
+        Usage.PeakResidentKiB = static_cast<UInt64>(Used.ru_maxrss);
+#endif // MEZZ_MacOSX
+        Usage.UserTime = std::chrono::seconds(Used.ru_utime.tv_sec) +
+                         std::chrono::microseconds(Used.ru_utime.tv_usec);
+        Usage.SystemTime = std::chrono::seconds(Used.ru_stime.tv_sec) +
+                           std::chrono::microseconds(Used.ru_stime.tv_usec);
+        Usage.MajorFaults = static_cast<UInt64>(Used.ru_majflt);
+        Usage.MinorFaults = static_cast<UInt64>(Used.ru_minflt);
+        Usage.VoluntarySwitches = static_cast<UInt64>(Used.ru_nvcsw);
+        Usage.InvoluntarySwitches = static_cast<UInt64>(Used.ru_nivcsw);
+    }
+
+    /// @brief Work out how long poll should wait for a time limit, never rounding down to a busy wait.
+    /// @param Remaining How long until the time limit.
+    /// @return The time in whole milliseconds, rounded up.
+    [[nodiscard]]
+    std::chrono::milliseconds PollDelay(const std::chrono::nanoseconds Remaining)
+        { return std::chrono::ceil<std::chrono::milliseconds>(Remaining); }
+
+    /// @brief Convert a delay into the timeout poll takes.
+    /// @param Delay How long to wait, negative to wait forever.
+    /// @return Milliseconds that fit in an int, or -1 to wait forever.
+    [[nodiscard]]
+    int PollTimeout(const std::chrono::milliseconds Delay)
+    {
+        if( Delay.count() < 0 )
+            { return -1; }
+        using RepType = std::chrono::milliseconds::rep;
+        return static_cast<int>( std::min<RepType>(Delay.count(), std::numeric_limits<int>::max()) );
+    }
+
+    /// @brief Pick whichever of two poll delays ends first.
+    /// @param First One delay, negative to wait forever.
+    /// @param Second Another delay, negative to wait forever.
+    /// @return The shorter delay, or a negative value if both wait forever.
+    [[nodiscard]]
+    std::chrono::milliseconds EarlierDelay(const std::chrono::milliseconds First,
+                                           const std::chrono::milliseconds Second)
+    {
+        if( First.count() < 0 )
+            { return Second; }
+        if( Second.count() < 0 )
+            { return First; }
+        return std::min(First, Second);
+    }
+
+    /// @brief How often poll wakes up to check a cancellation token that another thread might cancel.
+    constexpr std::chrono::milliseconds CancellationCheckInterval{100};
+
+    /// @brief Reads whatever one of a child's pipes has ready onto the end of a String.
+    /// @param Descriptor The read end of the pipe, closed and set to -1 once the child closes its end.
+    /// @param Into Where to append what was read.
+    /// @return Returns true if anything was read.
+    Boole ReadAvailable(Integer& Descriptor, String& Into)
+    {
+        char PipeBuf[4096];
+        const ssize_t BytesRead = ::read(Descriptor,PipeBuf,sizeof(PipeBuf));
+        if( BytesRead > 0 ) {
+            Into.append(PipeBuf,static_cast<size_t>(BytesRead));
+            return true;
         }
+        if( BytesRead < 0 && ( EINTR == errno || EAGAIN == errno ) )
+            { return false; }
+        ::close(Descriptor);
+        Descriptor = -1;
+        return false;
+    }
+
+    /// @brief Reads everything a non-blocking pipe from a child has ready, without waiting for more.
+    /// @param Descriptor The read end of the pipe, closed and set to -1 once the child closes its end.
+    /// @param Into Where to append what was read.
+    void DrainAvailable(Integer& Descriptor, String& Into)
+    {
+        while( 0 <= Descriptor && ReadAvailable(Descriptor, Into) )
+            {}
+    }
+
+    /// @brief Removes the newlines from the end of some output.
+    /// @param Output The output to trim.
+    void TrimNewlines(String& Output)
+    {
+        while( CanTrimBack(Output) )
+            { Output.pop_back(); }
     }
 
     /// @brief Launches a new process with the given command and collects it's output.
+    /// @remarks Its cout and cerr are polled together, so a child that fills one pipe while this waits on the other
+    /// can never deadlock.
     /// @param ExePathName The absolute path, relative path, or file name in the system path to be executed.
     /// @param Command The arguments given to the launched executable.
-    /// @return Returns a command result, containing the exit code and console output of the launched executable.
+    /// @param OnLine If set, each line of output is passed here as it arrives instead of being collected.
+    /// @return Returns a command result, containing the exit code, console output and error output of the launched
+    /// executable.
     [[nodiscard]]
-    Testing::CommandResult RunCommandImpl(const StringView ExePathName, const StringView Command)
+    Testing::CommandResult RunCommandImpl(const StringView ExePathName, const StringView Command,
+                                          const Testing::OutputLineCallback& OnLine = {})
     {
         Testing::CommandResult Result;
 
         String NonConstExecPath{ ExePathName };
         ProcessInfo ChildInfo = CreateCommandProcess( NonConstExecPath, Command );
 
-        ssize_t BytesRead = -1;
-        char PipeBuf[1024];
-        // Start reading and keep on reading until we hit an error or EoF.
-        while( ( BytesRead = ::read(ChildInfo.ChildPipe,PipeBuf,sizeof(PipeBuf)) ) > 0 )
-            { Result.ConsoleOutput.append(PipeBuf,static_cast<size_t>(BytesRead)); }
-        ::close(ChildInfo.ChildPipe);
-
-        int Status = -1;
-        ::waitpid(ChildInfo.ChildPID,&Status,0);
-        if( WIFEXITED(Status) ) {
-            Result.ExitCode = WEXITSTATUS(Status);
-        }else if( WIFSIGNALED(Status) ) {
-            Result.ExitCode = WTERMSIG(Status);
-        }else{
-            // No idea what else could have happened
-            Result.ExitCode = Status;
+        // Keep on reading until both pipes hit an error or EoF, poll ignores the negative one that closed first.
+        pollfd Watched[2] = { { ChildInfo.ChildPipe, POLLIN, 0 }, { ChildInfo.ChildErrors, POLLIN, 0 } };
+        while( 0 <= Watched[0].fd || 0 <= Watched[1].fd )
+        {
+            if( ::poll(Watched, 2, -1) < 0 ) {
+                if( EINTR == errno )
+                    { continue; }
+                break;
+            }
+            if( 0 != Watched[0].revents && ReadAvailable(Watched[0].fd, Result.ConsoleOutput) && OnLine )
+                { DeliverCompleteLines(Result.ConsoleOutput, OnLine); }
+            if( 0 != Watched[1].revents )
+                { ReadAvailable(Watched[1].fd, Result.ErrorOutput); }
+        }
+        for( const pollfd& StillOpen : Watched )
+        {
+            if( 0 <= StillOpen.fd )
+                { ::close(StillOpen.fd); }
         }
+        if( OnLine )
+            { DeliverLastLine(Result.ConsoleOutput, OnLine); }
 
-        // Trim newlines
-        while( CanTrimBack(Result.ConsoleOutput) )
-            { Result.ConsoleOutput.pop_back(); }
+        WaitForChild(ChildInfo.ChildPID, Result);
+
+        TrimNewlines(Result.ConsoleOutput);
+        TrimNewlines(Result.ErrorOutput);
         return Result;
     }
 #endif // MEZZ_Windows
@@ -468,6 +905,53 @@ namespace Testing {
 #endif // MEZZ_Windows
     }
 
+    CommandResult StreamCommand(const StringView Command, const OutputLineCallback& OnLine)
+    {
+        if( IsUnsafeForProcessCommand(Command) )
+            { throw std::runtime_error("Command included unsafe characters, it would not run correctly."); }
+#ifdef MEZZ_Windows
+        const WideString Empty;
+        WideString WideCommand{ ConvertToWideString(Command) };
+        return RunCommandImpl(Empty,WideCommand,OnLine);
+#else // Mezz_Windows
+        const String ExecPath{ ExtractExecPath(Command) };
+        return RunCommandImpl(ExecPath,Command,OnLine);
+#endif // MEZZ_Windows
+    }
+
+    void WriteToDescriptor(const Integer Descriptor, const StringView Bytes)
+    {
+        StringView::size_type Written = 0;
+        while( Written < Bytes.size() )
+        {
+#ifdef MEZZ_Windows
+            const int Result = ::_write(Descriptor, Bytes.data() + Written,
+                                        static_cast<unsigned int>( std::min<StringView::size_type>(
+                                            Bytes.size() - Written, std::numeric_limits<int>::max()) ));
+            if( Result < 0 )
+                { throw std::runtime_error("Unable to write to file descriptor."); }
+#else // MEZZ_Windows
+            const ssize_t Result = ::write(Descriptor, Bytes.data() + Written, Bytes.size() - Written);
+            if( Result < 0 && EINTR == errno )
+                { continue; }
+            if( Result < 0 )
+                { throw std::runtime_error("Unable to write to file descriptor."); }
+#endif // MEZZ_Windows
+            Written += static_cast<StringView::size_type>(Result);
+        }
+    }
+
+#ifndef MEZZ_Windows
+    void IgnoreBrokenPipes()
+    {
+        struct sigaction Ignore;
+        ::memset(&Ignore, 0, sizeof(Ignore));
+        Ignore.sa_handler = SIG_IGN;
+        ::sigemptyset(&Ignore.sa_mask);
+        ::sigaction(SIGPIPE, &Ignore, nullptr);
+    }
+#endif // MEZZ_Windows
+
     CommandResult RunCommandInShell(const StringView ExePathName, const StringView Command)
     {
         if( IsUnsafeForProcessCommand(ExePathName) || IsUnsafeForProcessCommand(Command) )
@@ -500,5 +984,549 @@ namespace Testing {
         return RunCommandImpl(ExecPath,ShellCommand);
 #endif // MEZZ_Windows
     }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // Many commands at once
+
+    ProcessScheduler::ProcessScheduler(const Whole ProcessLimit)
+        : MaxProcesses( std::max(ProcessLimit, Whole{1}) )
+        {}
+
+    Whole ProcessScheduler::GetMaxProcesses() const
+        { return MaxProcesses; }
+
+    void ProcessScheduler::AddCommand(const StringView Command, CompletionType WhenDone,
+                                      OutputLineCallback OnLine, ResultChannelCallback OnResults,
+                                      const std::chrono::nanoseconds TimeLimit)
+    {
+        if( IsUnsafeForProcessCommand(Command) )
+            { throw std::runtime_error("Command included unsafe characters, it would not run correctly."); }
+#ifdef MEZZ_Windows
+        Pending.push_back( PendingCommand{ String{Command}, {}, {}, std::move(WhenDone),
+                                           std::move(OnLine), std::move(OnResults), TimeLimit } );
+#else // MEZZ_Windows
+        // Malformed quotes throw here rather than in the middle of Run, and it is only split up once.
+        AddCommand( TokenizeProcessArguments(Command), std::move(WhenDone),
+                    std::move(OnLine), std::move(OnResults), TimeLimit );
+#endif // MEZZ_Windows
+    }
+
+#ifndef MEZZ_Windows
+    void ProcessScheduler::AddCommand(ArgumentListType Arguments, CompletionType WhenDone,
+                                      OutputLineCallback OnLine, ResultChannelCallback OnResults,
+                                      const std::chrono::nanoseconds TimeLimit)
+    {
+        if( Arguments.empty() )
+            { throw std::invalid_argument("A command needs at least an executable to run."); }
+        Pending.push_back( PendingCommand{ String{}, std::move(Arguments), {}, std::move(WhenDone),
+                                           std::move(OnLine), std::move(OnResults), TimeLimit } );
+    }
+
+    void ProcessScheduler::AddFork(ForkedWorkType Work, CompletionType WhenDone,
+                                   OutputLineCallback OnLine, ResultChannelCallback OnResults,
+                                   const std::chrono::nanoseconds TimeLimit)
+    {
+        if( !Work )
+            { throw std::invalid_argument("A forked child needs some work to do."); }
+        Pending.push_back( PendingCommand{ String{}, {}, std::move(Work), std::move(WhenDone),
+                                           std::move(OnLine), std::move(OnResults), TimeLimit } );
+    }
+#endif // MEZZ_Windows
+
+    void ProcessScheduler::SetCancellationToken(CancellationToken Token)
+    {
+        StopToken = std::move(Token);
+        WatchingStopToken = true;
+    }
+
+    void ProcessScheduler::Run()
+    {
+        while( !Pending.empty() || !Running.empty() )
+        {
+            if( StopToken.IsCancelled() )
+            {
+                CancelPending();
+                KillRunning();
+            }
+            while( Running.size() < MaxProcesses && !Pending.empty() )
+                { LaunchNext(); }
+            WaitForChildren();
+        }
+    }
+
+    void ProcessScheduler::CancelPending()
+    {
+        // Popping each first means completions that add more commands just get those cancelled too.
+        while( !Pending.empty() )
+        {
+            PendingCommand Skipped{ std::move(Pending.front()) };
+            Pending.pop_front();
+            CommandResult Result;
+            Result.Cancelled = true;
+            Skipped.WhenDone( std::move(Result), std::chrono::nanoseconds::zero() );
+        }
+    }
+
+#ifdef MEZZ_Windows
+    void ProcessScheduler::LaunchNext()
+    {
+        // Without poll for pipes this simply runs the command to completion right here.
+        PendingCommand Next{ std::move(Pending.front()) };
+        Pending.pop_front();
+        const auto Launched = std::chrono::high_resolution_clock::now();
+        CommandResult Result{ Next.OnLine ? StreamCommand(Next.Command, Next.OnLine) : RunCommand(Next.Command) };
+        Next.WhenDone( std::move(Result),
+                       std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::high_resolution_clock::now() - Launched) );
+    }
+
+    void ProcessScheduler::WaitForChildren()
+        {}
+
+    std::chrono::milliseconds ProcessScheduler::KillOverdueChildren()
+        { return std::chrono::milliseconds{-1}; }
+
+    void ProcessScheduler::KillRunning()
+        {}
+
+    void ProcessScheduler::FinishChild(const std::vector<RunningCommand>::size_type Index)
+        { (void)Index; }
+#else // MEZZ_Windows
+    void ProcessScheduler::LaunchNext()
+    {
+        PendingCommand Next{ std::move(Pending.front()) };
+        Pending.pop_front();
+
+        // Only children that might be killed get their own group, so the rest still get Ctrl-C from the terminal.
+        const Boole OwnGroup = WatchingStopToken || Next.TimeLimit > std::chrono::nanoseconds::zero();
+        const Boole WithResults = static_cast<Boole>(Next.OnResults);
+        ProcessInfo ChildInfo = Next.Work ? CreateForkedProcess( Next.Work, WithResults, OwnGroup )
+                                          : SpawnCommandProcess( Next.Arguments.front(), Next.Arguments,
+                                                                 false, WithResults, OwnGroup );
+
+        RunningCommand Child;
+        Child.ChildPipe = ChildInfo.ChildPipe;
+        Child.ErrorPipe = ChildInfo.ChildErrors;
+        Child.ResultPipe = ChildInfo.ChildResults;
+        Child.OnResults = std::move(Next.OnResults);
+        Child.ChildID = ChildInfo.ChildPID;
+        Child.Launched = std::chrono::high_resolution_clock::now();
+        Child.TimeLimit = Next.TimeLimit;
+        Child.LeadsProcessGroup = OwnGroup;
+        Child.WhenDone = std::move(Next.WhenDone);
+        Child.OnLine = std::move(Next.OnLine);
+        Running.push_back( std::move(Child) );
+    }
+
+    void ProcessScheduler::WaitForChildren()
+    {
+        // Each child has its output, its errors then its result channel, poll ignores the negative ones that are
+        // closed.
+        std::vector<pollfd> Watched;
+        Watched.reserve( Running.size() * 3 );
+        for( const RunningCommand& Child : Running )
+        {
+            Watched.push_back( pollfd{ Child.ChildPipe, POLLIN, 0 } );
+            Watched.push_back( pollfd{ Child.ErrorPipe, POLLIN, 0 } );
+            Watched.push_back( pollfd{ Child.ResultPipe, POLLIN, 0 } );
+        }
+
+        std::chrono::milliseconds Delay{ KillOverdueChildren() };
+        if( WatchingStopToken )
+            { Delay = EarlierDelay(Delay, CancellationCheckInterval); }
+        if( ::poll(Watched.data(), static_cast<nfds_t>(Watched.size()), PollTimeout(Delay)) < 0 ) {
+            if( EINTR == errno )
+                { return; }
+            throw std::runtime_error("Unable to wait on child process pipes.");
+        }
+
+        // Walk backwards so finishing a child only moves entries that were already handled.
+        char PipeBuf[4096];
+        for( std::vector<RunningCommand>::size_type Index = Running.size() ; Index-- > 0 ; )
+        {
+            RunningCommand& Child = Running[Index];
+            if( 0 != Watched[Index * 3 + 2].revents ) {
+                const ssize_t BytesRead = ::read(Child.ResultPipe,PipeBuf,sizeof(PipeBuf));
+                if( BytesRead > 0 ) {
+                    Child.OnResults( StringView(PipeBuf,static_cast<size_t>(BytesRead)) );
+                }else if( BytesRead == 0 || ( EINTR != errno && EAGAIN != errno ) ) {
+                    ::close(Child.ResultPipe);
+                    Child.ResultPipe = -1;
+                }
+            }
+            if( 0 != Watched[Index * 3].revents && ReadAvailable(Child.ChildPipe, Child.Result.ConsoleOutput) &&
+                Child.OnLine )
+                { DeliverCompleteLines(Child.Result.ConsoleOutput, Child.OnLine); }
+            if( 0 != Watched[Index * 3 + 1].revents )
+                { ReadAvailable(Child.ErrorPipe, Child.Result.ErrorOutput); }
+            if( Child.ChildPipe < 0 && Child.ErrorPipe < 0 && Child.ResultPipe < 0 )
+                { FinishChild(Index); }
+        }
+    }
+
+    std::chrono::milliseconds ProcessScheduler::KillOverdueChildren()
+    {
+        const auto Now = std::chrono::high_resolution_clock::now();
+        std::chrono::milliseconds NextDelay{-1};
+        for( RunningCommand& Child : Running )
+        {
+            if( Child.TimeLimit <= std::chrono::nanoseconds::zero() || Child.Result.TimedOut || Child.Result.Cancelled )
+                { continue; }
+            const std::chrono::nanoseconds Elapsed{ Now - Child.Launched };
+            if( Elapsed >= Child.TimeLimit ) {
+                // Its pipes close once everything in the group is dead, then it finishes like any other child.
+                ::kill( -Child.ChildID, SIGKILL ); // Having a time limit means it leads its own group.
+                Child.Result.TimedOut = true;
+            }else{
+                const std::chrono::milliseconds Delay{ PollDelay(Child.TimeLimit - Elapsed) };
+                if( NextDelay.count() < 0 || Delay < NextDelay )
+                    { NextDelay = Delay; }
+            }
+        }
+        return NextDelay;
+    }
+
+    void ProcessScheduler::KillRunning()
+    {
+        for( RunningCommand& Child : Running )
+        {
+            if( Child.Result.Cancelled || Child.Result.TimedOut )
+                { continue; }
+            ::kill( Child.LeadsProcessGroup ? -Child.ChildID : Child.ChildID, SIGKILL );
+            Child.Result.Cancelled = true;
+        }
+    }
+
+    void ProcessScheduler::FinishChild(const std::vector<RunningCommand>::size_type Index)
+    {
+        RunningCommand Child{ std::move(Running[Index]) };
+        Running.erase( Running.begin() + static_cast<std::vector<RunningCommand>::difference_type>(Index) );
+        if( Child.OnLine )
+            { DeliverLastLine(Child.Result.ConsoleOutput, Child.OnLine); }
+
+        WaitForChild(Child.ChildID, Child.Result);
+        TrimNewlines(Child.Result.ConsoleOutput);
+        TrimNewlines(Child.Result.ErrorOutput);
+
+        Child.WhenDone( std::move(Child.Result),
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::high_resolution_clock::now() - Child.Launched) );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////
+    // Long lived workers
+
+    WorkerProcessPool::WorkerProcessPool(const StringView Command, const Whole WorkerLimit, const StringView Marker)
+        : WorkerCommand(Command),
+          EndMarker(Marker),
+          MaxWorkers( std::max(WorkerLimit, Whole{1}) )
+    {
+        if( IsUnsafeForProcessCommand(Command) )
+            { throw std::runtime_error("Command included unsafe characters, it would not run correctly."); }
+        (void)TokenizeProcessArguments(Command); // Malformed quotes throw here rather than in the middle of Run.
+    }
+
+    WorkerProcessPool::~WorkerProcessPool()
+        { StopWorkers(); }
+
+    Whole WorkerProcessPool::GetMaxWorkers() const
+        { return MaxWorkers; }
+
+    void WorkerProcessPool::AddRequest(const StringView Request, CompletionType WhenDone,
+                                       OutputLineCallback OnLine, ResultChannelCallback OnResults,
+                                       const std::chrono::nanoseconds TimeLimit)
+    {
+        if( StringView::npos != Request.find('\n') )
+            { throw std::invalid_argument("Worker requests must be a single line."); }
+        Pending.push_back( PendingRequest{ String{Request}, std::move(WhenDone),
+                                           std::move(OnLine), std::move(OnResults), TimeLimit } );
+    }
+
+    void WorkerProcessPool::SetCancellationToken(CancellationToken Token)
+    {
+        StopToken = std::move(Token);
+        WatchingStopToken = true;
+    }
+
+    void WorkerProcessPool::Run()
+    {
+        while( !Pending.empty() ||
+               std::any_of(Workers.cbegin(), Workers.cend(), [](const Worker& OneWorker){ return OneWorker.Busy; }) )
+        {
+            if( StopToken.IsCancelled() )
+            {
+                CancelPending();
+                KillBusyWorkers();
+            }
+            AssignRequests();
+            WaitForWorkers();
+        }
+        StopWorkers();
+    }
+
+    void WorkerProcessPool::CancelPending()
+    {
+        while( !Pending.empty() )
+        {
+            PendingRequest Skipped{ std::move(Pending.front()) };
+            Pending.pop_front();
+            CommandResult Result;
+            Result.Cancelled = true;
+            Skipped.WhenDone( std::move(Result), std::chrono::nanoseconds::zero() );
+        }
+    }
+
+    void WorkerProcessPool::KillBusyWorkers()
+    {
+        for( Worker& OneWorker : Workers )
+        {
+            if( !OneWorker.Busy || OneWorker.Cancelled || OneWorker.TimedOut )
+                { continue; }
+            ::kill( -OneWorker.ChildID, SIGKILL );
+            OneWorker.Cancelled = true;
+        }
+    }
+
+    void WorkerProcessPool::AssignRequests()
+    {
+        for( Worker& OneWorker : Workers )
+        {
+            if( Pending.empty() )
+                { return; }
+            if( OneWorker.Busy )
+                { continue; }
+
+            PendingRequest Next{ std::move(Pending.front()) };
+            Pending.pop_front();
+            OneWorker.Busy = true;
+            OneWorker.Output.clear();
+            OneWorker.Errors.clear();
+            OneWorker.WhenDone = std::move(Next.WhenDone);
+            OneWorker.OnLine = std::move(Next.OnLine);
+            OneWorker.OnResults = std::move(Next.OnResults);
+            OneWorker.TimeLimit = Next.TimeLimit;
+            OneWorker.Started = std::chrono::high_resolution_clock::now();
+
+            // A failed write means the worker died, poll will see its output close and fail this request.
+            const String Line{ Next.Request + "\n" };
+            String::size_type Written = 0;
+            while( Written < Line.size() )
+            {
+                const ssize_t Result = ::write(OneWorker.ChildInput, Line.data() + Written, Line.size() - Written);
+                if( Result < 0 && EINTR == errno )
+                    { continue; }
+                if( Result < 0 )
+                    { break; }
+                Written += static_cast<String::size_type>(Result);
+            }
+        }
+
+        if( !Pending.empty() && Workers.size() < MaxWorkers ) {
+            const String ExecPath{ ExtractExecPath(WorkerCommand) };
+            ProcessInfo ChildInfo = CreateCommandProcess( ExecPath, WorkerCommand, true, true, true );
+            Worker Fresh;
+            Fresh.ChildInput = ChildInfo.ChildInput;
+            Fresh.ChildOutput = ChildInfo.ChildPipe;
+            Fresh.ChildErrors = ChildInfo.ChildErrors;
+            Fresh.ResultPipe = ChildInfo.ChildResults;
+            Fresh.ChildID = ChildInfo.ChildPID;
+            Workers.push_back( std::move(Fresh) );
+            AssignRequests(); // Hand the new worker something and maybe start another.
+        }
+    }
+
+    void WorkerProcessPool::WaitForWorkers()
+    {
+        // Each worker has its output, its errors then its result channel, poll ignores the negative ones that are
+        // closed.
+        std::vector<pollfd> Watched;
+        Watched.reserve( Workers.size() * 3 );
+        for( const Worker& OneWorker : Workers )
+        {
+            Watched.push_back( pollfd{ OneWorker.ChildOutput, POLLIN, 0 } );
+            Watched.push_back( pollfd{ OneWorker.ChildErrors, POLLIN, 0 } );
+            Watched.push_back( pollfd{ OneWorker.ResultPipe, POLLIN, 0 } );
+        }
+
+        std::chrono::milliseconds Delay{ KillOverdueWorkers() };
+        if( WatchingStopToken )
+            { Delay = EarlierDelay(Delay, CancellationCheckInterval); }
+        if( ::poll(Watched.data(), static_cast<nfds_t>(Watched.size()), PollTimeout(Delay)) < 0 ) {
+            if( EINTR == errno )
+                { return; }
+            throw std::runtime_error("Unable to wait on worker process pipes.");
+        }
+
+        // Walk backwards so losing a worker only moves entries that were already handled.
+        char PipeBuf[4096];
+        for( std::vector<Worker>::size_type Index = Workers.size() ; Index-- > 0 ; )
+        {
+            if( 0 != Watched[Index * 3 + 2].revents )
+                { DrainResults(Workers[Index]); } // Read it now, so the worker never blocks on a full pipe.
+            if( 0 != Watched[Index * 3 + 1].revents )
+                { DrainErrors(Workers[Index]); }
+            if( 0 == Watched[Index * 3].revents )
+                { continue; }
+            const ssize_t BytesRead = ::read(Workers[Index].ChildOutput,PipeBuf,sizeof(PipeBuf));
+            if( BytesRead > 0 ) {
+                Worker& OneWorker = Workers[Index];
+                if( OneWorker.Busy ) {
+                    OneWorker.Output.append(PipeBuf,static_cast<size_t>(BytesRead));
+                    CheckForEndMarker(OneWorker);
+                }
+            }else if( BytesRead == 0 || EINTR != errno ) {
+                LoseWorker(Index);
+            }
+        }
+    }
+
+    std::chrono::milliseconds WorkerProcessPool::KillOverdueWorkers()
+    {
+        const auto Now = std::chrono::high_resolution_clock::now();
+        std::chrono::milliseconds NextDelay{-1};
+        for( Worker& OneWorker : Workers )
+        {
+            if( !OneWorker.Busy || OneWorker.TimedOut || OneWorker.Cancelled ||
+                OneWorker.TimeLimit <= std::chrono::nanoseconds::zero() )
+                { continue; }
+            const std::chrono::nanoseconds Elapsed{ Now - OneWorker.Started };
+            if( Elapsed >= OneWorker.TimeLimit ) {
+                // Its output closes once everything in the group is dead, then it is lost like any other worker.
+                ::kill( -OneWorker.ChildID, SIGKILL );
+                OneWorker.TimedOut = true;
+            }else{
+                const std::chrono::milliseconds Delay{ PollDelay(OneWorker.TimeLimit - Elapsed) };
+                if( NextDelay.count() < 0 || Delay < NextDelay )
+                    { NextDelay = Delay; }
+            }
+        }
+        return NextDelay;
+    }
+
+    void WorkerProcessPool::DrainResults(Worker& OneWorker)
+    {
+        char PipeBuf[4096];
+        while( 0 <= OneWorker.ResultPipe )
+        {
+            const ssize_t BytesRead = ::read(OneWorker.ResultPipe,PipeBuf,sizeof(PipeBuf));
+            if( BytesRead > 0 ) {
+                if( OneWorker.Busy && OneWorker.OnResults )
+                    { OneWorker.OnResults( StringView(PipeBuf,static_cast<size_t>(BytesRead)) ); }
+            }else if( BytesRead < 0 && EINTR == errno ) {
+                continue;
+            }else if( BytesRead < 0 && EAGAIN == errno ) {
+                return; // Nothing more for now.
+            }else{
+                ::close(OneWorker.ResultPipe);
+                OneWorker.ResultPipe = -1;
+            }
+        }
+    }
+
+    void WorkerProcessPool::DrainErrors(Worker& OneWorker)
+    {
+        DrainAvailable(OneWorker.ChildErrors, OneWorker.Errors);
+        if( !OneWorker.Busy )
+            { OneWorker.Errors.clear(); } // Printed between requests, so it belongs to none of them.
+    }
+
+    void WorkerProcessPool::CheckForEndMarker(Worker& OneWorker)
+    {
+        CommandResult Result;
+        if( OneWorker.OnLine ) {
+            Boole Finished = false;
+            DeliverCompleteLines(OneWorker.Output,
+                [this, &OneWorker, &Finished](const StringView Line)
+                {
+                    if( Finished )
+                        { return; } // Nothing after the marker belongs to this request.
+                    if( EndMarker == Line )
+                        { Finished = true; }
+                    else
+                        { OneWorker.OnLine(Line); }
+                });
+            if( !Finished )
+                { return; }
+        }else{
+            const String MarkerLine{ EndMarker + "\n" };
+            if( OneWorker.Output.size() < MarkerLine.size() ||
+                0 != OneWorker.Output.compare(OneWorker.Output.size() - MarkerLine.size(),
+                                              MarkerLine.size(), MarkerLine) )
+                { return; }
+            const String::size_type MarkerStart = OneWorker.Output.size() - MarkerLine.size();
+            if( 0 != MarkerStart && '\n' != OneWorker.Output[MarkerStart - 1] )
+                { return; }
+
+            Result.ConsoleOutput = OneWorker.Output.substr(0, MarkerStart);
+            TrimNewlines(Result.ConsoleOutput);
+        }
+        Result.ExitCode = EXIT_SUCCESS;
+        DrainResults(OneWorker); // Everything sent there came before the marker, so it is all in the pipe already.
+        DrainErrors(OneWorker); // Likewise for cerr, which is never buffered.
+        Result.ErrorOutput = std::move(OneWorker.Errors);
+        TrimNewlines(Result.ErrorOutput);
+
+        CompletionType WhenDone{ std::move(OneWorker.WhenDone) };
+        const auto Duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::high_resolution_clock::now() - OneWorker.Started);
+        OneWorker.Busy = false;
+        OneWorker.Output.clear();
+        OneWorker.Errors.clear();
+        WhenDone(std::move(Result), Duration);
+    }
+
+    void WorkerProcessPool::LoseWorker(const std::vector<Worker>::size_type Index)
+    {
+        Worker Lost{ std::move(Workers[Index]) };
+        Workers.erase( Workers.begin() + static_cast<std::vector<Worker>::difference_type>(Index) );
+        DrainResults(Lost);
+        DrainErrors(Lost);
+        ::close(Lost.ChildInput);
+        ::close(Lost.ChildOutput);
+        if( 0 <= Lost.ChildErrors )
+            { ::close(Lost.ChildErrors); }
+        if( 0 <= Lost.ResultPipe )
+            { ::close(Lost.ResultPipe); }
+
+        int Status = -1;
+        ::waitpid(Lost.ChildID,&Status,0);
+        if( !Lost.Busy )
+            { return; } // An idle worker leaving is only a problem for the next request, which it won't get.
+        if( Lost.OnLine )
+            { DeliverLastLine(Lost.Output, Lost.OnLine); }
+
+        CommandResult Result;
+        Result.ConsoleOutput = std::move(Lost.Output);
+        Result.ErrorOutput = std::move(Lost.Errors);
+        Result.ExitCode = DecodeWaitStatus(Status);
+        Result.TimedOut = Lost.TimedOut;
+        Result.Cancelled = Lost.Cancelled;
+        if( EXIT_SUCCESS == Result.ExitCode )
+            { Result.ExitCode = EXIT_FAILURE; } // It left without finishing, that is never a success.
+        TrimNewlines(Result.ConsoleOutput);
+        TrimNewlines(Result.ErrorOutput);
+
+        Lost.WhenDone( std::move(Result),
+                       std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::high_resolution_clock::now() - Lost.Started) );
+    }
+
+    void WorkerProcessPool::StopWorkers() noexcept
+    {
+        for( Worker& OneWorker : Workers )
+            { ::close(OneWorker.ChildInput); } // Closing all first lets them all exit at once.
+        for( Worker& OneWorker : Workers )
+        {
+            ::close(OneWorker.ChildOutput);
+            if( 0 <= OneWorker.ChildErrors )
+                { ::close(OneWorker.ChildErrors); }
+            if( 0 <= OneWorker.ResultPipe )
+                { ::close(OneWorker.ResultPipe); }
+            int Status = -1;
+            ::waitpid(OneWorker.ChildID,&Status,0);
+        }
+        Workers.clear();
+    }
+#endif // MEZZ_Windows
 }// Testing
 }// Mezzanine
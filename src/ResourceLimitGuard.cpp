@@ -0,0 +1,122 @@
+// © Copyright 2010 - 2021 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+
+/// @file
+/// @brief The definition of a way to cap the memory, CPU time and files a process may use for a while.
+
+#include "ResourceLimitGuard.h"
+
+#ifndef MEZZ_Windows
+    #include <sys/resource.h>
+#endif // MEZZ_Windows
+
+namespace
+{
+#ifndef MEZZ_Windows
+    /// @brief The limits in the order ResourceLimitGuard keeps them.
+    const int LimitKinds[3] = { RLIMIT_AS, RLIMIT_CPU, RLIMIT_NOFILE };
+
+    // Lowers just the soft limit, so the hard limit is there to raise it back to afterwards.
+    Mezzanine::Boole SetSoftLimit(const int Kind, const Mezzanine::UInt64 Wanted, Mezzanine::UInt64& Previous)
+    {
+        struct rlimit Current{};
+        if( 0 != ::getrlimit(Kind, &Current) )
+            { return false; }
+        Previous = static_cast<Mezzanine::UInt64>(Current.rlim_cur);
+        rlim_t Soft{ static_cast<rlim_t>(Wanted) };
+        if( RLIM_INFINITY != Current.rlim_max && Current.rlim_max < Soft )
+            { Soft = Current.rlim_max; }
+        Current.rlim_cur = Soft;
+        return 0 == ::setrlimit(Kind, &Current);
+    }
+
+    // The CPU limit counts everything the process ever used, so long lived processes need their past added.
+    Mezzanine::UInt64 CpuSecondsUsed()
+    {
+        struct rusage Used{};
+        if( 0 != ::getrusage(RUSAGE_SELF, &Used) )
+            { return 0; }
+        return static_cast<Mezzanine::UInt64>(Used.ru_utime.tv_sec + Used.ru_stime.tv_sec);
+    }
+#endif // MEZZ_Windows
+}
+
+namespace Mezzanine
+{
+namespace Testing
+{
+    ResourceLimitGuard::ResourceLimitGuard(const ResourceLimits& Limits)
+    {
+#ifndef MEZZ_Windows
+        if( !Limits.Any() )
+            { return; }
+        const UInt64 Wanted[3] = { Limits.AddressSpaceBytes,
+                                   0 == Limits.CpuSeconds ? 0 : CpuSecondsUsed() + Limits.CpuSeconds,
+                                   Limits.OpenFiles };
+        Limited = true;
+        for( Whole Index = 0; Index < 3; ++Index )
+        {
+            if( 0 == Wanted[Index] )
+                { continue; }
+            Changed[Index] = SetSoftLimit(LimitKinds[Index], Wanted[Index], PreviousLimits[Index]);
+            Limited = Limited && Changed[Index];
+        }
+#else // MEZZ_Windows
+        static_cast<void>(Limits);
+#endif // MEZZ_Windows
+    }
+
+    ResourceLimitGuard::~ResourceLimitGuard()
+    {
+#ifndef MEZZ_Windows
+        for( Whole Index = 0; Index < 3; ++Index )
+        {
+            UInt64 Ignored{0};
+            if( Changed[Index] )
+                { static_cast<void>(SetSoftLimit(LimitKinds[Index], PreviousLimits[Index], Ignored)); }
+        }
+#endif // MEZZ_Windows
+    }
+
+    Boole ResourceLimitGuard::IsLimited() const
+        { return Limited; }
+
+}// Testing
+}// Mezzanine
@@ -0,0 +1,243 @@
+// © Copyright 2010 - 2021 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+
+/// @file
+/// @brief The definition of a store of passing results that can be replayed when nothing they depend on changed.
+
+#include "ResultCache.h"
+#include "StringManipulation.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <istream>
+#include <ostream>
+#include <sstream>
+
+namespace
+{
+    using Mezzanine::Boole;
+    using Mezzanine::String;
+    using Mezzanine::UInt64;
+
+    /// @brief What starts every header line in a cache file.
+    constexpr Mezzanine::StringView HeaderBegin("--= ");
+    /// @brief What ends every header line in a cache file.
+    constexpr Mezzanine::StringView HeaderEnd(" =--");
+
+    String ToHex(const UInt64 Value)
+    {
+        std::ostringstream Hex;
+        Hex << std::hex << std::setw(16) << std::setfill('0') << Value;
+        return Hex.str();
+    }
+
+    // Folds the contents of a file into Hash, a piece at a time so large libraries need not fit in memory.
+    Boole HashFileContents(const String& FileName, UInt64& Hash)
+    {
+        std::ifstream File(FileName, std::ios::binary);
+        if(!File)
+            { return false; }
+        String Buffer(64 * 1024, '\0');
+        while(File.read(&Buffer[0], static_cast<std::streamsize>(Buffer.size())) || 0 < File.gcount())
+        {
+            const Mezzanine::StringView Piece(Buffer.data(), static_cast<String::size_type>(File.gcount()));
+            Hash = Mezzanine::Testing::StableStringHash(Piece, Hash);
+        }
+        return File.eof();
+    }
+
+#ifdef MEZZ_Linux
+    // Every file mapped into this process, which includes the executable and all its shared libraries.
+    std::vector<String> GetLoadedFileNames()
+    {
+        std::vector<String> FileNames;
+        std::ifstream Maps("/proc/self/maps");
+        String OneLine;
+        while(std::getline(Maps, OneLine))
+        {
+            // The path is the last column and the only thing that starts with a slash, pseudo files have none.
+            const String::size_type PathBegin = OneLine.find(" /");
+            if(String::npos == PathBegin)
+                { continue; }
+            String FileName = OneLine.substr(PathBegin + 1);
+            if(String::npos != FileName.find(" (deleted)"))
+                { continue; } // Replaced since it was loaded, the new one is not what is running.
+            FileNames.push_back(std::move(FileName));
+        }
+        std::sort(FileNames.begin(), FileNames.end());
+        FileNames.erase(std::unique(FileNames.begin(), FileNames.end()), FileNames.end());
+        return FileNames;
+    }
+#endif // MEZZ_Linux
+}
+
+namespace Mezzanine
+{
+namespace Testing
+{
+    String ResultCache::MakeKey(const String& GroupName, const String& Arguments)
+        { return ToHex(StableStringHash(Arguments)) + ' ' + GroupName; }
+
+    ResultCache::ResultCache(const String& BinaryFingerprint) :
+        Fingerprint(BinaryFingerprint)
+        {}
+
+    const ResultCache::ResultsType* ResultCache::Find(const String& GroupName, const String& Arguments) const
+    {
+        StorageType::const_iterator Found = Entries.find(MakeKey(GroupName, Arguments));
+        if(Entries.end() == Found)
+            { return nullptr; }
+        return &Found->second;
+    }
+
+    void ResultCache::Store(const String& GroupName, const String& Arguments, ResultsType Results)
+        { Entries[MakeKey(GroupName, Arguments)] = std::move(Results); }
+
+    void ResultCache::Forget(const String& GroupName, const String& Arguments)
+        { Entries.erase(MakeKey(GroupName, Arguments)); }
+
+    Whole ResultCache::size() const
+        { return Entries.size(); }
+
+    void ResultCache::Load(std::istream& Source)
+    {
+        StorageType::iterator Current = Entries.end();
+        Whole ExpectedCount{0};
+        // An entry cut short by a run that died while saving, or with a result that did not read back, is dropped.
+        auto DropIfIncomplete = [this, &Current, &ExpectedCount]()
+        {
+            if(Entries.end() != Current && ExpectedCount != Current->second.size())
+                { Entries.erase(Current); }
+            Current = Entries.end();
+        };
+
+        String OneLine;
+        while(std::getline(Source, OneLine))
+        {
+            const Boole IsHeader = HeaderBegin.size() + HeaderEnd.size() <= OneLine.size() &&
+                                   0 == OneLine.compare(0, HeaderBegin.size(), HeaderBegin) &&
+                                   0 == OneLine.compare(OneLine.size() - HeaderEnd.size(), HeaderEnd.size(), HeaderEnd);
+            if(IsHeader)
+            {
+                DropIfIncomplete(); // Results for other builds are skipped until the next header.
+                std::istringstream Inside(OneLine.substr(HeaderBegin.size(),
+                                                         OneLine.size() - HeaderBegin.size() - HeaderEnd.size()));
+                String EntryFingerprint;
+                String Key;
+                if(Inside >> EntryFingerprint >> ExpectedCount && EntryFingerprint == Fingerprint &&
+                   std::getline(Inside >> std::ws, Key) && !Key.empty())
+                {
+                    Current = Entries.emplace(std::move(Key), ResultsType{}).first;
+                    Current->second.clear();
+                }
+                continue;
+            }
+
+            TestData PossibleResult( StringToTestData(OneLine) );
+            if(Entries.end() != Current && TestData{} != PossibleResult)
+                { Current->second.push_back(std::move(PossibleResult)); }
+        }
+        DropIfIncomplete();
+    }
+
+    void ResultCache::Save(std::ostream& Destination) const
+    {
+        for(const StorageType::value_type& OneEntry : Entries)
+        {
+            Destination << HeaderBegin << Fingerprint << ' ' << OneEntry.second.size() << ' '
+                        << OneEntry.first << HeaderEnd << '\n';
+            for(const TestData& OneResult : OneEntry.second)
+                { Destination << OneResult; }
+        }
+    }
+
+    void ResultCache::LoadFile(const String& FileName)
+    {
+        std::ifstream CacheFile(FileName);
+        if(CacheFile)
+            { Load(CacheFile); }
+    }
+
+    void ResultCache::SaveFile(const String& FileName) const
+    {
+        // Written beside the real file then renamed over it, so a run that dies partway leaves the old cache.
+        const String TemporaryName{ FileName + ".tmp" };
+        {
+            std::ofstream CacheFile(TemporaryName);
+            Save(CacheFile);
+            CacheFile.close();
+            if(!CacheFile)
+            {
+                std::remove(TemporaryName.c_str());
+                return;
+            }
+        }
+        if(0 != std::rename(TemporaryName.c_str(), FileName.c_str()))
+        {
+            std::remove(FileName.c_str()); // Windows will not rename over an existing file.
+            if(0 != std::rename(TemporaryName.c_str(), FileName.c_str()))
+                { std::remove(TemporaryName.c_str()); }
+        }
+    }
+
+    String GetLoadedBinariesFingerprint(const String& CommandName)
+    {
+        UInt64 Hash{StableStringHash(StringView{})};
+#ifdef MEZZ_Linux
+        static_cast<void>(CommandName); // The maps name the executable more reliably than however it was started.
+        const std::vector<String> FileNames{ GetLoadedFileNames() };
+        if(FileNames.empty())
+            { return String{}; }
+        for(const String& FileName : FileNames)
+        {
+            if(!HashFileContents(FileName, Hash))
+                { return String{}; }
+        }
+#else // MEZZ_Linux
+        if(!HashFileContents(CommandName, Hash))
+            { return String{}; }
+#endif // MEZZ_Linux
+        return ToHex(Hash);
+    }
+
+}// Testing
+}// Mezzanine
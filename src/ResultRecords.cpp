@@ -0,0 +1,269 @@
+// © Copyright 2010 - 2021 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+
+/// @file
+/// @brief The implementation of the binary records a child process uses to send test results to its parent.
+
+#include "ResultRecords.h"
+
+#include <stdexcept>
+
+namespace {
+    using namespace Mezzanine;
+
+    /// @brief The largest record that is believed, anything bigger means the bytes were not records at all.
+    constexpr UInt32 LargestRecord = 64 * 1024 * 1024;
+    /// @brief The bytes in the length at the start of each record.
+    constexpr String::size_type LengthSize = 4;
+    /// @brief The bytes in the line number of a result record.
+    constexpr String::size_type LineNumberSize = 8;
+    /// @brief The bytes in the signal number of a crash record.
+    constexpr String::size_type SignalSize = 4;
+    /// @brief The bytes in each address or offset of a crash record.
+    constexpr String::size_type AddressSize = 8;
+
+    /// @brief Append an unsigned number as little endian bytes.
+    /// @param Destination Where to write the bytes.
+    /// @param Value The number to write.
+    /// @param Size How many bytes to write.
+    void AppendLittleEndian(String& Destination, const UInt64 Value, const String::size_type Size)
+    {
+        for(String::size_type Index = 0; Index < Size; ++Index)
+            { Destination.push_back( static_cast<char>( (Value >> (8 * Index)) & 0xFF ) ); }
+    }
+
+    /// @brief Read an unsigned number from little endian bytes.
+    /// @param Source Where to read the bytes, must have at least Size bytes from Offset.
+    /// @param Offset Where the first byte is, this is moved past the number.
+    /// @param Size How many bytes to read.
+    /// @return The number read.
+    [[nodiscard]]
+    UInt64 ReadLittleEndian(const StringView Source, String::size_type& Offset, const String::size_type Size)
+    {
+        UInt64 Value = 0;
+        for(String::size_type Index = 0; Index < Size; ++Index)
+            { Value |= UInt64{ static_cast<unsigned char>(Source[Offset + Index]) } << (8 * Index); }
+        Offset += Size;
+        return Value;
+    }
+
+    /// @brief Append a length and then the bytes of some text.
+    /// @param Destination Where to write the bytes.
+    /// @param Text The text to write.
+    void AppendSizedString(String& Destination, const StringView Text)
+    {
+        AppendLittleEndian(Destination, Text.size(), LengthSize);
+        Destination.append(Text.data(), Text.size());
+    }
+
+    /// @brief Read a length and then that many bytes.
+    /// @param Source The payload of one record.
+    /// @param Offset Where the length is, this is moved past the text.
+    /// @return The text read.
+    [[nodiscard]]
+    String ReadSizedString(const StringView Source, String::size_type& Offset)
+    {
+        if(Source.size() - Offset < LengthSize)
+            { throw Testing::MalformedResultRecord("Result record ended in the middle of a length."); }
+        const UInt64 Length = ReadLittleEndian(Source, Offset, LengthSize);
+        if(Source.size() - Offset < Length)
+            { throw Testing::MalformedResultRecord("Result record ended in the middle of a name."); }
+        String Text( Source.substr(Offset, static_cast<String::size_type>(Length)) );
+        Offset += static_cast<String::size_type>(Length);
+        return Text;
+    }
+
+    /// @brief Put the length and type in front of a payload to make a complete record.
+    /// @param Type What kind of record this is.
+    /// @param Payload Everything after the type.
+    /// @return The record.
+    [[nodiscard]]
+    String MakeRecord(const Testing::ResultRecordType Type, const StringView Payload)
+    {
+        if(Payload.size() >= LargestRecord)
+            { throw std::length_error("Too much to fit in a single result record."); }
+        String Record;
+        Record.reserve(LengthSize + 1 + Payload.size());
+        AppendLittleEndian(Record, Payload.size() + 1, LengthSize);
+        Record.push_back( static_cast<char>(Type) );
+        Record.append(Payload.data(), Payload.size());
+        return Record;
+    }
+
+    /// @brief Turn the payload of a result record back into a TestData.
+    /// @param Payload Everything after the type.
+    /// @return The decoded result.
+    [[nodiscard]]
+    Testing::TestData DecodeResultPayload(const StringView Payload)
+    {
+        if(Payload.size() < 1 + LineNumberSize)
+            { throw Testing::MalformedResultRecord("Result record too short to hold a result."); }
+        String::size_type Offset = 0;
+        const UInt64 RawResult = ReadLittleEndian(Payload, Offset, 1);
+        if(RawResult > static_cast<UInt64>(Testing::TestResult::Highest))
+            { throw Testing::MalformedResultRecord("Result record holds an unknown test result."); }
+        const UInt64 LineNumber = ReadLittleEndian(Payload, Offset, LineNumberSize);
+
+        Testing::TestData Decoded;
+        Decoded.Results = static_cast<Testing::TestResult>(RawResult);
+        Decoded.LineNumber = static_cast<Whole>(LineNumber);
+        Decoded.TestName = ReadSizedString(Payload, Offset);
+        Decoded.FunctionName = ReadSizedString(Payload, Offset);
+        Decoded.FileName = ReadSizedString(Payload, Offset);
+        if(Payload.size() != Offset)
+            { throw Testing::MalformedResultRecord("Result record has bytes after the result."); }
+        return Decoded;
+    }
+
+    /// @brief Turn the payload of a crash record back into a CrashReport.
+    /// @param Payload Everything after the type.
+    /// @return The decoded crash.
+    [[nodiscard]]
+    Testing::CrashReport DecodeCrashPayload(const StringView Payload)
+    {
+        if(Payload.size() < SignalSize + AddressSize + LengthSize)
+            { throw Testing::MalformedResultRecord("Crash record too short to hold a crash."); }
+        String::size_type Offset = 0;
+        Testing::CrashReport Decoded;
+        Decoded.Signal = static_cast<Integer>(ReadLittleEndian(Payload, Offset, SignalSize));
+        Decoded.FaultAddress = ReadLittleEndian(Payload, Offset, AddressSize);
+        const UInt64 FrameCount = ReadLittleEndian(Payload, Offset, LengthSize);
+        for(UInt64 Count = 0; Count < FrameCount; ++Count)
+        {
+            if(Payload.size() - Offset < 2 * AddressSize)
+                { throw Testing::MalformedResultRecord("Crash record ended in the middle of a frame."); }
+            Testing::CrashFrame OneFrame;
+            OneFrame.Address = ReadLittleEndian(Payload, Offset, AddressSize);
+            OneFrame.Offset = ReadLittleEndian(Payload, Offset, AddressSize);
+            OneFrame.Symbol = ReadSizedString(Payload, Offset);
+            OneFrame.Module = ReadSizedString(Payload, Offset);
+            Decoded.Frames.push_back(std::move(OneFrame));
+        }
+        if(Payload.size() != Offset)
+            { throw Testing::MalformedResultRecord("Crash record has bytes after the frames."); }
+        return Decoded;
+    }
+}
+
+namespace Mezzanine
+{
+namespace Testing
+{
+    String EncodeResultRecord(const TestData& ToEncode)
+    {
+        String Payload;
+        Payload.reserve(1 + LineNumberSize + 3 * LengthSize +
+                        ToEncode.TestName.size() + ToEncode.FunctionName.size() + ToEncode.FileName.size());
+        AppendLittleEndian(Payload, static_cast<UInt64>(ToEncode.Results), 1);
+        AppendLittleEndian(Payload, ToEncode.LineNumber, LineNumberSize);
+        AppendSizedString(Payload, ToEncode.TestName);
+        AppendSizedString(Payload, ToEncode.FunctionName.str());
+        AppendSizedString(Payload, ToEncode.FileName.str());
+        return MakeRecord(ResultRecordType::Result, Payload);
+    }
+
+    String EncodeLogRecord(const StringView Text)
+        { return MakeRecord(ResultRecordType::Log, Text); }
+
+    String EncodeCrashRecord(const CrashReport& ToEncode)
+    {
+        String Payload;
+        AppendLittleEndian(Payload, static_cast<UInt64>(ToEncode.Signal), SignalSize);
+        AppendLittleEndian(Payload, ToEncode.FaultAddress, AddressSize);
+        AppendLittleEndian(Payload, ToEncode.Frames.size(), LengthSize);
+        for(const CrashFrame& OneFrame : ToEncode.Frames)
+        {
+            AppendLittleEndian(Payload, OneFrame.Address, AddressSize);
+            AppendLittleEndian(Payload, OneFrame.Offset, AddressSize);
+            AppendSizedString(Payload, OneFrame.Symbol);
+            AppendSizedString(Payload, OneFrame.Module);
+        }
+        return MakeRecord(ResultRecordType::Crash, Payload);
+    }
+
+    ResultRecordDecoder::ResultRecordDecoder(ResultCallback ResultHandler,
+                                             LogCallback LogHandler,
+                                             CrashCallback CrashHandler)
+        : OnResult( std::move(ResultHandler) ),
+          OnLog( std::move(LogHandler) ),
+          OnCrash( std::move(CrashHandler) )
+        {}
+
+    void ResultRecordDecoder::Decode(const StringView Bytes)
+    {
+        Unfinished.append(Bytes.data(), Bytes.size());
+
+        String::size_type RecordStart = 0;
+        while(Unfinished.size() - RecordStart >= LengthSize)
+        {
+            String::size_type Offset = RecordStart;
+            const UInt64 RecordLength = ReadLittleEndian(Unfinished, Offset, LengthSize);
+            if(0 == RecordLength || RecordLength > LargestRecord)
+                { throw MalformedResultRecord("Result record has an impossible length."); }
+            if(Unfinished.size() - Offset < RecordLength)
+                { break; } // The rest has not arrived yet.
+
+            const StringView Record( Unfinished.data() + Offset, static_cast<String::size_type>(RecordLength) );
+            const StringView Payload( Record.substr(1) );
+            switch( static_cast<ResultRecordType>(Record.front()) )
+            {
+                case ResultRecordType::Result:
+                    OnResult( DecodeResultPayload(Payload) );
+                    break;
+                case ResultRecordType::Log:
+                    if(OnLog)
+                        { OnLog(Payload); }
+                    break;
+                case ResultRecordType::Crash:
+                    if(OnCrash)
+                        { OnCrash( DecodeCrashPayload(Payload) ); }
+                    break;
+                default:
+                    throw MalformedResultRecord("Result record has an unknown type.");
+            }
+            RecordStart = Offset + static_cast<String::size_type>(RecordLength);
+        }
+        Unfinished.erase(0, RecordStart);
+    }
+
+    Boole ResultRecordDecoder::HasUnfinishedRecord() const
+        { return !Unfinished.empty(); }
+}// Testing
+}// Mezzanine
@@ -167,5 +167,16 @@ namespace Mezzanine
             return Results;
         }
 
+        Mezzanine::UInt64 StableStringHash(const Mezzanine::StringView Text, const Mezzanine::UInt64 Seed)
+        {
+            Mezzanine::UInt64 Hash{Seed}; // The FNV offset basis unless continuing an earlier hash
+            for(const Mezzanine::StringView::value_type& OneChar : Text)
+            {
+                Hash ^= static_cast<unsigned char>(OneChar);
+                Hash *= 1099511628211ULL; // FNV prime
+            }
+            return Hash;
+        }
+
     }// Testing
 }// Mezzanine
@@ -44,17 +44,142 @@
 #include "MezzTest.h"
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
+#include <deque>
 #include <iostream>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace
+{
+    using Mezzanine::String;
+    using Mezzanine::StringView;
+
+    /// @brief Every String interned so far in this process.
+    struct InternTable
+    {
+        /// @brief Lets many threads look up text already interned at once.
+        std::shared_mutex Lock;
+        /// @brief The interned Strings, a deque so they never move as more are added.
+        std::deque<String> Storage;
+        /// @brief Views into Storage, so looking up text needs no String built from it.
+        std::unordered_map<StringView, const String*> Index;
+    };
+
+    SAVE_WARNING_STATE
+    SUPPRESS_CLANG_WARNING("-Wexit-time-destructors")
+    /// @return The one InternTable for the process.
+    InternTable& GetInternTable()
+    {
+        static InternTable Table;
+        return Table;
+    }
+
+    /// @return The interned "", kept aside so default TestData never needs a lock.
+    const String& GetInternedEmpty()
+    {
+        static const String Empty;
+        return Empty;
+    }
+    RESTORE_WARNING_STATE
+
+    /// @brief Look text up in the InternTable, storing it if this is the first time any thread saw it.
+    /// @param ToIntern The text to look for, not empty.
+    /// @return The String in the table with the same text.
+    const String* FindOrStore(const StringView ToIntern)
+    {
+        InternTable& Table = GetInternTable();
+        {
+            std::shared_lock<std::shared_mutex> Reading(Table.Lock);
+            const auto Found = Table.Index.find(ToIntern);
+            if(Table.Index.end() != Found)
+                { return Found->second; }
+        }
+
+        std::unique_lock<std::shared_mutex> Writing(Table.Lock);
+        const auto Found = Table.Index.find(ToIntern); // Another thread may have stored it since we looked.
+        if(Table.Index.end() != Found)
+            { return Found->second; }
+        const String& Stored = Table.Storage.emplace_back(ToIntern);
+        Table.Index.emplace(Stored, &Stored);
+        return &Stored;
+    }
+
+    /// @brief Text one thread interned recently, found by where the text was rather than by hashing it.
+    struct RecentIntern
+    {
+        /// @brief Where the text was when it was interned, usually a __FILE__ or __FUNCTION__ literal.
+        const char* Address = nullptr;
+        /// @brief What it was interned as.
+        const String* Interned = nullptr;
+    };
+
+    /// @brief How many RecentIntern entries each thread keeps, a power of two.
+    constexpr std::size_t RecentInternCount{16};
+
+    /// @brief Find text in the InternTable, storing it if this is the first time it was seen.
+    /// @details Assertions pass the same literals over and over, so each thread remembers what it interned by the
+    /// address of the text. A hit still compares the text, because the same address can hold other text later,
+    /// but it skips hashing and the lock every thread shares.
+    /// @param ToIntern The text to look for.
+    /// @return The String in the table with the same text.
+    const String* Intern(const StringView ToIntern)
+    {
+        if(ToIntern.empty())
+            { return &GetInternedEmpty(); }
+
+        thread_local std::array<RecentIntern, RecentInternCount> Recent;
+        RecentIntern& Slot =
+            Recent[(reinterpret_cast<std::uintptr_t>(ToIntern.data()) >> 4) & (RecentInternCount - 1)];
+        if(ToIntern.data() == Slot.Address && ToIntern == *Slot.Interned)
+            { return Slot.Interned; }
+        Slot.Address = ToIntern.data();
+        Slot.Interned = FindOrStore(ToIntern);
+        return Slot.Interned;
+    }
+}
 
 namespace Mezzanine
 {
     namespace Testing
     {
+        InternedString::InternedString() noexcept
+            : Interned(&GetInternedEmpty())
+            {}
+
+        InternedString::InternedString(const StringView ToIntern)
+            : Interned(Intern(ToIntern))
+            {}
+
+        InternedString::InternedString(const String& ToIntern)
+            : Interned(Intern(ToIntern))
+            {}
+
+        InternedString::InternedString(const char* ToIntern)
+            : Interned(Intern(nullptr == ToIntern ? StringView() : StringView(ToIntern)))
+            {}
+
+        Boole operator==(const InternedString& Lhs, const String& Rhs)
+            { return Lhs.str() == Rhs; }
+
+        Boole operator==(const String& Lhs, const InternedString& Rhs)
+            { return Lhs == Rhs.str(); }
+
+        Boole operator!=(const InternedString& Lhs, const String& Rhs)
+            { return Lhs.str() != Rhs; }
+
+        Boole operator!=(const String& Lhs, const InternedString& Rhs)
+            { return Lhs != Rhs.str(); }
+
+        std::ostream& operator<<(std::ostream& Stream, const InternedString& ToStream)
+            { return Stream << ToStream.str(); }
 
         TestData::TestData(const String& Name,
                  TestResult Result,
-                 const String& FuncName,
-                 const String& File,
+                 const StringView FuncName,
+                 const StringView File,
                  Mezzanine::Whole Line)
             : TestName(Name), FunctionName(FuncName), FileName(File), LineNumber(Line), Results(Result)
         {}
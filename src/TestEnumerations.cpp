@@ -64,6 +64,7 @@ namespace Mezzanine
                 case TestResult::Skipped:           return SkippedString;
                 case TestResult::Cancelled:         return CancelledString;
                 case TestResult::NonPerformant:     return NonPerformantString;
+                case TestResult::Flaky:             return FlakyString;
                 case TestResult::Warning:           return WarningString;
                 case TestResult::Inconclusive:      return InconclusiveString;
                 case TestResult::Failed:            return FailedString;
@@ -81,6 +82,7 @@ namespace Mezzanine
                 case TestResult::Skipped:           return SkippedStringBox;
                 case TestResult::Cancelled:         return CancelledStringBox;
                 case TestResult::NonPerformant:     return NonPerformantStringBox;
+                case TestResult::Flaky:             return FlakyStringBox;
                 case TestResult::Warning:           return WarningStringBox;
                 case TestResult::Inconclusive:      return InconclusiveStringBox;
                 case TestResult::Failed:            return FailedStringBox;
@@ -136,6 +138,8 @@ namespace Mezzanine
                 case 'F':
                     if ( FailedString == Text )
                         { return TestResult::Failed;}
+                    else if ( FlakyString == Text )
+                        { return TestResult::Flaky;}
                     else
                         { throw std::invalid_argument("Cannot convert to TestResult from text(F) " + Text); }
                 case 'N':
@@ -0,0 +1,114 @@
+// © Copyright 2010 - 2021 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+
+/// @file
+/// @brief The definition of a record of how long each test group took on previous runs.
+
+#include "TestHistory.h"
+
+#include <fstream>
+#include <istream>
+#include <ostream>
+#include <sstream>
+
+namespace Mezzanine
+{
+namespace Testing
+{
+    void TestHistory::Record(const String& GroupName, const DurationType Duration)
+        { Durations[GroupName] = Duration; }
+
+    Boole TestHistory::HasDuration(const String& GroupName) const
+        { return Durations.end() != Durations.find(GroupName); }
+
+    TestHistory::DurationType TestHistory::GetDuration(const String& GroupName) const
+    {
+        StorageType::const_iterator Found = Durations.find(GroupName);
+        if(Durations.end() == Found)
+            { return DurationType{0}; }
+        return Found->second;
+    }
+
+    Whole TestHistory::size() const
+        { return Durations.size(); }
+
+    Boole TestHistory::ShouldRunBefore(const String& Left, const String& Right) const
+    {
+        const Boole LeftKnown = HasDuration(Left);
+        const Boole RightKnown = HasDuration(Right);
+        if(LeftKnown != RightKnown)
+            { return RightKnown; } // The unknown one goes first.
+        return GetDuration(Left) > GetDuration(Right);
+    }
+
+    void TestHistory::Load(std::istream& Source)
+    {
+        String OneLine;
+        while(std::getline(Source, OneLine))
+        {
+            std::istringstream LineStream(OneLine);
+            DurationType::rep Count{0};
+            String GroupName;
+            if(LineStream >> Count >> GroupName && 0 <= Count)
+                { Record(GroupName, DurationType{Count}); }
+        }
+    }
+
+    void TestHistory::Save(std::ostream& Destination) const
+    {
+        for(const StorageType::value_type& OneGroup : Durations)
+            { Destination << OneGroup.second.count() << ' ' << OneGroup.first << '\n'; }
+    }
+
+    void TestHistory::LoadFile(const String& FileName)
+    {
+        std::ifstream HistoryFile(FileName);
+        if(HistoryFile)
+            { Load(HistoryFile); }
+    }
+
+    void TestHistory::SaveFile(const String& FileName) const
+    {
+        std::ofstream HistoryFile(FileName);
+        Save(HistoryFile);
+    }
+
+}// Testing
+}// Mezzanine
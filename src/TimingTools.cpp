@@ -72,6 +72,16 @@ namespace
         Duration -= TruncateAmount;
         return Duration;
     }
+
+    /// @internal
+    /// @brief Write CPU time as milliseconds with three decimal places, which is as precise as it gets counted.
+    /// @param Time The CPU time to write.
+    /// @param Stream The place to send the milliseconds.
+    void StreamCpuTime(const microseconds Time, std::ostream& Stream)
+    {
+        const microseconds::rep Micro{ Time.count() };
+        Stream << Micro / 1000 << '.' << std::setfill('0') << std::setw(3) << Micro % 1000 << std::setfill(' ') << "ms";
+    }
 }
 
 namespace Mezzanine
@@ -92,6 +102,20 @@ namespace Mezzanine
                           << PrettyDurationString(TimingToStream.Duration);
         }
 
+        std::ostream& operator<<(std::ostream& Stream, const ResourceUsage& UsageToStream)
+        {
+            if(!UsageToStream.Measured)
+                { return Stream; }
+            Stream << "peak RSS " << UsageToStream.PeakResidentKiB << " KiB, user ";
+            StreamCpuTime(UsageToStream.UserTime, Stream);
+            Stream << ", system ";
+            StreamCpuTime(UsageToStream.SystemTime, Stream);
+            return Stream << ", faults " << UsageToStream.MajorFaults << " major "
+                          << UsageToStream.MinorFaults << " minor, switches "
+                          << UsageToStream.VoluntarySwitches << " voluntary "
+                          << UsageToStream.InvoluntarySwitches << " involuntary";
+        }
+
         Mezzanine::String PrettyDurationString(nanoseconds Duration)
         {
             std::stringstream PrettyTimeAssembler;
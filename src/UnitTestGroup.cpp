@@ -46,8 +46,10 @@
 #include "TimingTools.h"
 
 #include <algorithm>
+#include <exception>
 #include <vector>
 #include <iostream>
+#include <sstream>
 
 using std::chrono::microseconds;
 
@@ -64,15 +66,42 @@ namespace Mezzanine
         Boole UnitTestGroup::IsMultiThreadSafe() const
             { return true; }
 
+        Boole UnitTestGroup::CanRunConcurrentCopies() const
+            { return false; }
+
         Boole UnitTestGroup::IsMultiProcessSafe() const
             { return true; }
 
+        std::chrono::milliseconds UnitTestGroup::Timeout() const
+            { return std::chrono::milliseconds::zero(); }
+
         Boole UnitTestGroup::ShouldRunAutomatically() const
             { return true; }
 
         Boole UnitTestGroup::IsBenchmark() const
             { return false; }
 
+        Boole UnitTestGroup::CanCacheResults() const
+            { return ShouldRunAutomatically() && !IsBenchmark(); }
+
+        Boole UnitTestGroup::ShouldPinToCpus() const
+            { return IsBenchmark(); }
+
+        CpuListType UnitTestGroup::PinnedCpus() const
+            { return CpuListType{}; }
+
+        UInt64 UnitTestGroup::MaxAddressSpace() const
+            { return 0; }
+
+        Whole UnitTestGroup::MaxCpuSeconds() const
+            { return 0; }
+
+        Whole UnitTestGroup::MaxOpenFiles() const
+            { return 0; }
+
+        Whole UnitTestGroup::MaxAggregatedFailures() const
+            { return 10; }
+
 //////////////////////////////////////////////////////
 // MetaPolicy methods, don't override these, they use the policy methods for overidable behavior.
 
@@ -91,6 +120,162 @@ namespace Mezzanine
         Boole UnitTestGroup::ShouldRun() const
             { return ExecutionBits.ShouldExecute && !ExecutionBits.ForceSkip; }
 
+        void UnitTestGroup::SetReplayedFromCache()
+            { ExecutionBits.ReplayedFromCache = true; }
+
+        Boole UnitTestGroup::WasReplayedFromCache() const
+            { return ExecutionBits.ReplayedFromCache; }
+
+        void UnitTestGroup::SetRepeats(const Whole Count, const Boole UntilFailure, const Boole Concurrently,
+                                       const Whole Jobs)
+        {
+            ExecutionBits.RepeatCount = std::max(Count, Whole{1});
+            ExecutionBits.RepeatUntilFailure = UntilFailure;
+            ExecutionBits.RepeatConcurrently = Concurrently;
+            ExecutionBits.ConcurrentJobs = std::max(Jobs, Whole{1});
+            if(IsRepeating())
+                { StartTallyingResults(); }
+        }
+
+        Boole UnitTestGroup::IsRepeating() const
+            { return 1 < ExecutionBits.RepeatCount || ExecutionBits.RepeatUntilFailure; }
+
+        void UnitTestGroup::StartTallyingResults()
+        {
+            std::lock_guard<std::mutex> Lock(RecordLock);
+            if(ExecutionBits.TallyResults)
+                { return; }
+            ExecutionBits.TallyResults = true;
+            for(const TestData& OneResult : TestDataStorage)
+            {
+                RepeatTally& Tally = RepeatTallies[OneResult.TestName];
+                Tally.Runs++;
+                if(TestResult::Warning <= OneResult.Results)
+                    { Tally.Failures++; }
+            }
+            for(AggregatedState& OneState : AggregatedAssertions)
+            {
+                // Counted above by their one stored result, only runs after this are tallied by TallyAggregatedRun.
+                const Whole Failures{ OneState.Assertion.Failures };
+                OneState.RunsAtLastTally = OneState.Passes.load(std::memory_order_relaxed) + Failures;
+                OneState.FailuresAtLastTally = Failures;
+            }
+        }
+
+        void UnitTestGroup::ClearResults()
+        {
+            std::lock_guard<std::mutex> Lock(RecordLock);
+            TestDataStorage.clear();
+            TestNameIndex.clear();
+            RepeatTallies.clear();
+            AggregatedAssertions.clear();
+            AggregatedSites.clear();
+            AggregateGeneration = NewAggregateGeneration();
+            CapturedOutput.clear();
+            CapturedErrors.clear();
+            TestLog.str(String{});
+            TestLog.clear();
+            ExecutionBits.TallyResults = IsRepeating();
+        }
+
+        void UnitTestGroup::Execute()
+        {
+            try {
+                if(!IsRepeating())
+                {
+                    (*this)();
+                    TallyAggregatedRun();
+                    FinishAggregatedAssertions();
+                    return;
+                }
+
+                const Boole Concurrently = ExecutionBits.RepeatConcurrently && CanRunConcurrentCopies() &&
+                                           1 < ExecutionBits.RepeatCount;
+                do
+                {
+                    if(Concurrently)
+                    {
+                        RunConcurrentCopies(ExecutionBits.RepeatCount);
+                        TallyAggregatedRun(); // Copies running at once cannot be told apart, so they count as one.
+                    } else {
+                        for(Whole Run = 0; Run < ExecutionBits.RepeatCount && !ShouldStopRepeating(); ++Run)
+                        {
+                            (*this)();
+                            TallyAggregatedRun();
+                        }
+                    }
+                } while(ExecutionBits.RepeatUntilFailure && !ShouldStopRepeating());
+            } catch(...) {
+                TallyAggregatedRun(); // What they did before the throw still counts.
+                FinishAggregatedAssertions();
+                throw;
+            }
+            FinishAggregatedAssertions();
+        }
+
+        void UnitTestGroup::TallyAggregatedRun()
+        {
+            std::lock_guard<std::mutex> Lock(RecordLock);
+            if(!ExecutionBits.TallyResults)
+                { return; }
+            for(AggregatedState& OneState : AggregatedAssertions)
+            {
+                const Whole Failures{ OneState.Assertion.Failures };
+                const Whole Runs{ OneState.Passes.load(std::memory_order_relaxed) + Failures };
+                if(OneState.RunsAtLastTally == Runs)
+                    { continue; } // Did not run this time.
+                RepeatTally& Tally = RepeatTallies[OneState.Assertion.TestName];
+                Tally.Runs++;
+                if(OneState.FailuresAtLastTally != Failures)
+                    { Tally.Failures++; }
+                OneState.RunsAtLastTally = Runs;
+                OneState.FailuresAtLastTally = Failures;
+            }
+        }
+
+        void UnitTestGroup::FinishAggregatedAssertions()
+        {
+            const Boole Emitting{ EmitIntermediaryTestResults() };
+            std::lock_guard<std::mutex> Lock(RecordLock);
+            for(AggregatedState& OneState : AggregatedAssertions)
+            {
+                const AggregatedAssertion& OneAssertion = OneState.Assertion;
+                const TestData& Stored = TestDataStorage[OneAssertion.StorageIndex];
+                if(ResultListener && (!OneState.ListenerTold || OneState.ListenerToldResult != Stored.Results))
+                    { ResultListener(Stored); }
+                OneState.ListenerTold = true;
+                OneState.ListenerToldResult = Stored.Results;
+                if(!Emitting)
+                    { continue; }
+                TestLog << "Aggregated " << OneAssertion.TestName << ": "
+                        << OneState.Passes.load(std::memory_order_relaxed) << " passed, "
+                        << OneAssertion.Failures << " failed";
+                if(!OneAssertion.FailedIterations.empty())
+                {
+                    TestLog << ", first failing iterations";
+                    for(const Whole Iteration : OneAssertion.FailedIterations)
+                        { TestLog << ' ' << Iteration; }
+                }
+                TestLog << ".\n";
+            }
+        }
+
+        void UnitTestGroup::RunConcurrentCopies(const Whole Copies)
+        {
+            // The thread calling Run is one of the pool's, so no more threads than jobs ever run copies.
+            WorkStealingPool Copying(std::min(Copies, ExecutionBits.ConcurrentJobs));
+            for(Whole Copy = 0; Copy < Copies; ++Copy)
+                { Copying.AddWork([this]() { (*this)(); }); }
+            Copying.Run();
+        }
+
+        Boole UnitTestGroup::ShouldStopRepeating() const
+        {
+            if(IsCancelled())
+                { return true; }
+            return ExecutionBits.RepeatUntilFailure && TestResult::Warning <= GetWorstResults();
+        }
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Make all UnitTestGroups look like a container of TestDatas
         UnitTestGroup::iterator UnitTestGroup::begin()
@@ -113,30 +298,175 @@ namespace Mezzanine
         
         void UnitTestGroup::AddTestResultWithoutName(TestData&& CurrentTest)
         {
-            std::sort(TestDataStorage.begin(), TestDataStorage.end());
-            if(std::binary_search(TestDataStorage.begin(), TestDataStorage.end(), CurrentTest))
+            const Boole Passing{ TestResult::Warning > CurrentTest.Results };
+            StoreResult(std::move(CurrentTest),
+                        EmitIntermediaryTestResults() && !(ExecutionBits.TallyResults && Passing));
+        }
+
+        void UnitTestGroup::StoreTestResultWithoutName(TestData&& CurrentTest)
+            { StoreResult(std::move(CurrentTest), false); }
+
+        void UnitTestGroup::StoreResult(TestData&& CurrentTest, const Boole LogResult)
+        {
+            std::lock_guard<std::mutex> Lock(RecordLock);
+            StoreResultWhileLocked(std::move(CurrentTest), LogResult);
+        }
+
+        UnitTestGroup::TestDataStorageType::size_type
+            UnitTestGroup::StoreResultWhileLocked(TestData&& CurrentTest, const Boole LogResult,
+                                                  const Boole Aggregated)
+        {
+            if(TestNameIndex.size() != TestDataStorage.size())
             {
-                throw std::runtime_error("Multiple tests have the same name, but cannot: " + CurrentTest.TestName);
-            } else {
-                if(EmitIntermediaryTestResults()) { TestLog << CurrentTest; }
-                TestDataStorage.emplace_back(CurrentTest);
+                for(TestDataStorageType::size_type Index = 0; Index < TestDataStorage.size(); Index++)
+                    { TestNameIndex.emplace(std::hash<String>{}(TestDataStorage[Index].TestName), Index); }
             }
+
+            const std::size_t NameHash{ std::hash<String>{}(CurrentTest.TestName) };
+            const TestDataStorageType::size_type Existing{ FindStoredResult(CurrentTest.TestName, NameHash) };
+            const Boole SameName{ TestDataStorage.size() != Existing };
+            if(SameName && !ExecutionBits.TallyResults)
+                { throw std::runtime_error("Multiple tests have the same name, but cannot: " + CurrentTest.TestName); }
+
+            if(ExecutionBits.TallyResults && !Aggregated)
+            {
+                RepeatTally& Tally = RepeatTallies[CurrentTest.TestName];
+                Tally.Runs++;
+                if(TestResult::Warning <= CurrentTest.Results)
+                    { Tally.Failures++; }
+            }
+            if(!Aggregated && ResultListener)
+                { ResultListener(CurrentTest); }
+            if(LogResult)
+                { TestLog << CurrentTest; }
+
+            if(!SameName)
+            {
+                TestNameIndex.emplace(NameHash, TestDataStorage.size());
+                TestDataStorage.emplace_back(std::move(CurrentTest));
+                return TestDataStorage.size() - 1;
+            }
+            TestData& Stored = TestDataStorage[Existing];
+            if(Stored.Results < CurrentTest.Results)
+                { Stored = std::move(CurrentTest); } // Keep the worst, and where it happened.
+            return Existing;
         }
 
+        UnitTestGroup::TestDataStorageType::size_type
+            UnitTestGroup::FindStoredResult(const StringView TestName, const std::size_t NameHash) const
+        {
+            const auto Candidates = TestNameIndex.equal_range(NameHash);
+            for(auto Candidate = Candidates.first; Candidate != Candidates.second; ++Candidate)
+            {
+                if(TestName == StringView(TestDataStorage[Candidate->second].TestName))
+                    { return Candidate->second; }
+            }
+            return TestDataStorage.size();
+        }
+
+        void UnitTestGroup::SetResultListener(ResultListenerType Listener)
+            { ResultListener = std::move(Listener); }
+
+        void UnitTestGroup::SetCancellationToken(CancellationToken Token)
+            { StopToken = std::move(Token); }
+
+        CancellationToken UnitTestGroup::GetCancellationToken() const
+            { return StopToken; }
+
+        Boole UnitTestGroup::IsCancelled() const
+            { return StopToken.IsCancelled(); }
+
         void UnitTestGroup::AddTestResult(TestData&& CurrentTest)
         {
-            CurrentTest.TestName = Name() + "::" + CurrentTest.TestName;
+            CurrentTest.TestName.insert(0, GetNamePrefix());
             AddTestResultWithoutName(std::move(CurrentTest));
         }
 
+        void UnitTestGroup::ReleaseNameIndex()
+        {
+            std::lock_guard<std::mutex> Lock(RecordLock);
+            TestNameIndex = decltype(TestNameIndex){}; // Clearing would keep the buckets.
+        }
+
+        const String& UnitTestGroup::GetNamePrefix() const
+        {
+            std::call_once(NamePrefixFound, [this]{ NamePrefix = Name() + "::"; });
+            return NamePrefix;
+        }
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Other useful stuff.
 
         TestResult UnitTestGroup::GetWorstResults() const
-            { return Mezzanine::Testing::GetWorstResults(TestDataStorage); }
+        {
+            std::lock_guard<std::mutex> Lock(RecordLock);
+            return Mezzanine::Testing::GetWorstResults(TestDataStorage);
+        }
 
         String UnitTestGroup::GetTestLog() const
-            { return TestLog.str(); }
+        {
+            std::lock_guard<std::mutex> Lock(RecordLock);
+            return TestLog.str();
+        }
+
+        void UnitTestGroup::AppendTestLog(const StringView Text)
+        {
+            std::lock_guard<std::mutex> Lock(RecordLock);
+            TestLog.write(Text.data(), static_cast<std::streamsize>(Text.size()));
+        }
+
+        void UnitTestGroup::AppendCapturedOutput(const StringView Output, const StringView Errors)
+        {
+            std::lock_guard<std::mutex> Lock(RecordLock);
+            auto Capture = [this](const StringView Printed, String& Captured, const StringView Stream)
+            {
+                if(Printed.empty())
+                    { return; }
+                Captured.append(Printed.data(), Printed.size());
+                if('\n' != Captured.back())
+                    { Captured.push_back('\n'); }
+                TestLog << Stream << " from the process running " << Name() << ":\n" << Printed << '\n';
+            };
+            Capture(Output, CapturedOutput, "Standard output");
+            Capture(Errors, CapturedErrors, "Standard error");
+        }
+
+        String UnitTestGroup::GetCapturedOutput() const
+        {
+            std::lock_guard<std::mutex> Lock(RecordLock);
+            return CapturedOutput;
+        }
+
+        String UnitTestGroup::GetCapturedErrors() const
+        {
+            std::lock_guard<std::mutex> Lock(RecordLock);
+            return CapturedErrors;
+        }
+
+        UnitTestGroup::RepeatTallyStorageType UnitTestGroup::GetRepeatTallies() const
+        {
+            std::lock_guard<std::mutex> Lock(RecordLock);
+            return RepeatTallies;
+        }
+
+        UnitTestGroup::AggregatedAssertionStorageType UnitTestGroup::GetAggregatedAssertions() const
+        {
+            std::lock_guard<std::mutex> Lock(RecordLock);
+            AggregatedAssertionStorageType Results;
+            Results.reserve(AggregatedAssertions.size());
+            for(const AggregatedState& OneState : AggregatedAssertions)
+            {
+                Results.push_back(OneState.Assertion);
+                Results.back().Passes = OneState.Passes.load(std::memory_order_relaxed);
+            }
+            return Results;
+        }
+
+        Whole UnitTestGroup::NewAggregateGeneration()
+        {
+            static std::atomic<Whole> LastGeneration{0};
+            return ++LastGeneration;
+        }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Test Macro Functions Backing
@@ -146,6 +476,14 @@ namespace Mezzanine
                                  const String& FuncName,
                                  const String& File,
                                  Whole Line )
+            { return TestAt(TestName, TestCondition, IfFalse, IfTrue, FuncName, File, Line); }
+
+        TestResult UnitTestGroup::TestAt(const String& TestName, bool TestCondition,
+                                         TestResult IfFalse,
+                                         TestResult IfTrue,
+                                         const StringView FuncName,
+                                         const StringView File,
+                                         Whole Line )
         {
             TestResult Result;
             if(TestCondition)
@@ -158,10 +496,73 @@ namespace Mezzanine
             return Result;
         }
 
+        Boole UnitTestGroup::CountAggregatedPass(AggregatedSite& Site, const char* File, const Whole Line)
+        {
+            std::lock_guard<std::mutex> Lock(RecordLock);
+            const auto Found = AggregatedSites.find({File, Line});
+            if(AggregatedSites.end() == Found)
+                { return false; }
+            std::atomic<Whole>& Passes = AggregatedAssertions[Found->second].Passes;
+            Site = AggregatedSite{ this, AggregateGeneration, &Passes };
+            Passes.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        TestResult UnitTestGroup::RecordAggregatedResult(AggregatedSite& Site,
+                                                         const String& TestName,
+                                                         bool TestCondition,
+                                                         TestResult IfFalse,
+                                                         const char* FuncName,
+                                                         const char* File,
+                                                         Whole Line)
+        {
+            const TestResult Result{ TestCondition ? TestResult::Success : IfFalse };
+            const Boole Emitting{ EmitIntermediaryTestResults() };
+            const Whole FailuresKept{ MaxAggregatedFailures() };
+            std::lock_guard<std::mutex> Lock(RecordLock);
+
+            auto Found = AggregatedSites.find({File, Line});
+            if(AggregatedSites.end() == Found)
+            {
+                // Tallied by TallyAggregatedRun and told to the listener once it is final, in
+                // FinishAggregatedAssertions.
+                const TestDataStorageType::size_type Stored{ StoreResultWhileLocked(
+                    TestData(GetNamePrefix() + TestName, Result, FuncName, File, Line), false, true) };
+                Found = AggregatedSites.emplace(std::make_pair(File, Line), AggregatedAssertions.size()).first;
+                AggregatedState& FirstRun = AggregatedAssertions.emplace_back();
+                FirstRun.Assertion.TestName = TestDataStorage[Stored].TestName;
+                FirstRun.Assertion.StorageIndex = Stored;
+            }
+
+            AggregatedState& State = AggregatedAssertions[Found->second];
+            Site = AggregatedSite{ this, AggregateGeneration, &State.Passes };
+            if(TestCondition)
+            {
+                State.Passes.fetch_add(1, std::memory_order_relaxed);
+                return Result;
+            }
+
+            AggregatedAssertion& Aggregate = State.Assertion;
+            if(Aggregate.FailedIterations.size() < FailuresKept)
+            {
+                const Whole Iteration{ State.Passes.load(std::memory_order_relaxed) + Aggregate.Failures };
+                Aggregate.FailedIterations.push_back(Iteration);
+                if(Emitting)
+                    { TestLog << "Test - " << Aggregate.TestName << " failed on iteration " << Iteration << ".\n"; }
+            }
+            Aggregate.Failures++;
+
+            // Later failures only make the one stored result worse.
+            TestData& Stored = TestDataStorage[Aggregate.StorageIndex];
+            if(Stored.Results < Result)
+                { Stored.Results = Result; }
+            return Result;
+        }
+
         void UnitTestGroup::TestNoThrow(const String& TestName,
                                         std::function<void ()> TestCallable,
                                         TestResult IfFalse, TestResult IfTrue,
-                                        const String& FuncName, const String& File, Whole Line)
+                                        const StringView FuncName, const StringView File, Whole Line)
         {
             Boole Passed{false};
             try
@@ -169,14 +570,14 @@ namespace Mezzanine
             catch (const std::exception& e)
             {
                 if(EmitIntermediaryTestResults())
-                    { TestLog << "Caught Unexpected Exception: " << e.what() << std::endl; }
+                    { AppendTestLog(String("Caught Unexpected Exception: ") + e.what() + "\n"); }
             }
             catch (...)
             {
                 if(EmitIntermediaryTestResults())
-                    { TestLog << "Caught Unexpected Exception not derived from std::expection." << std::endl; }
+                    { AppendTestLog("Caught Unexpected Exception not derived from std::expection.\n"); }
             }
-            Test(TestName, Passed, IfFalse, IfTrue, FuncName, File, Line);
+            TestAt(TestName, Passed, IfFalse, IfTrue, FuncName, File, Line);
         }
 
         void UnitTestGroup::TestTimed(const String& TestName,
@@ -184,18 +585,20 @@ namespace Mezzanine
                                       std::chrono::microseconds MaxVariance,
                                       std::function<void ()> TestCallable,
                                       TestResult IfFalse, TestResult IfTrue,
-                                      const String& FuncName, const String& File, Whole Line)
+                                      const StringView FuncName, const StringView File, Whole Line)
         {
            TestTimer TestDuration;
            TestCallable();
            std::chrono::microseconds TimeTaken{std::chrono::duration_cast<microseconds>(TestDuration.GetLength())};
            Boole Passed{TimeTaken-MaxVariance<Expected && Expected<TimeTaken+MaxVariance};
-           TestResult Result{Test(TestName, Passed, IfFalse, IfTrue, FuncName, File, Line)};
+           TestResult Result{TestAt(TestName, Passed, IfFalse, IfTrue, FuncName, File, Line)};
            if(EmitIntermediaryTestResults() && Mezzanine::Testing::TestResult::Success != Result)
            {
-               TestLog << "Expected test to take " << Expected.count()
+               std::stringstream Message;
+               Message << "Expected test to take " << Expected.count()
                        << "µs with a variance of " << MaxVariance.count()
                        << "µs, but it actually took " << TimeTaken.count() << "µs."<< std::endl;
+               AppendTestLog(Message.str());
            }
         }
 
@@ -203,21 +606,25 @@ namespace Mezzanine
                                            std::chrono::microseconds MaxAcceptable,
                                            std::function<void ()> TestCallable,
                                            TestResult IfFalse, TestResult IfTrue,
-                                           const String& FuncName, const String& File, Whole Line)
+                                           const StringView FuncName, const StringView File, Whole Line)
         {
            TestTimer TestDuration;
            TestCallable();
            microseconds TimeTaken{std::chrono::duration_cast<microseconds>(TestDuration.GetLength())};
-           TestResult Result{Test(TestName, TimeTaken < MaxAcceptable, IfFalse, IfTrue, FuncName, File, Line)};
+           TestResult Result{TestAt(TestName, TimeTaken < MaxAcceptable, IfFalse, IfTrue, FuncName, File, Line)};
            if(EmitIntermediaryTestResults() && Mezzanine::Testing::TestResult::Success != Result)
            {
-               TestLog << "Expected test to take under " << MaxAcceptable.count()
+               std::stringstream Message;
+               Message << "Expected test to take under " << MaxAcceptable.count()
                        << "µs, but it actually took " << TimeTaken.count() << "µs."<< std::endl;
+               AppendTestLog(Message.str());
            }
         }
 
         TestResult GetWorstResults(const UnitTestGroup::TestDataStorageType& ToSearch)
         {
+            if(ToSearch.empty())
+                { return TestResult::Success; } // Nothing ran, so nothing went wrong. A shard can be empty.
             return std::max_element(
                 ToSearch.cbegin(), ToSearch.cend(),
                 [](const auto& Left, const auto& Right)
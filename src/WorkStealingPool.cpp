@@ -0,0 +1,178 @@
+// © Copyright 2010 - 2021 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+
+/// @file
+/// @brief The definition of a small fixed size thread pool used to run test groups in parallel.
+
+#include "WorkStealingPool.h"
+
+#include <chrono>
+#include <thread>
+
+namespace
+{
+    /// @brief The pool the current thread is working for, if any.
+    thread_local const Mezzanine::Testing::WorkStealingPool* CurrentPool = nullptr;
+    /// @brief Which queue in CurrentPool belongs to this thread.
+    thread_local Mezzanine::Whole CurrentWorkerIndex = 0;
+}
+
+namespace Mezzanine
+{
+    namespace Testing
+    {
+        WorkStealingPool::WorkStealingPool(const Whole ThreadCount)
+        {
+            const Whole ActualCount = ThreadCount ? ThreadCount : 1;
+            Queues.reserve(ActualCount);
+            for(Whole Counter = 0; Counter < ActualCount; Counter++)
+                { Queues.emplace_back(std::make_unique<WorkQueue>()); }
+        }
+
+        Boole WorkStealingPool::TryTake(const Whole QueueIndex, WorkType& Output)
+        {
+            WorkQueue& Victim = *Queues[QueueIndex];
+            std::lock_guard<std::mutex> Lock(Victim.QueueLock);
+            if(Victim.Work.empty())
+                { return false; }
+            Output = std::move(Victim.Work.front());
+            Victim.Work.pop_front();
+            Queued--;
+            return true;
+        }
+
+        Boole WorkStealingPool::TryTakeOrSteal(const Whole WorkerIndex, WorkType& Output)
+        {
+            for(Whole Offset = 0; Offset < Queues.size(); Offset++)
+            {
+                if(TryTake((WorkerIndex + Offset) % Queues.size(), Output))
+                    { return true; }
+            }
+            return false;
+        }
+
+        void WorkStealingPool::WorkerLoop(const Whole WorkerIndex)
+        {
+            CurrentPool = this;
+            CurrentWorkerIndex = WorkerIndex;
+
+            WorkType Work;
+            while(true)
+            {
+                if(TryTakeOrSteal(WorkerIndex, Work))
+                {
+                    try
+                        { Work(); }
+                    catch(...)
+                    {
+                        std::lock_guard<std::mutex> Lock(FailureLock);
+                        if(!FirstFailure)
+                            { FirstFailure = std::current_exception(); }
+                    }
+                    Work = nullptr;
+
+                    if(0 == --Outstanding)
+                    {
+                        std::lock_guard<std::mutex> Lock(IdleLock);
+                        IdleSignal.notify_all();
+                    }
+                    continue;
+                }
+
+                // Nothing to do, but work still executing might add more, so wait until either happens.
+                std::unique_lock<std::mutex> Lock(IdleLock);
+                if(0 == Outstanding)
+                    { break; }
+                IdleSignal.wait_for(Lock, std::chrono::milliseconds(10),
+                                    [this]{ return 0 != Queued || 0 == Outstanding; });
+            }
+
+            CurrentPool = nullptr;
+        }
+
+        Whole WorkStealingPool::GetThreadCount() const
+            { return Queues.size(); }
+
+        void WorkStealingPool::AddWork(WorkType NewWork)
+        {
+            const Whole QueueIndex = (this == CurrentPool) ? CurrentWorkerIndex : NextQueue++ % Queues.size();
+
+            Outstanding++;
+            {
+                WorkQueue& Destination = *Queues[QueueIndex];
+                std::lock_guard<std::mutex> Lock(Destination.QueueLock);
+                Destination.Work.emplace_back(std::move(NewWork));
+                Queued++;
+            }
+
+            std::lock_guard<std::mutex> Lock(IdleLock);
+            IdleSignal.notify_one();
+        }
+
+        void WorkStealingPool::Run()
+        {
+            std::vector<std::thread> Workers;
+            Workers.reserve(Queues.size() - 1);
+            for(Whole WorkerIndex = 1; WorkerIndex < Queues.size(); WorkerIndex++)
+                { Workers.emplace_back(&WorkStealingPool::WorkerLoop, this, WorkerIndex); }
+
+            WorkerLoop(0);
+            for(std::thread& OneWorker : Workers)
+                { OneWorker.join(); }
+
+            if(FirstFailure)
+            {
+                std::exception_ptr ToRethrow = FirstFailure;
+                FirstFailure = nullptr;
+                std::rethrow_exception(ToRethrow);
+            }
+        }
+
+        Whole WorkStealingPool::GetCurrentWorkerIndex()
+            { return nullptr == CurrentPool ? 0 : CurrentWorkerIndex; }
+
+        Whole WorkStealingPool::GetDefaultThreadCount()
+        {
+            const Whole HardwareThreads = std::thread::hardware_concurrency();
+            return HardwareThreads ? HardwareThreads : 1;
+        }
+
+    }// Testing
+}// Mezzanine
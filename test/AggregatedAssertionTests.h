@@ -0,0 +1,212 @@
+// © Copyright 2010 - 2021 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_AggregatedAssertionTests_h
+#define Mezz_Test_AggregatedAssertionTests_h
+
+/// @file
+/// @brief Tests for folding assertions made in loops into one result each.
+
+// Add other headers you need here
+#include "MezzTest.h"
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <vector>
+
+/// @brief A group with a loop full of assertions, some of which fail.
+class AggregatedProbeTestGroup : public Mezzanine::Testing::UnitTestGroup
+{
+public:
+    /// @brief How many names were made, to check passes do not make them.
+    Mezzanine::Whole NamesMade = 0;
+
+    virtual void operator()() override
+    {
+        for(Mezzanine::Whole Iteration = 0; Iteration < 1000; Iteration++)
+        {
+            TEST_AGGREGATED( (NamesMade++, "Looped" + std::to_string(Iteration)), 7 != Iteration % 100)
+            TEST_AGGREGATED("AlwaysPasses", true)
+        }
+    }
+    virtual Mezzanine::String Name() const override
+        { return "AggregatedProbe"; }
+    virtual Mezzanine::Whole MaxAggregatedFailures() const override
+        { return 3; }
+};
+
+/// @brief A group run in its own process whose loop passes a few times before it fails.
+class IsolatedAggregatedProbeTestGroup : public Mezzanine::Testing::UnitTestGroup
+{
+public:
+    virtual void operator()() override
+    {
+        for(Mezzanine::Whole Iteration = 0; Iteration < 10; Iteration++)
+            { TEST_AGGREGATED("Loop", 3 != Iteration) }
+        TEST("After", true)
+    }
+    virtual Mezzanine::String Name() const override
+        { return "IsolatedAggregatedProbe"; }
+    virtual Mezzanine::Boole IsMultiThreadSafe() const override
+        { return false; }
+};
+
+/// @brief A group whose loop fails during its first few runs and passes after, like a flaky test being retried.
+class RetriedAggregatedProbeTestGroup : public Mezzanine::Testing::UnitTestGroup
+{
+public:
+    /// @brief How many runs fail before they start passing.
+    Mezzanine::Whole FailingRuns;
+    /// @brief How many times this ran.
+    Mezzanine::Whole Runs = 0;
+
+    explicit RetriedAggregatedProbeTestGroup(const Mezzanine::Whole Failing) :
+        FailingRuns(Failing)
+        {}
+
+    virtual void operator()() override
+    {
+        Runs++;
+        for(Mezzanine::Whole Iteration = 0; Iteration < 10; Iteration++)
+            { TEST_AGGREGATED("Loop", FailingRuns < Runs || 2 != Iteration) }
+    }
+    virtual Mezzanine::String Name() const override
+        { return "RetriedAggregatedProbe"; }
+    virtual Mezzanine::Boole EmitIntermediaryTestResults() const override
+        { return false; }
+};
+
+AUTOMATIC_TEST_GROUP(AggregatedAssertionTests, AggregatedAssertion)
+{
+    using Mezzanine::String;
+    using Mezzanine::Whole;
+    using Mezzanine::Testing::TestData;
+    using Mezzanine::Testing::TestResult;
+    using Mezzanine::Testing::UnitTestGroup;
+
+    AggregatedProbeTestGroup Probe;
+    Probe.Execute();
+
+    TEST_EQUAL("OneResultPerLine", std::distance(Probe.begin(), Probe.end()), 2)
+    TEST_EQUAL("NamedOnFirstRun", String("AggregatedProbe::Looped0"), Probe.begin()->TestName)
+    TEST_EQUAL("FailuresWorsenResult", TestResult::Failed, Probe.begin()->Results)
+    TEST_EQUAL("PassesStaySuccess", TestResult::Success, std::next(Probe.begin())->Results)
+    TEST_EQUAL("NamesOnlyForFirstAndFailures", Whole{11}, Probe.NamesMade)
+
+    const UnitTestGroup::AggregatedAssertionStorageType Aggregates{ Probe.GetAggregatedAssertions() };
+    TEST_EQUAL("OneAggregatePerLine", size_t{2}, Aggregates.size())
+    TEST_EQUAL("CountsPasses", Whole{990}, Aggregates.at(0).Passes)
+    TEST_EQUAL("CountsFailures", Whole{10}, Aggregates.at(0).Failures)
+    TEST("KeepsFirstFailures", (std::vector<Whole>{7, 107, 207}) == Aggregates.at(0).FailedIterations)
+    TEST_EQUAL("CountsEveryPass", Whole{1000}, Aggregates.at(1).Passes)
+
+    const String Log{ Probe.GetTestLog() };
+    TEST_STRING_CONTAINS("LogsFirstFailures", String("AggregatedProbe::Looped0 failed on iteration 207."), Log)
+    TEST("LogsOnlyFirstFailures", String::npos == Log.find("failed on iteration 307"))
+    TEST_STRING_CONTAINS("LogsCounts",
+                         String("Aggregated AggregatedProbe::Looped0: 990 passed, 10 failed, "
+                                "first failing iterations 7 107 207."), Log)
+
+    Probe.ClearResults();
+    TEST("ClearForgetsAggregates", Probe.GetAggregatedAssertions().empty())
+    TEST_NO_THROW("ClearAllowsRunningAgain", [&]{ Probe.Execute(); })
+    TEST_EQUAL("RunAgainCountsAfresh", Whole{990}, Probe.GetAggregatedAssertions().at(0).Passes)
+
+    // A child process sends each aggregated result once, with the result it ended on, when the group is done.
+    IsolatedAggregatedProbeTestGroup Child;
+    String Channel;
+    std::vector<TestData> Sent;
+    Mezzanine::Testing::ResultRecordDecoder Counter([&Sent](TestData&& OneResult)
+        { Sent.push_back(std::move(OneResult)); });
+    Mezzanine::Testing::RunAndSendResultRecords(Child, [&](const Mezzanine::StringView Bytes)
+        { Channel.append(Bytes); Counter.Decode(Bytes); });
+    TEST_EQUAL("Isolated::OneRecordPerName", size_t{2}, Sent.size())
+    TEST("Isolated::SentAfterLoopEnds", 2 == Sent.size() && String("IsolatedAggregatedProbe::After") ==
+         Sent.front().TestName && TestResult::Failed == Sent.back().Results)
+
+    IsolatedAggregatedProbeTestGroup Parent;
+    TEST_NO_THROW("Isolated::ReadWithoutRepeatedName",
+                  [&]{ Mezzanine::Testing::ReadResultRecordsInto(Parent)(Channel); })
+    const std::vector<TestData> Read(Parent.begin(), Parent.end());
+    TEST_EQUAL("Isolated::ResultCount", size_t{2}, Read.size())
+    TEST("Isolated::LoopFailed", std::any_of(Read.begin(), Read.end(), [](const TestData& OneResult)
+         { return String("SubProcess::IsolatedAggregatedProbe::Loop") == OneResult.TestName &&
+                  TestResult::Failed == OneResult.Results; }))
+    TEST("Isolated::AfterPassed", std::any_of(Read.begin(), Read.end(), [](const TestData& OneResult)
+         { return String("SubProcess::IsolatedAggregatedProbe::After") == OneResult.TestName &&
+                  TestResult::Success == OneResult.Results; }))
+
+    // Retried in this process, each run of the group tallies the aggregate once, and failures are heard once.
+    {
+        using Mezzanine::Testing::PrepareRetry;
+        using Mezzanine::Testing::RecordFlakyResults;
+        Mezzanine::Testing::CoreTestGroup NoGroups;
+        Mezzanine::Testing::ParsedCommandLineArgs Options(NoGroups);
+        Options.RetryCount = 2;
+        Whole FailuresHeard{0};
+        auto CountFailures = [&FailuresHeard](const TestData& OneResult)
+            { FailuresHeard += TestResult::Warning <= OneResult.Results; };
+
+        RetriedAggregatedProbeTestGroup Flaky(1);
+        Flaky.SetResultListener(CountFailures);
+        Flaky.Execute();
+        TEST("Retry::FailureRetried", PrepareRetry(Options, Flaky, 0))
+        Flaky.Execute();
+        TEST("Retry::StopsOncePassing", !PrepareRetry(Options, Flaky, 1))
+        RecordFlakyResults(Flaky, 1);
+        TEST_EQUAL("Retry::PassedOnRetryIsFlaky", TestResult::Flaky, Flaky.GetWorstResults())
+        TEST_EQUAL("Retry::FlakyFailureHeardOnce", Whole{1}, FailuresHeard)
+
+        FailuresHeard = 0;
+        RetriedAggregatedProbeTestGroup Broken(3);
+        Broken.SetResultListener(CountFailures);
+        Broken.Execute();
+        TEST("Retry::BrokenRetried", PrepareRetry(Options, Broken, 0))
+        Broken.Execute();
+        TEST("Retry::BrokenRetriedAgain", PrepareRetry(Options, Broken, 1))
+        Broken.Execute();
+        TEST("Retry::StopsAtLimit", !PrepareRetry(Options, Broken, 2))
+        RecordFlakyResults(Broken, 2);
+        TEST_EQUAL("Retry::AlwaysFailingStaysFailed", TestResult::Failed, Broken.GetWorstResults())
+        TEST_EQUAL("Retry::BrokenFailureHeardOnce", Whole{1}, FailuresHeard)
+    }
+}
+
+#endif
@@ -0,0 +1,120 @@
+// © Copyright 2010 - 2021 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_CancellationTokenTests_h
+#define Mezz_Test_CancellationTokenTests_h
+
+/// @file
+/// @brief Tests for the shared flag used to stop a run early.
+
+// Add other headers you need here
+#include "MezzTest.h"
+
+#include <thread>
+
+using Mezzanine::Testing::CancellationToken;
+using Mezzanine::Testing::TestData;
+using Mezzanine::Testing::TestResult;
+
+/// @brief A group that is only ever given results by hand, so failures can be counted.
+AUTOMATIC_TEST_GROUP(CancellationProbeTests, CancellationProbe)
+{}
+
+AUTOMATIC_TEST_GROUP(CancellationTokenTests, CancellationToken)
+{
+    {
+        CancellationToken Original;
+        const CancellationToken Copy{Original};
+        const CancellationToken Unrelated;
+        TEST("Token::StartsUncancelled", !Original.IsCancelled())
+
+        Copy.Cancel();
+        TEST("Token::CopiesShare", Original.IsCancelled())
+        TEST("Token::OthersUnaffected", !Unrelated.IsCancelled())
+
+        CancellationToken Reassigned{Unrelated};
+        Reassigned = Original;
+        TEST("Token::AssignmentShares", Reassigned.IsCancelled())
+    }
+
+    {
+        const CancellationToken FromThread;
+        std::thread Canceller([FromThread]{ FromThread.Cancel(); });
+        Canceller.join();
+        TEST("Token::OtherThreads", FromThread.IsCancelled())
+    }
+
+    {
+        Mezzanine::Testing::CoreTestGroup FakeTestGroup;
+        CancellationProbeTests Probe;
+        FakeTestGroup[Probe.Name()] = &Probe;
+
+        const CancellationToken StopRunning;
+        Mezzanine::Testing::CancelAfterFailures(FakeTestGroup, 2, StopRunning);
+        TEST("CancelAfterFailures::SharesToken", !Probe.IsCancelled())
+
+        Probe.StoreTestResultWithoutName(TestData("Fine", TestResult::Success));
+        Probe.StoreTestResultWithoutName(TestData("Meh", TestResult::Warning));
+        Probe.StoreTestResultWithoutName(TestData("Broken", TestResult::Failed));
+        TEST("CancelAfterFailures::BelowLimit", !StopRunning.IsCancelled())
+
+        Probe.StoreTestResultWithoutName(TestData("Mystery", TestResult::Unknown));
+        TEST("CancelAfterFailures::AtLimit", StopRunning.IsCancelled())
+        TEST("CancelAfterFailures::GroupSees", Probe.IsCancelled())
+
+        Mezzanine::Testing::RecordStoppedEarly(Probe);
+        TEST_EQUAL("RecordStoppedEarly::Name",
+                   Mezzanine::String("CancellationProbe::StoppedEarly"), (Probe.end() - 1)->TestName)
+        TEST_EQUAL("RecordStoppedEarly::IsCancelled", TestResult::Cancelled, (Probe.end() - 1)->Results)
+        TEST_EQUAL("RecordStoppedEarly::KeepsOthers", size_t{5}, size_t(Probe.end() - Probe.begin()))
+    }
+
+    {
+        Mezzanine::Testing::CoreTestGroup FakeTestGroup;
+        CancellationProbeTests Probe;
+        FakeTestGroup[Probe.Name()] = &Probe;
+
+        const CancellationToken StopRunning;
+        Mezzanine::Testing::CancelAfterFailures(FakeTestGroup, 0, StopRunning);
+        Probe.StoreTestResultWithoutName(TestData("Broken", TestResult::Failed));
+        TEST("CancelAfterFailures::ZeroIsNoLimit", !StopRunning.IsCancelled())
+    }
+}
+
+#endif
@@ -0,0 +1,488 @@
+// © Copyright 2010 - 2021 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_CommandLineTests_h
+#define Mezz_Test_CommandLineTests_h
+
+/// @file
+/// @brief Tests for turning the arguments passed to the test executable into options.
+
+// Add other headers you need here
+#include "MezzTest.h"
+#include "OutputBufferGuard.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+/// @brief Parse a fake command line, as if it came from main.
+/// @param Args All the arguments, including the executable name first.
+/// @param TestInstances The test groups the arguments can refer to.
+/// @return The options as the test suite would see them.
+inline Mezzanine::Testing::ParsedCommandLineArgs ParseFakeArgs(std::vector<Mezzanine::String> Args,
+                                                                const Mezzanine::Testing::CoreTestGroup& TestInstances)
+{
+    std::vector<char*> FakeArgv;
+    for(Mezzanine::String& OneArg : Args)
+        { FakeArgv.push_back(&OneArg[0]); }
+    Mezzanine::Testing::OutputBufferGuard CerrGuard(std::cerr);
+    return Mezzanine::Testing::DealWithdCommandLineArgs(static_cast<int>(FakeArgv.size()),
+                                                        FakeArgv.data(),
+                                                        TestInstances);
+}
+
+/// @brief A group with its own time limit, which should win over the one on the command line.
+class PatientProbeTests : public Mezzanine::Testing::AutomaticTestGroup
+{
+    public:
+        virtual ~PatientProbeTests() override = default;
+        virtual void operator ()() override
+            {}
+        virtual Mezzanine::String Name() const override
+            { return "PatientProbe"; }
+        virtual std::chrono::milliseconds Timeout() const override
+            { return std::chrono::milliseconds(1500); }
+};
+
+/// @brief A group with CPUs of its own, which should win over the ones on the command line.
+class PinnedProbeTests : public Mezzanine::Testing::AutomaticTestGroup
+{
+    public:
+        virtual ~PinnedProbeTests() override = default;
+        virtual void operator ()() override
+            {}
+        virtual Mezzanine::String Name() const override
+            { return "PinnedProbe"; }
+        virtual Mezzanine::Boole ShouldPinToCpus() const override
+            { return true; }
+        virtual Mezzanine::Testing::CpuListType PinnedCpus() const override
+            { return Mezzanine::Testing::CpuListType{1}; }
+};
+
+/// @brief A group that fails the first few times it runs, then passes.
+class FlakyProbeTests : public Mezzanine::Testing::AutomaticTestGroup
+{
+    private:
+        /// @brief How many more runs should fail.
+        Mezzanine::Whole FailuresLeft;
+
+    public:
+        /// @brief Constructor.
+        /// @param Failures How many runs fail before they start passing.
+        explicit FlakyProbeTests(const Mezzanine::Whole Failures)
+            : FailuresLeft(Failures)
+            {}
+        virtual ~FlakyProbeTests() override = default;
+        virtual void operator ()() override
+        {
+            TEST("Steady", true)
+            TEST("Flaky", 0 == FailuresLeft)
+            if(0 < FailuresLeft)
+                { FailuresLeft--; }
+        }
+        virtual Mezzanine::String Name() const override
+            { return "FlakyProbe"; }
+        virtual Mezzanine::Boole EmitIntermediaryTestResults() const override
+            { return false; }
+};
+
+AUTOMATIC_TEST_GROUP(CommandLineTests, CommandLine)
+{
+    Mezzanine::Testing::CoreTestGroup FakeTestGroup;
+    CommandLineTests CommandLineInstance;
+    FakeTestGroup[CommandLineInstance.Name()] = &CommandLineInstance;
+
+    {
+        const Mezzanine::Testing::ParsedCommandLineArgs Options = ParseFakeArgs({"Tester"}, FakeTestGroup);
+        TEST_EQUAL("Jobs::DefaultsToHardware",
+                   Mezzanine::Testing::WorkStealingPool::GetDefaultThreadCount(), Options.JobCount)
+        TEST_EQUAL("Jobs::DefaultIsValid", Mezzanine::ExitCode{EXIT_SUCCESS}, Options.ExitWithError)
+    }
+
+    {
+        const Mezzanine::Testing::ParsedCommandLineArgs Options = ParseFakeArgs({"Tester", "jobs=3"}, FakeTestGroup);
+        TEST_EQUAL("Jobs::LongForm", Mezzanine::Whole{3}, Options.JobCount)
+        TEST_EQUAL("Jobs::LongFormIsValid", Mezzanine::ExitCode{EXIT_SUCCESS}, Options.ExitWithError)
+    }
+
+    {
+        const Mezzanine::Testing::ParsedCommandLineArgs Options = ParseFakeArgs({"Tester", "JOBS=5"}, FakeTestGroup);
+        TEST_EQUAL("Jobs::CaseInsensitive", Mezzanine::Whole{5}, Options.JobCount)
+    }
+
+    {
+        const Mezzanine::Testing::ParsedCommandLineArgs Options = ParseFakeArgs({"Tester", "-j2"}, FakeTestGroup);
+        TEST_EQUAL("Jobs::ShortForm", Mezzanine::Whole{2}, Options.JobCount)
+    }
+
+    {
+        const Mezzanine::Testing::ParsedCommandLineArgs Options = ParseFakeArgs({"Tester", "jobs=0"}, FakeTestGroup);
+        TEST_EQUAL("Jobs::ZeroIsInvalid", Mezzanine::ExitCode{EXIT_FAILURE}, Options.ExitWithError)
+    }
+
+    {
+        const Mezzanine::Testing::ParsedCommandLineArgs Options = ParseFakeArgs({"Tester", "-jlots"}, FakeTestGroup);
+        TEST_EQUAL("Jobs::TextIsInvalid", Mezzanine::ExitCode{EXIT_FAILURE}, Options.ExitWithError)
+    }
+
+    {
+        const Mezzanine::Testing::ParsedCommandLineArgs Options = ParseFakeArgs({"Tester", "jobs="}, FakeTestGroup);
+        TEST_EQUAL("Jobs::EmptyIsInvalid", Mezzanine::ExitCode{EXIT_FAILURE}, Options.ExitWithError)
+    }
+
+    {
+        Mezzanine::ExitCode Exit{EXIT_SUCCESS};
+        TEST_NO_THROW("Jobs::BareShortFormDoesNotThrow",
+                      [&]{ Exit = ParseFakeArgs({"Tester", "-j"}, FakeTestGroup).ExitWithError; })
+        TEST_EQUAL("Jobs::BareShortFormIsInvalid", Mezzanine::ExitCode{EXIT_FAILURE}, Exit)
+    }
+
+    {
+        Mezzanine::ExitCode Exit{EXIT_SUCCESS};
+        TEST_NO_THROW("Arguments::ShortUnknownDoesNotThrow",
+                      [&]{ Exit = ParseFakeArgs({"Tester", "-x"}, FakeTestGroup).ExitWithError; })
+        TEST_EQUAL("Arguments::ShortUnknownIsInvalid", Mezzanine::ExitCode{EXIT_FAILURE}, Exit)
+    }
+
+    {
+        const Mezzanine::Testing::ParsedCommandLineArgs Options = ParseFakeArgs({"Tester"}, FakeTestGroup);
+        TEST_EQUAL("Processes::DefaultsToHardware",
+                   Mezzanine::Testing::WorkStealingPool::GetDefaultThreadCount(), Options.ProcessCount)
+    }
+
+    {
+        const Mezzanine::Testing::ParsedCommandLineArgs Options =
+            ParseFakeArgs({"Tester", "processes=6"}, FakeTestGroup);
+        TEST_EQUAL("Processes::Set", Mezzanine::Whole{6}, Options.ProcessCount)
+        TEST_EQUAL("Processes::JobsUnchanged",
+                   Mezzanine::Testing::WorkStealingPool::GetDefaultThreadCount(), Options.JobCount)
+    }
+
+    {
+        const Mezzanine::Testing::ParsedCommandLineArgs Options =
+            ParseFakeArgs({"Tester", "processes=-1"}, FakeTestGroup);
+        TEST_EQUAL("Processes::NegativeIsInvalid", Mezzanine::ExitCode{EXIT_FAILURE}, Options.ExitWithError)
+    }
+
+    {
+        const Mezzanine::Testing::ParsedCommandLineArgs Options = ParseFakeArgs({"Tester"}, FakeTestGroup);
+        TEST_EQUAL("Shard::DefaultIndex", Mezzanine::Whole{1}, Options.ShardIndex)
+        TEST_EQUAL("Shard::DefaultCount", Mezzanine::Whole{1}, Options.ShardCount)
+        TEST("Merge::DefaultIsEmpty", Options.MergeFileNames.empty())
+    }
+
+    {
+        const Mezzanine::Testing::ParsedCommandLineArgs Options = ParseFakeArgs({"Tester", "shard=2/3"}, FakeTestGroup);
+        TEST_EQUAL("Shard::Index", Mezzanine::Whole{2}, Options.ShardIndex)
+        TEST_EQUAL("Shard::Count", Mezzanine::Whole{3}, Options.ShardCount)
+        TEST_EQUAL("Shard::IsValid", Mezzanine::ExitCode{EXIT_SUCCESS}, Options.ExitWithError)
+    }
+
+    for(const char* BadShard : {"shard=0/3", "shard=4/3", "shard=3", "shard=a/b", "shard=1/"})
+    {
+        const Mezzanine::Testing::ParsedCommandLineArgs Options = ParseFakeArgs({"Tester", BadShard}, FakeTestGroup);
+        TEST_EQUAL(Mezzanine::String("Shard::Invalid::") + BadShard, Mezzanine::ExitCode{EXIT_FAILURE}, Options.ExitWithError)
+    }
+
+    {
+        const Mezzanine::Testing::ParsedCommandLineArgs Options = ParseFakeArgs({"Tester"}, FakeTestGroup);
+        TEST_EQUAL("Timeout::DefaultIsNone", std::chrono::seconds::rep{0}, Options.Timeout.count())
+        TEST_EQUAL("Timeout::DefaultForGroup", std::chrono::milliseconds::rep{0},
+                   Mezzanine::Testing::GetTimeLimit(Options, CommandLineInstance).count())
+    }
+
+    {
+        const Mezzanine::Testing::ParsedCommandLineArgs Options =
+            ParseFakeArgs({"Tester", "timeout=90"}, FakeTestGroup);
+        TEST_EQUAL("Timeout::Seconds", std::chrono::seconds::rep{90}, Options.Timeout.count())
+        TEST_EQUAL("Timeout::IsValid", Mezzanine::ExitCode{EXIT_SUCCESS}, Options.ExitWithError)
+        TEST_EQUAL("Timeout::UsedForGroup", std::chrono::milliseconds::rep{90000},
+                   Mezzanine::Testing::GetTimeLimit(Options, CommandLineInstance).count())
+        TEST_EQUAL("Timeout::GroupOwnWins", std::chrono::milliseconds::rep{1500},
+                   Mezzanine::Testing::GetTimeLimit(Options, PatientProbeTests{}).count())
+    }
+
+    for(const char* BadTimeout : {"timeout=0", "timeout=-5", "timeout=soon", "timeout="})
+    {
+        const Mezzanine::Testing::ParsedCommandLineArgs Options =
+            ParseFakeArgs({"Tester", BadTimeout}, FakeTestGroup);
+        TEST_EQUAL(Mezzanine::String("Timeout::Invalid::") + BadTimeout,
+                   Mezzanine::ExitCode{EXIT_FAILURE}, Options.ExitWithError)
+    }
+
+    {
+        const Mezzanine::Testing::ParsedCommandLineArgs Options = ParseFakeArgs({"Tester"}, FakeTestGroup);
+        TEST("Shuffle::OffByDefault", !Options.Shuffle && 0 == Options.ShuffleSeed)
+    }
+
+    {
+        const Mezzanine::Testing::ParsedCommandLineArgs Options = ParseFakeArgs({"Tester", "shuffle"}, FakeTestGroup);
+        TEST("Shuffle::ChoosesSeed", Options.Shuffle && 0 != Options.ShuffleSeed)
+    }
+
+    {
+        const Mezzanine::Testing::ParsedCommandLineArgs Options = ParseFakeArgs({"Tester", "seed=1234"}, FakeTestGroup);
+        TEST("Shuffle::SeedImpliesShuffle", Options.Shuffle)
+        TEST_EQUAL("Shuffle::SeedKept", Mezzanine::Whole{1234}, Options.ShuffleSeed)
+    }
+
+    {
+        const Mezzanine::Testing::ParsedCommandLineArgs Options = ParseFakeArgs({"Tester"}, FakeTestGroup);
+        TEST("Repeat::OffByDefault",
+             1 == Options.RepeatCount && !Options.RepeatUntilFailure && !Options.RepeatConcurrently)
+        TEST_EQUAL("Repeat::NoChildArguments", Mezzanine::String{}, Mezzanine::Testing::GetRepeatArguments(Options))
+    }
+
+    {
+        const Mezzanine::Testing::ParsedCommandLineArgs Options =
+            ParseFakeArgs({"Tester", "repeat=25", "until-fail", "concurrent"}, FakeTestGroup);
+        TEST_EQUAL("Repeat::Count", Mezzanine::Whole{25}, Options.RepeatCount)
+        TEST("Repeat::UntilFail", Options.RepeatUntilFailure)
+        TEST("Repeat::Concurrent", Options.RepeatConcurrently)
+        TEST_EQUAL("Repeat::ChildArguments", Mezzanine::String(" repeat=25 until-fail concurrent"),
+                   Mezzanine::Testing::GetRepeatArguments(Options))
+        TEST_STRING_CONTAINS("Repeat::SubProcessRepeats", Mezzanine::String(" repeat=25 until-fail concurrent"),
+                             Mezzanine::Testing::GetSubProcessCommand(Options, CommandLineInstance))
+        TEST_STRING_CONTAINS("Repeat::WorkerRepeats", Mezzanine::String(" repeat=25 until-fail concurrent"),
+                             Mezzanine::Testing::GetWorkerProcessCommand(Options))
+    }
+
+    {
+        const Mezzanine::Testing::ParsedCommandLineArgs Options =
+            ParseFakeArgs({"Tester", "repeat=3", "until-fail"}, FakeTestGroup);
+        const Mezzanine::Testing::ArgumentListType Arguments =
+            Mezzanine::Testing::GetSubProcessArguments(Options, CommandLineInstance);
+        Mezzanine::String Joined;
+        for(const Mezzanine::String& OneArgument : Arguments)
+            { Joined += (Joined.empty() ? "" : " ") + OneArgument; }
+        TEST_EQUAL("SubProcessArguments::MatchCommand",
+                   Mezzanine::Testing::GetSubProcessCommand(Options, CommandLineInstance), Joined)
+        TEST_EQUAL("SubProcessArguments::ExecutableFirst", Options.CommandName, Arguments.front())
+    }
+
+    for(const char* BadRepeat : {"repeat=", "repeat=0", "repeat=many"})
+    {
+        const Mezzanine::Testing::ParsedCommandLineArgs Options = ParseFakeArgs({"Tester", BadRepeat}, FakeTestGroup);
+        TEST_EQUAL(Mezzanine::String("Repeat::Invalid::") + BadRepeat,
+                   Mezzanine::ExitCode{EXIT_FAILURE}, Options.ExitWithError)
+    }
+
+    {
+        const Mezzanine::Testing::ParsedCommandLineArgs Options = ParseFakeArgs({"Tester"}, FakeTestGroup);
+        TEST_EQUAL("Retries::NoneByDefault", Mezzanine::Whole{0}, Options.RetryCount)
+        FlakyProbeTests Flaky(1);
+        Flaky();
+        TEST("Retries::NotWithoutRetries", !Mezzanine::Testing::PrepareRetry(Options, Flaky, 0))
+    }
+
+    {
+        using Mezzanine::Testing::PrepareRetry;
+        using Mezzanine::Testing::RecordFlakyResults;
+        using Mezzanine::Testing::TestResult;
+        const Mezzanine::Testing::ParsedCommandLineArgs Options =
+            ParseFakeArgs({"Tester", "retries=2"}, FakeTestGroup);
+        TEST_EQUAL("Retries::Count", Mezzanine::Whole{2}, Options.RetryCount)
+
+        FlakyProbeTests Flaky(1);
+        Flaky();
+        TEST("Retries::FailureRetried", PrepareRetry(Options, Flaky, 0))
+        Flaky();
+        TEST("Retries::StopsOncePassing", !PrepareRetry(Options, Flaky, 1))
+        RecordFlakyResults(Flaky, 1);
+        TEST_EQUAL("Retries::PassedOnRetryIsFlaky", TestResult::Flaky, Flaky.GetWorstResults())
+        TEST_STRING_CONTAINS("Retries::FlakyCountsLogged",
+                             Mezzanine::String("FlakyProbe::Flaky passed 1 of 2 run(s)"), Flaky.GetTestLog())
+
+        FlakyProbeTests Broken(3);
+        Broken();
+        TEST("Retries::BrokenRetried", PrepareRetry(Options, Broken, 0))
+        Broken();
+        TEST("Retries::BrokenRetriedAgain", PrepareRetry(Options, Broken, 1))
+        Broken();
+        TEST("Retries::StopsAtLimit", !PrepareRetry(Options, Broken, 2))
+        RecordFlakyResults(Broken, 2);
+        TEST_EQUAL("Retries::AlwaysFailingStaysFailed", TestResult::Failed, Broken.GetWorstResults())
+    }
+
+    {
+        const Mezzanine::Testing::ParsedCommandLineArgs Options =
+            ParseFakeArgs({"Tester", "retries=0"}, FakeTestGroup);
+        TEST_EQUAL("Retries::Invalid", Mezzanine::ExitCode{EXIT_FAILURE}, Options.ExitWithError)
+    }
+
+    {
+        const Mezzanine::Testing::ParsedCommandLineArgs Options = ParseFakeArgs({"Tester"}, FakeTestGroup);
+        TEST("Fork::OffByDefault", !Options.ForkProcesses)
+    }
+
+    {
+        const Mezzanine::Testing::ParsedCommandLineArgs Options = ParseFakeArgs({"Tester", "fork"}, FakeTestGroup);
+        TEST("Fork::Parsed", Options.ForkProcesses)
+
+        // A forked child clears its copy of the group, so a retry runs as if in a fresh process.
+        FlakyProbeTests Forked(1);
+        Forked();
+        Forked.StartTallyingResults();
+        Forked.ClearResults();
+        TEST("Fork::ClearResultsForgetsAll",
+             Forked.begin() == Forked.end() && Forked.GetTestLog().empty() && Forked.GetRepeatTallies().empty())
+        Forked();
+        TEST_EQUAL("Fork::ClearedRunsAfresh", Mezzanine::Testing::TestResult::Success, Forked.GetWorstResults())
+        TEST("Fork::ClearedStopsTallying", Forked.GetRepeatTallies().empty())
+    }
+
+    {
+        using Mezzanine::String;
+        // What a child printed is kept with its group, then written to the XML under the group's name.
+        FlakyProbeTests Chatty(0);
+        Chatty.AppendCapturedOutput("Printed", "");
+        Chatty.AppendCapturedOutput("", String("Complained ]]> with \x01 in it"));
+        TEST_EQUAL("CapturedOutput::Output", String("Printed\n"), Chatty.GetCapturedOutput())
+        TEST_STRING_CONTAINS("CapturedOutput::Errors", String("Complained"), Chatty.GetCapturedErrors())
+        TEST_STRING_CONTAINS("CapturedOutput::OutputInLog",
+                             String("Standard output from the process running FlakyProbe:\nPrinted\n"),
+                             Chatty.GetTestLog())
+        TEST_STRING_CONTAINS("CapturedOutput::ErrorsInLog",
+                             String("Standard error from the process running FlakyProbe:\n"), Chatty.GetTestLog())
+
+        Mezzanine::Testing::CoreTestGroup ChattyGroups;
+        ChattyGroups[Chatty.Name()] = &Chatty;
+        const Mezzanine::Testing::JunitOutputListType Outputs{ Mezzanine::Testing::GetJunitOutputs(ChattyGroups) };
+        TEST_EQUAL("CapturedOutput::OneGroupPrinted", size_t{1}, Outputs.size())
+        std::stringstream Xml;
+        Mezzanine::Testing::WriteJunitResults(Xml, {}, {}, Outputs);
+        TEST_STRING_CONTAINS("CapturedOutput::JunitSystemOut",
+                             String("<system-out><![CDATA[\n--- FlakyProbe ---\nPrinted\n]]></system-out>"), Xml.str())
+        TEST_STRING_CONTAINS("CapturedOutput::JunitSystemErr", String("<system-err><![CDATA["), Xml.str())
+        TEST_STRING_CONTAINS("CapturedOutput::JunitSplitsCDataEnd", String("]]]]><![CDATA[>"), Xml.str())
+        TEST("CapturedOutput::JunitNoControlCharacters", String::npos == Xml.str().find('\x01'))
+
+        Chatty.ClearResults();
+        TEST("CapturedOutput::ClearedWithResults",
+             Chatty.GetCapturedOutput().empty() && Chatty.GetCapturedErrors().empty())
+        std::stringstream QuietXml;
+        Mezzanine::Testing::WriteJunitResults(QuietXml, {}, {}, Mezzanine::Testing::GetJunitOutputs(ChattyGroups));
+        TEST("CapturedOutput::QuietGroupsLeftOut", String::npos == QuietXml.str().find("system-"))
+    }
+
+    {
+        using Mezzanine::Testing::CpuListType;
+        const Mezzanine::Testing::ParsedCommandLineArgs Options =
+            ParseFakeArgs({"Tester", "benchcpus=3,0-1"}, FakeTestGroup);
+        TEST_EQUAL("BenchCpus::IsValid", Mezzanine::ExitCode{EXIT_SUCCESS}, Options.ExitWithError)
+        TEST("BenchCpus::Parsed", (CpuListType{0, 1, 3}) == Options.BenchmarkCpus)
+        TEST("BenchCpus::NotForOrdinaryGroups", Mezzanine::Testing::GetPinnedCpus(Options, CommandLineInstance).empty())
+        TEST("BenchCpus::GroupOwnWins",
+             (CpuListType{1}) == Mezzanine::Testing::GetPinnedCpus(Options, PinnedProbeTests{}))
+
+        Mezzanine::Testing::ParsedCommandLineArgs ChildOptions = Options;
+        ChildOptions.InSubProcess = true;
+        TEST("BenchCpus::NotInChildren", Mezzanine::Testing::GetPinnedCpus(ChildOptions, PinnedProbeTests{}).empty())
+    }
+
+    {
+        PinnedProbeTests Unpinned;
+        Mezzanine::Testing::RecordPinnedCpus(Unpinned, Mezzanine::Testing::CpuListType{1}, false);
+        TEST_EQUAL("BenchCpus::UnpinnedIsNonPerformant",
+                   Mezzanine::Testing::TestResult::NonPerformant, Unpinned.begin()->Results)
+        TEST_STRING_CONTAINS("BenchCpus::UnpinnedIsLogged", Mezzanine::String("Could not pin"), Unpinned.GetTestLog())
+    }
+
+    for(const char* BadCpus : {"benchcpus=", "benchcpus=two", "benchcpus=3-1", "benchcpus=1,,2"})
+    {
+        const Mezzanine::Testing::ParsedCommandLineArgs Options = ParseFakeArgs({"Tester", BadCpus}, FakeTestGroup);
+        TEST_EQUAL(Mezzanine::String("BenchCpus::Invalid::") + BadCpus,
+                   Mezzanine::ExitCode{EXIT_FAILURE}, Options.ExitWithError)
+    }
+
+    {
+        const Mezzanine::Testing::ParsedCommandLineArgs Options = ParseFakeArgs({"Tester"}, FakeTestGroup);
+        TEST_EQUAL("MaxFailures::DefaultIsNone", Mezzanine::Whole{0}, Options.MaxFailures)
+    }
+
+    {
+        const Mezzanine::Testing::ParsedCommandLineArgs Options = ParseFakeArgs({"Tester", "failfast"}, FakeTestGroup);
+        TEST_EQUAL("MaxFailures::FailFastIsOne", Mezzanine::Whole{1}, Options.MaxFailures)
+    }
+
+    {
+        const Mezzanine::Testing::ParsedCommandLineArgs Options =
+            ParseFakeArgs({"Tester", "maxfailures=4"}, FakeTestGroup);
+        TEST_EQUAL("MaxFailures::Set", Mezzanine::Whole{4}, Options.MaxFailures)
+        TEST_EQUAL("MaxFailures::IsValid", Mezzanine::ExitCode{EXIT_SUCCESS}, Options.ExitWithError)
+    }
+
+    {
+        const Mezzanine::Testing::ParsedCommandLineArgs Options =
+            ParseFakeArgs({"Tester", "maxfailures=0"}, FakeTestGroup);
+        TEST_EQUAL("MaxFailures::ZeroIsInvalid", Mezzanine::ExitCode{EXIT_FAILURE}, Options.ExitWithError)
+    }
+
+    {
+        const Mezzanine::Testing::ParsedCommandLineArgs Options =
+            ParseFakeArgs({"Tester", "Merge=Shard_One.txt,Shard_Two.txt"}, FakeTestGroup);
+        TEST_EQUAL("Merge::Count", size_t{2}, Options.MergeFileNames.size())
+        TEST_EQUAL("Merge::KeepsCase", Mezzanine::String("Shard_One.txt"), Options.MergeFileNames.front())
+    }
+
+    {
+        const Mezzanine::Testing::ParsedCommandLineArgs Options = ParseFakeArgs({"Tester"}, FakeTestGroup);
+        TEST("ShardHistory::NoneByDefault", Options.ShardHistoryFileName.empty())
+    }
+
+    {
+        const Mezzanine::String HistoryName{"Mezz_Test_Shard_History_Probe.txt"};
+        std::ofstream(HistoryName) << "Alpha 1\n";
+        const Mezzanine::Testing::ParsedCommandLineArgs Options =
+            ParseFakeArgs({"Tester", "ShardHistory=" + HistoryName}, FakeTestGroup);
+        std::remove(HistoryName.c_str());
+        TEST_EQUAL("ShardHistory::KeepsCase", HistoryName, Options.ShardHistoryFileName)
+        TEST_EQUAL("ShardHistory::IsValid", Mezzanine::ExitCode{EXIT_SUCCESS}, Options.ExitWithError)
+    }
+
+    {
+        const Mezzanine::Testing::ParsedCommandLineArgs Options =
+            ParseFakeArgs({"Tester", "ShardHistory=Mezz_Test_No_Such_History.txt"}, FakeTestGroup);
+        TEST_EQUAL("ShardHistory::MissingIsInvalid", Mezzanine::ExitCode{EXIT_FAILURE}, Options.ExitWithError)
+    }
+}
+
+#endif
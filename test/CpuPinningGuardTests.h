@@ -0,0 +1,97 @@
+// © Copyright 2010 - 2021 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_CpuPinningGuardTests_h
+#define Mezz_Test_CpuPinningGuardTests_h
+
+/// @file
+/// @brief Tests for pinning threads to CPUs and reading lists of CPUs.
+
+// Add other headers you need here
+#include "MezzTest.h"
+
+using Mezzanine::String;
+using Mezzanine::Testing::CpuListType;
+using Mezzanine::Testing::CpuPinningGuard;
+
+AUTOMATIC_TEST_GROUP(CpuPinningGuardTests, CpuPinningGuard)
+{
+    using Mezzanine::Testing::ParseCpuList;
+    using Mezzanine::Testing::CpuListToString;
+
+    {
+        CpuListType Cpus;
+        TEST("Parse::Single", ParseCpuList("3", Cpus) && (CpuListType{3}) == Cpus)
+        TEST("Parse::Range", ParseCpuList("2-4", Cpus) && (CpuListType{2, 3, 4}) == Cpus)
+        TEST("Parse::SortedUnique", ParseCpuList("5,0-1,1", Cpus) && (CpuListType{0, 1, 5}) == Cpus)
+        TEST_EQUAL("ToString::Commas", String("0,1,5"), CpuListToString(Cpus))
+        TEST_EQUAL("ToString::Empty", String(), CpuListToString(CpuListType{}))
+
+        const CpuListType Before{Cpus};
+        TEST("Parse::RejectsEmpty", !ParseCpuList("", Cpus))
+        TEST("Parse::RejectsWords", !ParseCpuList("first", Cpus))
+        TEST("Parse::RejectsBackwards", !ParseCpuList("4-2", Cpus))
+        TEST("Parse::RejectsNegative", !ParseCpuList("-1", Cpus))
+        TEST("Parse::RejectsHuge", !ParseCpuList("0-99999999", Cpus))
+        TEST("Parse::FailureLeavesList", Before == Cpus)
+    }
+
+    {
+        CpuPinningGuard Nothing{CpuListType{}};
+        TEST("Guard::NothingToPin", !Nothing.IsPinned())
+    }
+
+#ifdef MEZZ_Linux
+    {
+        const CpuListType Original{ Mezzanine::Testing::GetThreadCpus() };
+        TEST("Guard::KnowsCpus", !Original.empty())
+        if(!Original.empty())
+        {
+            {
+                CpuPinningGuard Pinning{CpuListType{Original.back()}};
+                TEST("Guard::Pins", Pinning.IsPinned())
+                TEST("Guard::OnlyChosen", (CpuListType{Original.back()}) == Mezzanine::Testing::GetThreadCpus())
+            }
+            TEST("Guard::Restores", Original == Mezzanine::Testing::GetThreadCpus())
+        }
+    }
+#endif // MEZZ_Linux
+}
+
+#endif
@@ -0,0 +1,184 @@
+// © Copyright 2010 - 2021 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_CrashHandlersTests_h
+#define Mezz_Test_CrashHandlersTests_h
+
+/// @file
+/// @brief Tests for child processes reporting how they crashed.
+
+// Add other headers you need here
+#include "MezzTest.h"
+
+#include <atomic>
+#include <csignal>
+#include <thread>
+#include <vector>
+
+using Mezzanine::String;
+using Mezzanine::Testing::CrashFrame;
+using Mezzanine::Testing::CrashReport;
+
+AUTOMATIC_TEST_GROUP(CrashHandlersTests, CrashHandlers)
+{
+    using Mezzanine::Testing::SignalName;
+    using Mezzanine::Testing::DescribeCrash;
+    using Mezzanine::Testing::GetCrashedFunction;
+    using Mezzanine::Testing::NameCrashFrames;
+
+    TEST_EQUAL("SignalName::Known", String("SIGSEGV"), SignalName(SIGSEGV))
+    TEST_EQUAL("SignalName::Unknown", String("signal 1234"), SignalName(1234))
+
+    {
+        CrashReport Crash;
+        Crash.Signal = SIGSEGV;
+        Crash.FaultAddress = 0x10;
+        Crash.Frames.push_back(CrashFrame{0x1000, 0x8, "_ZN5Outer5InnerEi", "libOuter.so"});
+        Crash.Frames.push_back(CrashFrame{0x2000, 0x20, "main", "Test_Tester"});
+        TEST_EQUAL("CrashedFunction::Demangled", String("Outer::Inner(int)"), GetCrashedFunction(Crash))
+        const String Described{ DescribeCrash(Crash) };
+        TEST_STRING_CONTAINS("Describe::Signal", String("SIGSEGV"), Described)
+        TEST_STRING_CONTAINS("Describe::Address", String("at address 0x10,"), Described)
+        TEST_STRING_CONTAINS("Describe::Frame", String("Outer::Inner(int) + 0x8 in libOuter.so"), Described)
+        TEST_STRING_CONTAINS("Describe::PlainName", String("main + 0x20 in Test_Tester"), Described)
+
+        Crash.Frames.front().Symbol.clear();
+        TEST_EQUAL("CrashedFunction::Unnamed", String(), GetCrashedFunction(Crash))
+        TEST_STRING_CONTAINS("Describe::Unnamed", String("?? + 0x8 in libOuter.so"), DescribeCrash(Crash))
+        TEST_STRING_CONTAINS("Describe::NoFrames", String("No frames"), DescribeCrash(CrashReport{}))
+    }
+
+    {
+        CrashReport Aborted;
+        Aborted.Signal = SIGABRT;
+        Aborted.Frames.push_back(CrashFrame{0x1000, 0x8, "raise", "libc.so"});
+        Aborted.Frames.push_back(CrashFrame{0x2000, 0x8, "abort", "libc.so"});
+        Aborted.Frames.push_back(CrashFrame{0x3000, 0x8, "Caller", "libCaller.so"});
+        NameCrashFrames(Aborted);
+        TEST("Name::SkipsAbort", 1 == Aborted.Frames.size() && "Caller" == Aborted.Frames.front().Symbol)
+
+        CrashReport Unloaded;
+        Unloaded.Signal = SIGSEGV;
+        Unloaded.Frames.push_back(CrashFrame{0x1000, 0x8, "", "/not/loaded/here.so"});
+        NameCrashFrames(Unloaded);
+        TEST("Name::KeepsUnloadedOffset", 1 == Unloaded.Frames.size() &&
+             Unloaded.Frames.front().Symbol.empty() && 0x8 == Unloaded.Frames.front().Offset)
+    }
+
+#ifndef MEZZ_Windows
+    {
+        // Crashing for real needs a process to spare, so fork one for each signal.
+        Mezzanine::Testing::ProcessScheduler Crasher(1);
+        std::vector<Mezzanine::Testing::CommandResult> Results;
+        std::vector<CrashReport> Crashes;
+        for(const int OneSignal : {SIGSEGV, SIGABRT})
+        {
+            auto Decoder = std::make_shared<Mezzanine::Testing::ResultRecordDecoder>(
+                [](Mezzanine::Testing::TestData&&){}, nullptr,
+                [&Crashes](CrashReport&& OneCrash){ Crashes.push_back(std::move(OneCrash)); });
+            Crasher.AddFork([OneSignal]() -> Mezzanine::Integer
+                {
+                    Mezzanine::Testing::InstallCrashHandlers(Mezzanine::Testing::ResultChannelDescriptor);
+                    std::raise(OneSignal);
+                    return EXIT_SUCCESS;
+                },
+                [&Results](Mezzanine::Testing::CommandResult&& Result, std::chrono::nanoseconds)
+                    { Results.push_back(std::move(Result)); },
+                {},
+                [Decoder](const Mezzanine::StringView Bytes){ Decoder->Decode(Bytes); });
+        }
+        Crasher.Run();
+        TEST("Installed::DiesOfSignal",
+             2 == Results.size() && SIGSEGV == Results[0].Signal && SIGABRT == Results[1].Signal)
+        TEST("Installed::SendsCrash", 2 == Crashes.size() &&
+             SIGSEGV == Crashes[0].Signal && SIGABRT == Crashes[1].Signal)
+        TEST("Installed::SendsFrames", 2 == Crashes.size() &&
+             !Crashes[0].Frames.empty() && !Crashes[1].Frames.empty())
+        TEST("Installed::SendsUnnamed", 2 == Crashes.size() && Crashes[0].Frames.front().Symbol.empty() &&
+             !Crashes[0].Frames.front().Module.empty())
+
+        bool SomeNamed = false;
+        for(CrashReport& OneCrash : Crashes)
+        {
+            NameCrashFrames(OneCrash);
+            for(const CrashFrame& OneFrame : OneCrash.Frames)
+                { SomeNamed = SomeNamed || !OneFrame.Symbol.empty(); }
+        }
+        TEST("Installed::NamedByParent", SomeNamed)
+    }
+
+    {
+        // Two threads crashing together must still send one whole record, not two tangled ones.
+        Mezzanine::Testing::ProcessScheduler Crasher(1);
+        Mezzanine::Testing::CommandResult Result;
+        std::vector<CrashReport> Crashes;
+        auto Decoder = std::make_shared<Mezzanine::Testing::ResultRecordDecoder>(
+            [](Mezzanine::Testing::TestData&&){}, nullptr,
+            [&Crashes](CrashReport&& OneCrash){ Crashes.push_back(std::move(OneCrash)); });
+        Crasher.AddFork([]() -> Mezzanine::Integer
+            {
+                Mezzanine::Testing::InstallCrashHandlers(Mezzanine::Testing::ResultChannelDescriptor);
+                std::atomic<int> Ready{0};
+                std::thread Other([&Ready]()
+                    {
+                        ++Ready;
+                        while(2 != Ready)
+                            { }
+                        std::raise(SIGSEGV);
+                    });
+                ++Ready;
+                while(2 != Ready)
+                    { }
+                std::raise(SIGSEGV);
+                Other.join();
+                return EXIT_SUCCESS;
+            },
+            [&Result](Mezzanine::Testing::CommandResult&& Finished, std::chrono::nanoseconds)
+                { Result = std::move(Finished); },
+            {},
+            [Decoder](const Mezzanine::StringView Bytes){ Decoder->Decode(Bytes); });
+        Crasher.Run();
+        TEST("Threads::DiesOfSignal", SIGSEGV == Result.Signal)
+        TEST("Threads::OneCrash", 1 == Crashes.size() && !Crashes.front().Frames.empty())
+        TEST("Threads::WholeRecord", !Decoder->HasUnfinishedRecord())
+    }
+#endif // MEZZ_Windows
+}
+
+#endif
@@ -0,0 +1,162 @@
+// © Copyright 2010 - 2021 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_ForkTests_h
+#define Mezz_Test_ForkTests_h
+
+/// @file
+/// @brief Tests for running isolated groups in forks while other groups run on threads.
+
+// Add other headers you need here
+#include "MezzTest.h"
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// @brief A group for the thread pool that interns a lot of new text, taking the lock that guards interned text.
+class ForkPoolProbeTests : public Mezzanine::Testing::AutomaticTestGroup
+{
+    private:
+        /// @brief Tells apart each copy of this group.
+        Mezzanine::Whole Index;
+
+    public:
+        /// @brief Constructor.
+        /// @param Which Tells apart each copy of this group.
+        explicit ForkPoolProbeTests(const Mezzanine::Whole Which)
+            : Index(Which)
+            {}
+        virtual ~ForkPoolProbeTests() override = default;
+        virtual void operator ()() override
+        {
+            Mezzanine::Whole Stored{0};
+            for(Mezzanine::Whole Count = 0; Count < 20000; Count++)
+            {
+                const Mezzanine::String Text{ Name() + "::Interned" + std::to_string(Count) };
+                Stored += Mezzanine::Testing::InternedString(Text) == Text;
+            }
+            TEST_EQUAL("Interned", Mezzanine::Whole{20000}, Stored)
+        }
+        virtual Mezzanine::String Name() const override
+            { return "ForkPoolProbe" + std::to_string(Index); }
+};
+
+/// @brief A group that needs a process of its own, so it runs in a fork when forking.
+class ForkChildProbeTests : public Mezzanine::Testing::AutomaticTestGroup
+{
+    private:
+        /// @brief Tells apart each copy of this group.
+        Mezzanine::Whole Index;
+
+    public:
+        /// @brief Constructor.
+        /// @param Which Tells apart each copy of this group.
+        explicit ForkChildProbeTests(const Mezzanine::Whole Which)
+            : Index(Which)
+            {}
+        virtual ~ForkChildProbeTests() override = default;
+        virtual void operator ()() override
+        {
+            const Mezzanine::String Text{ Name() + "::InternedInFork" };
+            TEST("InternedInFork", Mezzanine::Testing::InternedString(Text) == Text)
+        }
+        virtual Mezzanine::String Name() const override
+            { return "ForkChildProbe" + std::to_string(Index); }
+        virtual Mezzanine::Boole IsMultiThreadSafe() const override
+            { return false; }
+};
+
+// Forking itself would copy the locks of every thread running beside it, so this runs alone.
+ISOLATED_TEST_GROUP(ForkTests, ForkWithThreads)
+{
+#ifndef MEZZ_Windows
+    using Mezzanine::Whole;
+    using Mezzanine::Testing::TestResult;
+
+    // A fork made while the pool interns text would keep the lock on it, and wait for it until timed out.
+    std::vector<std::unique_ptr<ForkPoolProbeTests>> PoolGroups;
+    std::vector<std::unique_ptr<ForkChildProbeTests>> ChildGroups;
+    Mezzanine::Testing::CoreTestGroup Groups;
+    for(Whole Index = 0; Index < 8; Index++)
+    {
+        PoolGroups.push_back(std::make_unique<ForkPoolProbeTests>(Index));
+        Groups[PoolGroups.back()->Name()] = PoolGroups.back().get();
+    }
+    for(Whole Index = 0; Index < 64; Index++)
+    {
+        ChildGroups.push_back(std::make_unique<ForkChildProbeTests>(Index));
+        Groups[ChildGroups.back()->Name()] = ChildGroups.back().get();
+    }
+
+    std::vector<Mezzanine::String> Args{"Tester", "fork", "jobs=4", "timeout=5"};
+    std::vector<char*> Argv;
+    for(Mezzanine::String& OneArg : Args)
+        { Argv.push_back(&OneArg[0]); }
+    const Mezzanine::Testing::ParsedCommandLineArgs Options =
+        Mezzanine::Testing::DealWithdCommandLineArgs(static_cast<int>(Argv.size()), Argv.data(), Groups);
+    Mezzanine::Testing::UnitTestGroup::TestDataStorageType AllResults;
+    std::vector<Mezzanine::Testing::NamedDuration> Timings;
+    {
+        Mezzanine::Testing::OutputBufferGuard Quiet(std::cout);
+        Mezzanine::Testing::RunParallelThreads(Groups, Options, AllResults, Timings,
+                                               Mezzanine::Testing::TestHistory{},
+                                               Mezzanine::Testing::CancellationToken{});
+    }
+
+    Whole ForkedPasses{0};
+    Whole PoolPasses{0};
+    Whole NotPassed{0};
+    for(const Mezzanine::Testing::TestData& OneResult : AllResults)
+    {
+        if(TestResult::Success != OneResult.Results)
+            { NotPassed++; }
+        else if(Mezzanine::String::npos != OneResult.TestName.find("InternedInFork"))
+            { ForkedPasses++; }
+        else
+            { PoolPasses++; }
+    }
+    TEST_EQUAL("WithPool::EveryForkPassed", Whole{64}, ForkedPasses)
+    TEST_EQUAL("WithPool::EveryPoolTestPassed", Whole{8}, PoolPasses)
+    TEST_EQUAL("WithPool::NothingTimedOut", Whole{0}, NotPassed)
+#endif // MEZZ_Windows
+}
+
+#endif
@@ -0,0 +1,120 @@
+// © Copyright 2010 - 2021 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_LogPublisherTests_h
+#define Mezz_Test_LogPublisherTests_h
+
+/// @file
+/// @brief Tests for the thread that writes test group logs.
+
+// Add other headers you need here
+#include "MezzTest.h"
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using Mezzanine::String;
+using Mezzanine::Testing::LogPublisher;
+
+AUTOMATIC_TEST_GROUP(LogPublisherTests, LogPublisher)
+{
+    {
+        std::stringstream Output;
+        LogPublisher Nothing(Output);
+        Nothing.Finish();
+        TEST_EQUAL("NothingPublished", String(), Output.str())
+    }
+
+    {
+        std::stringstream Output;
+        LogPublisher Logs(Output);
+        Logs.Publish("One\n");
+        Logs.Publish("Two\n");
+        Logs.Publish("Three\n");
+        Logs.Finish();
+        Logs.Finish();
+        TEST_EQUAL("InPublishedOrder", String("One\nTwo\nThree\n"), Output.str())
+    }
+
+    {
+        std::stringstream Output;
+        {
+            LogPublisher Logs(Output);
+            Logs.Publish("Unfinished");
+        }
+        TEST_EQUAL("DestructorWritesEverything", String("Unfinished"), Output.str())
+    }
+
+    {
+        const Mezzanine::Whole ThreadCount{4};
+        const Mezzanine::Whole PerThread{500};
+        std::stringstream Output;
+        LogPublisher Logs(Output);
+        std::vector<std::thread> Publishers;
+        for(Mezzanine::Whole ThreadIndex = 0; ThreadIndex < ThreadCount; ++ThreadIndex)
+        {
+            Publishers.emplace_back([&Logs, ThreadIndex]()
+            {
+                for(Mezzanine::Whole Count = 0; Count < PerThread; ++Count)
+                    { Logs.Publish(std::to_string(ThreadIndex) + " " + std::to_string(Count) + "\n"); }
+            });
+        }
+        for(std::thread& OnePublisher : Publishers)
+            { OnePublisher.join(); }
+        Logs.Finish();
+
+        // Every line must arrive, and each thread's lines in the order that thread published them.
+        std::vector<Mezzanine::Whole> NextExpected(ThreadCount, 0);
+        Mezzanine::Whole LineCount{0};
+        Mezzanine::Boole InThreadOrder{true};
+        Mezzanine::Whole ThreadIndex{0};
+        Mezzanine::Whole Count{0};
+        while(Output >> ThreadIndex >> Count)
+        {
+            ++LineCount;
+            if(ThreadCount <= ThreadIndex || NextExpected[ThreadIndex]++ != Count)
+                { InThreadOrder = false; }
+        }
+        TEST_EQUAL("ManyThreads::AllWritten", ThreadCount * PerThread, LineCount)
+        TEST("ManyThreads::EachInOrder", InThreadOrder)
+    }
+}
+
+#endif
@@ -45,7 +45,18 @@
 
 #include "MezzTest.h"
 
+#include <algorithm>
 #include <fstream>
+#include <map>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+/// @brief A tiny group for a worker process loop to run.
+AUTOMATIC_TEST_GROUP(WorkerProbeTests, WorkerProbe)
+{
+    TEST("Probe", true)
+}
 
 /// @brief Tests for the class to store test data results.
 DEFAULT_TEST_GROUP(ProcessTests, Process)
@@ -60,6 +71,10 @@ DEFAULT_TEST_GROUP(ProcessTests, Process)
         TEST_STRING_CONTAINS("RunCommand(const_StringView)-Hello-Output",
                              String("Hello"),
                              HelloResult.ConsoleOutput)
+    #ifndef MEZZ_Windows
+        TEST("RunCommand(const_StringView)-Hello-Usage",
+             HelloResult.Usage.Measured && 0 < HelloResult.Usage.PeakResidentKiB)
+    #endif // MEZZ_Windows
 
         Testing::CommandResult FalseResult = Testing::RunCommand("git asdfg");
         TEST_EQUAL("RunCommand(const_StringView)-FalseCommand-ExitCode",
@@ -68,6 +83,9 @@ DEFAULT_TEST_GROUP(ProcessTests, Process)
         TEST_EQUAL("RunCommand(const_StringView)-FalseCommand-Output",
                    true,
                    FalseResult.ConsoleOutput.empty())
+        TEST_STRING_CONTAINS("RunCommand(const_StringView)-FalseCommand-ErrorOutput",
+                             String("asdfg"),
+                             FalseResult.ErrorOutput)
 
         Testing::CommandResult TrueResult = Testing::RunCommand("git --help");
         TEST_EQUAL("RunCommand(const_StringView)-TrueCommand-ExitCode",
@@ -144,6 +162,349 @@ DEFAULT_TEST_GROUP(ProcessTests, Process)
     {//RunCommandInShell w/ ExecutablePath
         // No good way to test this.
     }//RunCommandInShell w/ ExecutablePath
+
+    {//StreamCommand
+        std::vector<String> Lines;
+        const Testing::CommandResult Streamed = Testing::StreamCommand("cmake -E environment",
+            [&Lines](const StringView Line){ Lines.emplace_back(Line); });
+        const Testing::CommandResult Collected = Testing::RunCommand("cmake -E environment");
+        TEST_EQUAL("StreamCommand-ExitCode", Integer(0), Streamed.ExitCode)
+        TEST("StreamCommand-OutputNotKept", Streamed.ConsoleOutput.empty())
+        TEST_EQUAL("StreamCommand-EveryLine",
+                   size_t(std::count(Collected.ConsoleOutput.begin(), Collected.ConsoleOutput.end(), '\n') + 1),
+                   Lines.size())
+        TEST("StreamCommand-NoLineEndings",
+             std::none_of(Lines.begin(), Lines.end(),
+                          [](const String& Line){ return String::npos != Line.find_first_of("\r\n"); }))
+
+        TEST_THROW("StreamCommand-Throw-BadSymbol",
+                   std::runtime_error,
+                   []{ Testing::CommandResult Unused = Testing::StreamCommand("echo foo | somefile.txt", {}); })
+    }//StreamCommand
+
+    {//ProcessScheduler
+        TEST_EQUAL("ProcessScheduler-ZeroClampsToOne", Whole(1), Testing::ProcessScheduler(0).GetMaxProcesses())
+
+        Testing::ProcessScheduler Scheduler(2);
+        TEST_EQUAL("ProcessScheduler-MaxProcesses", Whole(2), Scheduler.GetMaxProcesses())
+
+        std::vector<String> Outputs;
+        Integer ExitCodeTotal = 0;
+        auto Collect = [&Outputs, &ExitCodeTotal](Testing::CommandResult&& Result, std::chrono::nanoseconds)
+        {
+            Outputs.push_back(Result.ConsoleOutput);
+            ExitCodeTotal += Result.ExitCode;
+        };
+        for(const char* Word : {"Alpha", "Beta", "Gamma", "Delta", "Epsilon"})
+            { Scheduler.AddCommand(String("cmake -E echo ") + Word, Collect); }
+        Scheduler.AddCommand("cmake -E echo Outer",
+            [&Scheduler, &Collect](Testing::CommandResult&& Result, std::chrono::nanoseconds Duration)
+            {
+                Scheduler.AddCommand("cmake -E echo Inner", Collect);
+                Collect(std::move(Result), Duration);
+            });
+        Scheduler.Run();
+        std::sort(Outputs.begin(), Outputs.end());
+        TEST_EQUAL("ProcessScheduler-AllCommandsFinish", std::vector<String>::size_type(7), Outputs.size())
+        TEST_EQUAL("ProcessScheduler-ExitCodes", Integer(0), ExitCodeTotal)
+        TEST_EQUAL("ProcessScheduler-FirstOutput", String("Alpha"), Outputs.front())
+        TEST_EQUAL("ProcessScheduler-LastOutput", String("Outer"), Outputs.back())
+        TEST("ProcessScheduler-AddFromCompletion",
+             Outputs.end() != std::find(Outputs.begin(), Outputs.end(), String("Inner")))
+
+        Integer FalseExitCode = 0;
+        Testing::ProcessScheduler FailingScheduler(1);
+        FailingScheduler.AddCommand("git asdfg",
+            [&FalseExitCode](Testing::CommandResult&& Result, std::chrono::nanoseconds)
+                { FalseExitCode = Result.ExitCode; });
+        FailingScheduler.Run();
+        TEST_EQUAL("ProcessScheduler-FalseCommand-ExitCode", Integer(1), FalseExitCode)
+
+        std::vector<String> StreamedLines;
+        String StreamedOutput("Not finished");
+        Testing::ProcessScheduler Streamer(1);
+        Streamer.AddCommand("cmake -E echo Streamed",
+            [&StreamedOutput](Testing::CommandResult&& Result, std::chrono::nanoseconds)
+                { StreamedOutput = Result.ConsoleOutput; },
+            [&StreamedLines](const StringView Line){ StreamedLines.emplace_back(Line); });
+        Streamer.Run();
+        TEST_EQUAL("ProcessScheduler-StreamedLineCount", size_t(1), StreamedLines.size())
+        TEST_EQUAL("ProcessScheduler-StreamedLine", String("Streamed"), StreamedLines.front())
+        TEST("ProcessScheduler-StreamedOutputNotKept", StreamedOutput.empty())
+
+        TEST_THROW("ProcessScheduler-Throw-BadSymbol",
+                   std::runtime_error,
+                   [&FailingScheduler]{ FailingScheduler.AddCommand("echo foo | somefile.txt", {}); })
+
+        // Four children that each sleep a quarter second should overlap when allowed to.
+        Testing::ProcessScheduler Sleepers(4);
+        for(Whole Count = 0; Count < 4; ++Count)
+            { Sleepers.AddCommand("cmake -E sleep 0.25", [](Testing::CommandResult&&, std::chrono::nanoseconds){}); }
+        TEST_TIMED_UNDER("ProcessScheduler-ChildrenOverlap", std::chrono::milliseconds(900),
+                         [&Sleepers]{ Sleepers.Run(); })
+
+    #ifndef MEZZ_Windows
+        // The sleep keeps the output open, so this only finishes quickly if the whole process group is killed.
+        Testing::ProcessScheduler Impatient(2);
+        Testing::CommandResult Overdue;
+        Testing::CommandResult Quick;
+        Impatient.AddCommand("sh -c 'echo Before; sleep 5; echo After'",
+            [&Overdue](Testing::CommandResult&& Result, std::chrono::nanoseconds){ Overdue = std::move(Result); },
+            {}, {}, std::chrono::milliseconds(200));
+        Impatient.AddCommand("cmake -E echo Quick",
+            [&Quick](Testing::CommandResult&& Result, std::chrono::nanoseconds){ Quick = std::move(Result); },
+            {}, {}, std::chrono::seconds(30));
+        TEST_TIMED_UNDER("ProcessScheduler-TimeLimitKillsGroup", std::chrono::seconds(3),
+                         [&Impatient]{ Impatient.Run(); })
+        TEST("ProcessScheduler-TimedOut", Overdue.TimedOut)
+        TEST("ProcessScheduler-TimedOutExitCode", Integer(EXIT_SUCCESS) != Overdue.ExitCode)
+        TEST_EQUAL("ProcessScheduler-TimedOutKeepsOutput", String("Before"), Overdue.ConsoleOutput)
+        TEST("ProcessScheduler-InTime", !Quick.TimedOut && Integer(EXIT_SUCCESS) == Quick.ExitCode)
+
+        // Cancelled from another thread while one child sleeps and another waits for a free slot.
+        Testing::ProcessScheduler Stoppable(1);
+        const Testing::CancellationToken StopScheduler;
+        Stoppable.SetCancellationToken(StopScheduler);
+        std::vector<Testing::CommandResult> StoppedResults;
+        for(Whole Count = 0; Count < 2; ++Count)
+        {
+            Stoppable.AddCommand("sh -c 'sleep 5'",
+                [&StoppedResults](Testing::CommandResult&& Result, std::chrono::nanoseconds)
+                    { StoppedResults.push_back(std::move(Result)); });
+        }
+        std::thread SchedulerCanceller([StopScheduler]
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            StopScheduler.Cancel();
+        });
+        TEST_TIMED_UNDER("ProcessScheduler-CancelKills", std::chrono::seconds(3), [&Stoppable]{ Stoppable.Run(); })
+        SchedulerCanceller.join();
+        TEST("ProcessScheduler-CancelCompletesAll",
+             2 == StoppedResults.size() && StoppedResults.front().Cancelled && StoppedResults.back().Cancelled)
+        TEST("ProcessScheduler-CancelledRunningFails", Integer(EXIT_SUCCESS) != StoppedResults.back().ExitCode)
+
+        // Commands already split up are run exactly as given, without quoting or checks for unsafe characters.
+        Testing::ProcessScheduler Splitter(1);
+        std::vector<Testing::CommandResult> SplitResults;
+        auto CollectSplit = [&SplitResults](Testing::CommandResult&& Result, std::chrono::nanoseconds)
+            { SplitResults.push_back(std::move(Result)); };
+        Splitter.AddCommand(Testing::ArgumentListType{"cmake", "-E", "echo", "Has  Spaces"}, CollectSplit);
+        Splitter.AddCommand(Testing::ArgumentListType{"sh", "-c", "echo Piped | cat"}, CollectSplit);
+        Splitter.AddCommand(Testing::ArgumentListType{"NoSuchExecutableForMezzTest", "Ignored"}, CollectSplit);
+        Splitter.Run();
+        TEST_EQUAL("ProcessScheduler-SplitCount", size_t(3), SplitResults.size())
+        TEST_EQUAL("ProcessScheduler-SplitKeepsSpaces", String("Has  Spaces"), SplitResults[0].ConsoleOutput)
+        TEST_EQUAL("ProcessScheduler-SplitNotChecked", String("Piped"), SplitResults[1].ConsoleOutput)
+        TEST_EQUAL("ProcessScheduler-SplitMissingExitCode", Integer(EXIT_FAILURE), SplitResults[2].ExitCode)
+        TEST_STRING_CONTAINS("ProcessScheduler-SplitMissingOutput", String("Process Error: "),
+                             SplitResults[2].ConsoleOutput)
+        TEST_THROW("ProcessScheduler-Throw-NoArguments",
+                   std::invalid_argument,
+                   [&Splitter]{ Splitter.AddCommand(Testing::ArgumentListType{}, {}); })
+
+        // Forked children skip exec but otherwise act like commands, one at a time so they finish in order.
+        Testing::ProcessScheduler Forker(1);
+        std::vector<Testing::CommandResult> ForkedResults;
+        auto CollectForked = [&ForkedResults](Testing::CommandResult&& Result, std::chrono::nanoseconds)
+            { ForkedResults.push_back(std::move(Result)); };
+        const String SetBeforeForking("Set before forking");
+        String ForkedChannel;
+        Forker.AddFork([&SetBeforeForking]() -> Integer
+            {
+                std::cout << SetBeforeForking << std::endl;
+                Testing::WriteToDescriptor(Testing::ResultChannelDescriptor, "Sent on the channel");
+                return 7;
+            },
+            CollectForked, {},
+            [&ForkedChannel](const StringView Bytes){ ForkedChannel.append(Bytes.data(), Bytes.size()); });
+        Forker.AddFork([]() -> Integer { throw std::runtime_error("Thrown in a fork."); }, CollectForked);
+        Forker.AddFork([]() -> Integer
+            {
+                std::this_thread::sleep_for(std::chrono::seconds(5));
+                return EXIT_SUCCESS;
+            },
+            CollectForked, {}, {}, std::chrono::milliseconds(200));
+        TEST_TIMED_UNDER("ProcessScheduler-ForkTimeLimit", std::chrono::seconds(3), [&Forker]{ Forker.Run(); })
+        TEST_EQUAL("ProcessScheduler-ForkCount", size_t(3), ForkedResults.size())
+        TEST_EQUAL("ProcessScheduler-ForkExitCode", Integer(7), ForkedResults[0].ExitCode)
+        TEST_EQUAL("ProcessScheduler-ForkKeepsMemory", SetBeforeForking, ForkedResults[0].ConsoleOutput)
+        TEST_EQUAL("ProcessScheduler-ForkResultChannel", String("Sent on the channel"), ForkedChannel)
+        TEST_EQUAL("ProcessScheduler-ForkThrowFails", Integer(EXIT_FAILURE), ForkedResults[1].ExitCode)
+        TEST("ProcessScheduler-ForkTimedOut", ForkedResults[2].TimedOut)
+
+        // The peak is counted in the child, so touching memory there shows up even though the parent never did.
+        Testing::ProcessScheduler Measurer(1);
+        std::vector<Testing::CommandResult> MeasuredResults;
+        auto CollectMeasured = [&MeasuredResults](Testing::CommandResult&& Result, std::chrono::nanoseconds)
+            { MeasuredResults.push_back(std::move(Result)); };
+        Measurer.AddFork([]() -> Integer { return EXIT_SUCCESS; }, CollectMeasured);
+        Measurer.AddFork([]() -> Integer
+            {
+                std::vector<char> Touched(64 * 1024 * 1024, 'x');
+                return 'x' == Touched.back() ? EXIT_SUCCESS : EXIT_FAILURE;
+            },
+            CollectMeasured);
+        Measurer.Run();
+        TEST("ProcessScheduler-UsageMeasured", 2 == MeasuredResults.size() &&
+             MeasuredResults[0].Usage.Measured && MeasuredResults[1].Usage.Measured)
+        TEST("ProcessScheduler-UsagePeakResident", 2 == MeasuredResults.size() &&
+             MeasuredResults[0].Usage.PeakResidentKiB + 32 * 1024 < MeasuredResults[1].Usage.PeakResidentKiB)
+        TEST("ProcessScheduler-UsageMinorFaults", 2 == MeasuredResults.size() &&
+             MeasuredResults[0].Usage.MinorFaults < MeasuredResults[1].Usage.MinorFaults)
+
+        // Far more than either pipe holds, so a child like this stalls forever if one is read only after the other.
+        Testing::ProcessScheduler Chatterer(1);
+        Testing::CommandResult ChattyResult;
+        Chatterer.AddFork([]() -> Integer
+            {
+                const String Chunk(4096, 'x');
+                for(Whole Count = 0; Count < 256; ++Count)
+                {
+                    std::cout << Chunk;
+                    std::cerr << Chunk;
+                }
+                std::cerr << "Only on cerr" << std::endl;
+                return EXIT_SUCCESS;
+            },
+            [&ChattyResult](Testing::CommandResult&& Result, std::chrono::nanoseconds)
+                { ChattyResult = std::move(Result); },
+            {}, {}, std::chrono::seconds(10));
+        TEST_TIMED_UNDER("ProcessScheduler-BothPipesRead", std::chrono::seconds(5), [&Chatterer]{ Chatterer.Run(); })
+        TEST("ProcessScheduler-ChattyNotTimedOut", !ChattyResult.TimedOut)
+        TEST_EQUAL("ProcessScheduler-ConsoleOutputKeptApart", size_t(256 * 4096), ChattyResult.ConsoleOutput.size())
+        TEST_EQUAL("ProcessScheduler-ErrorOutputKeptApart", size_t(256 * 4096 + 12), ChattyResult.ErrorOutput.size())
+
+        TEST_THROW("ProcessScheduler-Throw-ForkWithoutWork",
+                   std::invalid_argument,
+                   [&Forker]{ Forker.AddFork({}, [](Testing::CommandResult&&, std::chrono::nanoseconds){}); })
+    #endif // MEZZ_Windows
+    }//ProcessScheduler
+
+    {//WorkerProcessPool
+    #ifndef MEZZ_Windows
+        Testing::WorkerProcessPool Workers(
+            "sh -c 'while read Line; do if [ $Line = crash ]; then exit 3; fi; echo got $Line; echo DONE; done'",
+            2, "DONE");
+        TEST_EQUAL("WorkerProcessPool-MaxWorkers", Whole(2), Workers.GetMaxWorkers())
+
+        std::map<String, Testing::CommandResult> Answers;
+        for(const char* Request : {"Alpha", "Beta", "crash", "Gamma", "Delta"})
+        {
+            Workers.AddRequest(Request,
+                [&Answers, Request](Testing::CommandResult&& Result, std::chrono::nanoseconds)
+                    { Answers[Request] = std::move(Result); });
+        }
+        Workers.Run();
+
+        TEST_EQUAL("WorkerProcessPool-AllAnswered", size_t(5), Answers.size())
+        TEST_EQUAL("WorkerProcessPool-Output", String("got Alpha"), Answers["Alpha"].ConsoleOutput)
+        TEST_EQUAL("WorkerProcessPool-ExitCode", Integer(EXIT_SUCCESS), Answers["Alpha"].ExitCode)
+        TEST_EQUAL("WorkerProcessPool-CrashExitCode", Integer(3), Answers["crash"].ExitCode)
+        TEST_EQUAL("WorkerProcessPool-AfterCrashOutput", String("got Delta"), Answers["Delta"].ConsoleOutput)
+        TEST_EQUAL("WorkerProcessPool-AfterCrashExitCode", Integer(EXIT_SUCCESS), Answers["Delta"].ExitCode)
+
+        Testing::WorkerProcessPool Complainers(
+            "sh -c 'while read Line; do ls /nonexistent/$Line; echo got $Line; echo DONE; done'", 1, "DONE");
+        std::map<String, Testing::CommandResult> Complaints;
+        for(const char* Request : {"Alpha", "Beta"})
+        {
+            Complainers.AddRequest(Request,
+                [&Complaints, Request](Testing::CommandResult&& Result, std::chrono::nanoseconds)
+                    { Complaints[Request] = std::move(Result); });
+        }
+        Complainers.Run();
+        TEST_EQUAL("WorkerProcessPool-ErrorsNotInOutput", String("got Alpha"), Complaints["Alpha"].ConsoleOutput)
+        TEST_STRING_CONTAINS("WorkerProcessPool-ErrorOutput", String("Alpha"), Complaints["Alpha"].ErrorOutput)
+        TEST("WorkerProcessPool-ErrorOutputPerRequest",
+             String::npos != Complaints["Beta"].ErrorOutput.find("Beta") &&
+             String::npos == Complaints["Beta"].ErrorOutput.find("Alpha"))
+
+        Testing::WorkerProcessPool Streamers(
+            "sh -c 'while read Line; do echo got $Line; echo more $Line; echo DONE; done'", 1, "DONE");
+        std::vector<String> StreamedLines;
+        std::vector<String> StreamedOutputs;
+        for(const char* Request : {"Alpha", "Beta"})
+        {
+            Streamers.AddRequest(Request,
+                [&StreamedOutputs](Testing::CommandResult&& Result, std::chrono::nanoseconds)
+                    { StreamedOutputs.push_back(Result.ConsoleOutput); },
+                [&StreamedLines](const StringView Line){ StreamedLines.emplace_back(Line); });
+        }
+        Streamers.Run();
+        TEST_EQUAL("WorkerProcessPool-StreamedLineCount", size_t(4), StreamedLines.size())
+        TEST_EQUAL("WorkerProcessPool-StreamedFirstLine", String("got Alpha"), StreamedLines.front())
+        TEST_EQUAL("WorkerProcessPool-StreamedLastLine", String("more Beta"), StreamedLines.back())
+        TEST("WorkerProcessPool-StreamedOutputNotKept",
+             2 == StreamedOutputs.size() && StreamedOutputs.front().empty() && StreamedOutputs.back().empty())
+
+        Testing::WorkerProcessPool Slowpokes(
+            "sh -c 'while read Line; do echo got $Line; if [ $Line = slow ]; then sleep 5; fi; echo DONE; done'",
+            1, "DONE");
+        std::map<String, Testing::CommandResult> SlowAnswers;
+        for(const char* Request : {"slow", "Alpha"})
+        {
+            Slowpokes.AddRequest(Request,
+                [&SlowAnswers, Request](Testing::CommandResult&& Result, std::chrono::nanoseconds)
+                    { SlowAnswers[Request] = std::move(Result); },
+                {}, {}, std::chrono::milliseconds(200));
+        }
+        TEST_TIMED_UNDER("WorkerProcessPool-TimeLimitKillsGroup", std::chrono::seconds(3),
+                         [&Slowpokes]{ Slowpokes.Run(); })
+        TEST("WorkerProcessPool-TimedOut", SlowAnswers["slow"].TimedOut)
+        TEST_EQUAL("WorkerProcessPool-TimedOutKeepsOutput", String("got slow"), SlowAnswers["slow"].ConsoleOutput)
+        TEST("WorkerProcessPool-AfterTimeOut",
+             !SlowAnswers["Alpha"].TimedOut && String("got Alpha") == SlowAnswers["Alpha"].ConsoleOutput)
+
+        Testing::WorkerProcessPool StoppableWorkers(
+            "sh -c 'while read Line; do sleep 5; echo DONE; done'", 1, "DONE");
+        const Testing::CancellationToken StopWorkers;
+        StoppableWorkers.SetCancellationToken(StopWorkers);
+        std::vector<Testing::CommandResult> StoppedAnswers;
+        for(const char* Request : {"Alpha", "Beta"})
+        {
+            StoppableWorkers.AddRequest(Request,
+                [&StoppedAnswers](Testing::CommandResult&& Result, std::chrono::nanoseconds)
+                    { StoppedAnswers.push_back(std::move(Result)); });
+        }
+        std::thread WorkerCanceller([StopWorkers]
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            StopWorkers.Cancel();
+        });
+        TEST_TIMED_UNDER("WorkerProcessPool-CancelKills", std::chrono::seconds(3),
+                         [&StoppableWorkers]{ StoppableWorkers.Run(); })
+        WorkerCanceller.join();
+        TEST("WorkerProcessPool-CancelCompletesAll",
+             2 == StoppedAnswers.size() && StoppedAnswers.front().Cancelled && StoppedAnswers.back().Cancelled)
+
+        TEST_THROW("WorkerProcessPool-Throw-Multiline",
+                   std::invalid_argument,
+                   [&Workers]{ Workers.AddRequest("One\nTwo", {}); })
+        TEST_THROW("WorkerProcessPool-Throw-BadSymbol",
+                   std::runtime_error,
+                   []{ Testing::WorkerProcessPool BadWorkers("cat | cat", 1, "DONE"); })
+    #endif // MEZZ_Windows
+    }//WorkerProcessPool
+
+    {//RunWorkerProcess
+        Testing::CoreTestGroup FakeTestGroup;
+        WorkerProbeTests WorkerProbeInstance;
+        FakeTestGroup["workerprobe"] = &WorkerProbeInstance;
+
+        std::istringstream Requests("workerprobe\nnosuchgroup\n");
+        std::ostringstream Results;
+        TEST_EQUAL("RunWorkerProcess-ExitCode",
+                   ExitCode(EXIT_SUCCESS),
+                   Testing::RunWorkerProcess(FakeTestGroup, Requests, Results))
+        TEST_STRING_CONTAINS("RunWorkerProcess-RanGroup", String("WorkerProbe::Probe"), Results.str())
+
+        Whole MarkerCount = 0;
+        for(String::size_type Found = Results.str().find(Testing::WorkerGroupDoneMarker);
+            String::npos != Found;
+            Found = Results.str().find(Testing::WorkerGroupDoneMarker, Found + 1))
+            { ++MarkerCount; }
+        TEST_EQUAL("RunWorkerProcess-MarkerPerRequest", Whole(2), MarkerCount)
+    }//RunWorkerProcess
 }
 
 #endif
@@ -0,0 +1,143 @@
+// © Copyright 2010 - 2021 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_ResourceLimitGuardTests_h
+#define Mezz_Test_ResourceLimitGuardTests_h
+
+/// @file
+/// @brief Tests for limiting what a process may use and for the limits test groups ask for.
+
+// Add other headers you need here
+#include "MezzTest.h"
+
+#ifndef MEZZ_Windows
+    #include <sys/resource.h>
+#endif // MEZZ_Windows
+
+#include <fstream>
+#include <vector>
+
+using Mezzanine::Integer;
+using Mezzanine::Testing::ResourceLimitGuard;
+using Mezzanine::Testing::ResourceLimits;
+
+/// @brief A group asking for every resource limit, to check they are gathered.
+class LimitedProbeTestGroup : public Mezzanine::Testing::UnitTestGroup
+{
+public:
+    virtual void operator()() override
+        {}
+    virtual Mezzanine::String Name() const override
+        { return "LimitedProbe"; }
+    virtual Mezzanine::UInt64 MaxAddressSpace() const override
+        { return 1024 * 1024 * 1024; }
+    virtual Mezzanine::Whole MaxCpuSeconds() const override
+        { return 30; }
+    virtual Mezzanine::Whole MaxOpenFiles() const override
+        { return 64; }
+};
+
+AUTOMATIC_TEST_GROUP(ResourceLimitGuardTests, ResourceLimitGuard)
+{
+    using Mezzanine::Testing::GetResourceLimits;
+
+    {
+        LimitedProbeTestGroup Limited;
+        const ResourceLimits Asked{ GetResourceLimits(Limited) };
+        TEST("Limits::GathersAddressSpace", Mezzanine::UInt64{1024 * 1024 * 1024} == Asked.AddressSpaceBytes)
+        TEST("Limits::GathersCpu", Mezzanine::Whole{30} == Asked.CpuSeconds)
+        TEST("Limits::GathersOpenFiles", Mezzanine::Whole{64} == Asked.OpenFiles)
+        TEST("Limits::Any", Asked.Any())
+        TEST("Limits::DefaultsToNone", !GetResourceLimits(*this).Any())
+    }
+
+    {
+        ResourceLimitGuard Nothing{ResourceLimits{}};
+        TEST("Guard::NothingToLimit", !Nothing.IsLimited())
+    }
+
+#ifndef MEZZ_Windows
+    {
+        // Limits are for the whole process, so only a fork can try one that would hurt other groups.
+        Mezzanine::Testing::ProcessScheduler Forker(1);
+        std::vector<Integer> ExitCodes;
+        auto CollectExitCode = [&ExitCodes](Mezzanine::Testing::CommandResult&& Result, std::chrono::nanoseconds)
+            { ExitCodes.push_back(Result.ExitCode); };
+        Forker.AddFork([]() -> Integer
+            {
+                ResourceLimits NoSpareFiles;
+                NoSpareFiles.OpenFiles = 3; // Only cin, cout and cerr.
+                const ResourceLimitGuard Limits(NoSpareFiles);
+                const std::ifstream Opened("/dev/null");
+                return Limits.IsLimited() && !Opened.is_open() ? EXIT_SUCCESS : EXIT_FAILURE;
+            },
+            CollectExitCode);
+        Forker.AddFork([]() -> Integer
+            {
+                {
+                    ResourceLimits NoSpareFiles;
+                    NoSpareFiles.OpenFiles = 3;
+                    const ResourceLimitGuard Limits(NoSpareFiles);
+                }
+                const std::ifstream Opened("/dev/null");
+                return Opened.is_open() ? EXIT_SUCCESS : EXIT_FAILURE;
+            },
+            CollectExitCode);
+        Forker.Run();
+        TEST("Guard::OpenFilesLimited", 2 == ExitCodes.size() && EXIT_SUCCESS == ExitCodes[0])
+        TEST("Guard::OpenFilesRestored", 2 == ExitCodes.size() && EXIT_SUCCESS == ExitCodes[1])
+
+        struct rlimit Before{};
+        static_cast<void>(::getrlimit(RLIMIT_CPU, &Before));
+        {
+            ResourceLimits SomeCpu;
+            SomeCpu.CpuSeconds = 3600;
+            const ResourceLimitGuard Limits(SomeCpu);
+            struct rlimit During{};
+            static_cast<void>(::getrlimit(RLIMIT_CPU, &During));
+            TEST("Guard::CpuLimited", Limits.IsLimited() && RLIM_INFINITY != During.rlim_cur)
+        }
+        struct rlimit After{};
+        static_cast<void>(::getrlimit(RLIMIT_CPU, &After));
+        TEST("Guard::CpuRestored", Before.rlim_cur == After.rlim_cur)
+    }
+#endif // MEZZ_Windows
+}
+
+#endif
@@ -0,0 +1,148 @@
+// © Copyright 2010 - 2021 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_ResultCacheTests_h
+#define Mezz_Test_ResultCacheTests_h
+
+/// @file
+/// @brief Tests for storing passing results and replaying them while the test binaries are unchanged.
+
+// Add other headers you need here
+#include "MezzTest.h"
+
+#include <sstream>
+
+using Mezzanine::String;
+using Mezzanine::Testing::ResultCache;
+using Mezzanine::Testing::TestData;
+using Mezzanine::Testing::TestResult;
+
+AUTOMATIC_TEST_GROUP(ResultCacheTests, ResultCache)
+{
+    const ResultCache::ResultsType Passing{ TestData("Group::One", TestResult::Success),
+                                            TestData("Group::Two", TestResult::Success) };
+
+    {
+        ResultCache Empty("0123456789abcdef");
+        TEST_EQUAL("Empty::Size", Mezzanine::Whole{0}, Empty.size())
+        TEST("Empty::FindsNothing", nullptr == Empty.Find("Group", "timeout=0"))
+    }
+
+    {
+        ResultCache Cache("0123456789abcdef");
+        Cache.Store("Group", "timeout=0", Passing);
+        Cache.Store("Other", "timeout=0", Passing);
+        TEST_EQUAL("Store::Size", Mezzanine::Whole{2}, Cache.size())
+        TEST("Store::Finds", nullptr != Cache.Find("Group", "timeout=0"))
+        TEST("Store::KeyedByArguments", nullptr == Cache.Find("Group", "timeout=5"))
+        Cache.Forget("Other", "timeout=0");
+        TEST("Forget::Removes", nullptr == Cache.Find("Other", "timeout=0"))
+
+        std::stringstream Saved;
+        Cache.Save(Saved);
+        const String SavedText{ Saved.str() };
+
+        std::stringstream SameBuild(SavedText);
+        ResultCache Loaded("0123456789abcdef");
+        Loaded.Load(SameBuild);
+        TEST_EQUAL("SaveLoad::Size", Mezzanine::Whole{1}, Loaded.size())
+        const ResultCache::ResultsType* Found = Loaded.Find("Group", "timeout=0");
+        TEST("SaveLoad::Finds", nullptr != Found)
+        if(nullptr != Found)
+        {
+            TEST_EQUAL("SaveLoad::ResultCount", size_t{2}, Found->size())
+            TEST_EQUAL("SaveLoad::Name", String("Group::Two"), Found->back().TestName)
+        }
+
+        std::stringstream OtherBuild(SavedText);
+        ResultCache Rebuilt("fedcba9876543210");
+        Rebuilt.Load(OtherBuild);
+        TEST_EQUAL("Load::IgnoresOtherBuilds", Mezzanine::Whole{0}, Rebuilt.size())
+    }
+
+    {
+        ResultCache Cache("0123456789abcdef");
+        Cache.Store("Group", "timeout=0", Passing);
+        Cache.Store("Other", "timeout=0", Passing);
+        std::stringstream Saved;
+        Cache.Save(Saved);
+        const String SavedText{ Saved.str() };
+
+        // A run that died while saving left the last entry with only one of its results.
+        std::stringstream Truncated(SavedText.substr(0, SavedText.rfind("[ ")));
+        ResultCache CutShort("0123456789abcdef");
+        CutShort.Load(Truncated);
+        TEST_EQUAL("Load::DropsTruncated", Mezzanine::Whole{1}, CutShort.size())
+        TEST("Load::KeepsComplete", nullptr != CutShort.Find("Group", "timeout=0"))
+
+        // A result that does not read back is a miss, not a shorter pass.
+        String Garbled{ SavedText };
+        Garbled.replace(Garbled.find("[ "), 2, "??");
+        std::stringstream GarbledStream(Garbled);
+        ResultCache Unreadable("0123456789abcdef");
+        Unreadable.Load(GarbledStream);
+        TEST("Load::DropsUnreadable", nullptr == Unreadable.Find("Group", "timeout=0"))
+    }
+
+    {
+        const String Fingerprint{ Mezzanine::Testing::GetLoadedBinariesFingerprint("Mezz_Test") };
+        TEST_EQUAL("Fingerprint::Length", String::size_type{16}, Fingerprint.size())
+        TEST_EQUAL("Fingerprint::Stable", Fingerprint,
+                   Mezzanine::Testing::GetLoadedBinariesFingerprint("Mezz_Test"))
+    }
+
+    {
+        Mezzanine::Testing::CoreTestGroup FakeTestGroup;
+        ResultCacheTests Scheduled;
+        ResultCacheTests NotScheduled;
+        Scheduled.SetScheduledToRun();
+        FakeTestGroup["scheduled"] = &Scheduled;
+        FakeTestGroup["notscheduled"] = &NotScheduled;
+
+        ResultCache Cache("0123456789abcdef");
+        Cache.Store(Scheduled.Name(), "timeout=0", Passing);
+        Mezzanine::Testing::ReplayCachedResults(FakeTestGroup, Cache, "timeout=0");
+        TEST("Replay::Marked", Scheduled.WasReplayedFromCache())
+        TEST_EQUAL("Replay::Results", Mezzanine::Whole{2},
+                   static_cast<Mezzanine::Whole>(std::distance(Scheduled.begin(), Scheduled.end())))
+        TEST("Replay::OnlyScheduled", !NotScheduled.WasReplayedFromCache())
+    }
+}
+
+#endif
@@ -0,0 +1,204 @@
+// © Copyright 2010 - 2021 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_ResultRecordsTests_h
+#define Mezz_Test_ResultRecordsTests_h
+
+/// @file
+/// @brief Tests for the binary records child processes send their results in.
+
+// Add other headers you need here
+#include "MezzTest.h"
+
+#include <vector>
+
+using Mezzanine::String;
+using Mezzanine::StringView;
+using Mezzanine::Testing::TestData;
+using Mezzanine::Testing::TestResult;
+
+/// @brief A tiny group whose results can be sent as records.
+AUTOMATIC_TEST_GROUP(ResultRecordProbeTests, ResultRecordProbe)
+{
+    TEST("Probe", true)
+}
+
+AUTOMATIC_TEST_GROUP(ResultRecordsTests, ResultRecords)
+{
+    using Mezzanine::Testing::ResultRecordDecoder;
+
+    const TestData Odd("Odd [  Failed  ] name in function 'x' at y:1.\nwith a newline",
+                       TestResult::Failed, "Function", "File.cpp", 42);
+    const TestData Plain("Plain", TestResult::Success);
+
+    {
+        std::vector<TestData> Decoded;
+        std::vector<String> Logs;
+        ResultRecordDecoder Decoder([&Decoded](TestData&& OneResult){ Decoded.push_back(std::move(OneResult)); },
+                                    [&Logs](const StringView Log){ Logs.emplace_back(Log); });
+        Decoder.Decode(Mezzanine::Testing::EncodeResultRecord(Odd) +
+                       Mezzanine::Testing::EncodeLogRecord("Some log\n") +
+                       Mezzanine::Testing::EncodeResultRecord(Plain));
+        TEST_EQUAL("Decode::ResultCount", size_t{2}, Decoded.size())
+        TEST_EQUAL("Decode::AnyName", Odd, Decoded.front())
+        TEST_EQUAL("Decode::Success", Plain, Decoded.back())
+        TEST_EQUAL("Decode::LogCount", size_t{1}, Logs.size())
+        TEST_EQUAL("Decode::Log", String("Some log\n"), Logs.front())
+        TEST("Decode::NothingLeft", !Decoder.HasUnfinishedRecord())
+    }
+
+    {
+        std::vector<TestData> Decoded;
+        ResultRecordDecoder Decoder([&Decoded](TestData&& OneResult){ Decoded.push_back(std::move(OneResult)); });
+        const String Records( Mezzanine::Testing::EncodeResultRecord(Odd) +
+                              Mezzanine::Testing::EncodeLogRecord("Ignored") );
+        for(const char OneByte : Records)
+            { Decoder.Decode(StringView(&OneByte, 1)); }
+        TEST_EQUAL("DecodeByteByByte::ResultCount", size_t{1}, Decoded.size())
+        TEST_EQUAL("DecodeByteByByte::Result", Odd, Decoded.front())
+        TEST("DecodeByteByByte::NothingLeft", !Decoder.HasUnfinishedRecord())
+
+        Decoder.Decode(Records.substr(0, Records.size() / 2));
+        TEST("DecodeByteByByte::CutOff", Decoder.HasUnfinishedRecord())
+    }
+
+    {
+        Mezzanine::Testing::CrashReport Crash;
+        Crash.Signal = 11;
+        Crash.FaultAddress = 0xDEADBEEF;
+        Crash.Frames.push_back(Mezzanine::Testing::CrashFrame{0x1000, 0x10, "_Z3Foov", "Test_Tester"});
+        Crash.Frames.push_back(Mezzanine::Testing::CrashFrame{0x2000, 0x200, "", ""});
+        const String Records( Mezzanine::Testing::EncodeCrashRecord(Crash) +
+                              Mezzanine::Testing::EncodeResultRecord(Plain) );
+
+        std::vector<Mezzanine::Testing::CrashReport> Crashes;
+        Mezzanine::Whole ResultCount{0};
+        ResultRecordDecoder Decoder([&ResultCount](TestData&&){ ++ResultCount; }, {},
+            [&Crashes](Mezzanine::Testing::CrashReport&& OneCrash){ Crashes.push_back(std::move(OneCrash)); });
+        Decoder.Decode(Records);
+        TEST("DecodeCrash::Count", 1 == Crashes.size() && Mezzanine::Whole{1} == ResultCount)
+        TEST("DecodeCrash::Signal", !Crashes.empty() && 11 == Crashes.front().Signal &&
+             0xDEADBEEF == Crashes.front().FaultAddress)
+        TEST("DecodeCrash::Frames", !Crashes.empty() && 2 == Crashes.front().Frames.size() &&
+             0x10 == Crashes.front().Frames[0].Offset && "_Z3Foov" == Crashes.front().Frames[0].Symbol &&
+             "Test_Tester" == Crashes.front().Frames[0].Module && 0x2000 == Crashes.front().Frames[1].Address)
+
+        ResultRecordDecoder Ignoring([&ResultCount](TestData&&){ ++ResultCount; });
+        Ignoring.Decode(Records);
+        TEST_EQUAL("DecodeCrash::IgnoredWithoutHandler", Mezzanine::Whole{2}, ResultCount)
+    }
+
+    {
+        ResultRecordDecoder Decoder([](TestData&&){});
+        TEST_THROW("Decode::Throw-NotRecords",
+                   Mezzanine::Testing::MalformedResultRecord,
+                   [&Decoder]{ Decoder.Decode("This is just text from cout\n"); })
+
+        String UnknownType( Mezzanine::Testing::EncodeLogRecord("Text") );
+        UnknownType[4] = 99;
+        ResultRecordDecoder OtherDecoder([](TestData&&){});
+        TEST_THROW("Decode::Throw-UnknownType",
+                   Mezzanine::Testing::MalformedResultRecord,
+                   [&]{ OtherDecoder.Decode(UnknownType); })
+    }
+
+    {
+        ResultRecordProbeTests Source;
+        String Channel;
+        Mezzanine::Whole Sends{0};
+        Mezzanine::Testing::RunAndSendResultRecords(Source, [&](const StringView Bytes)
+            { Channel.append(Bytes); ++Sends; });
+        TEST_EQUAL("RunAndSend::EachResultSentAsStored", Mezzanine::Whole{2}, Sends)
+
+        ResultRecordProbeTests Destination;
+        Mezzanine::Testing::ReadResultRecordsInto(Destination)(Channel);
+        TEST_EQUAL("ReadInto::ResultCount", size_t{1}, size_t(Destination.end() - Destination.begin()))
+        TEST_EQUAL("ReadInto::Prefixed",
+                   String("SubProcess::ResultRecordProbe::Probe"),
+                   Destination.begin()->TestName)
+        TEST_EQUAL("ReadInto::LogIsChildLog", Source.GetTestLog(), Destination.GetTestLog())
+
+        ResultRecordProbeTests Garbled;
+        Mezzanine::Testing::ResultChannelCallback Reader( Mezzanine::Testing::ReadResultRecordsInto(Garbled) );
+        Reader("Noise that is not records");
+        Reader(Channel);
+        TEST_EQUAL("ReadInto::UnreadableOnce", size_t{1}, size_t(Garbled.end() - Garbled.begin()))
+        TEST_EQUAL("ReadInto::UnreadableIsUnknown", TestResult::Unknown, Garbled.begin()->Results)
+
+        // Sending the same result twice is a problem with the results, not with reading them.
+        ResultRecordProbeTests Doubled;
+        Mezzanine::Testing::ResultChannelCallback DoubledReader( Mezzanine::Testing::ReadResultRecordsInto(Doubled) );
+        DoubledReader(Channel);
+        TEST_THROW("ReadInto::Throw-SameNameTwice", std::runtime_error, [&]{ DoubledReader(Channel); })
+        TEST_EQUAL("ReadInto::SameNameTwiceNotUnreadable", size_t{1}, size_t(Doubled.end() - Doubled.begin()))
+
+        // A child killed partway through only got its first result out, that one is kept.
+        ResultRecordProbeTests Killed;
+        Mezzanine::Testing::ReadResultRecordsInto(Killed)(Channel.substr(0, Channel.size() - 1));
+        Mezzanine::Testing::RecordTimedOut(Killed, std::chrono::seconds(2));
+        TEST_EQUAL("TimedOut::KeepsSentResults", size_t{2}, size_t(Killed.end() - Killed.begin()))
+        TEST_EQUAL("TimedOut::Name", String("SubProcess::ResultRecordProbe::TimedOut"), (Killed.end() - 1)->TestName)
+        TEST_EQUAL("TimedOut::IsCancelled", TestResult::Cancelled, (Killed.end() - 1)->Results)
+        TEST_STRING_CONTAINS("TimedOut::LogsElapsed", String(" 2s "), Killed.GetTestLog())
+    }
+
+    {
+        // The crash record arrives before the child is reaped, then the signal it died of is recorded with it.
+        Mezzanine::Testing::CrashReport Crash;
+        Crash.Signal = 6;
+        Crash.Frames.push_back(Mezzanine::Testing::CrashFrame{0x1000, 0x10, "_Z3Foov", "Test_Tester"});
+        Mezzanine::Testing::CrashReport Kept;
+        ResultRecordProbeTests Crashed;
+        Mezzanine::Testing::ReadResultRecordsInto(Crashed, [&Kept](Mezzanine::Testing::CrashReport&& OneCrash)
+            { Kept = std::move(OneCrash); })(Mezzanine::Testing::EncodeCrashRecord(Crash));
+        TEST("ReadInto::CrashGoesToHandler", 6 == Kept.Signal && 1 == Kept.Frames.size())
+        Mezzanine::Testing::RecordCrashed(Crashed, 6, Kept);
+        TEST_EQUAL("Crashed::Name", String("SubProcess::ResultRecordProbe::Crashed"), Crashed.begin()->TestName)
+        TEST_EQUAL("Crashed::IsUnknown", TestResult::Unknown, Crashed.begin()->Results)
+        TEST_EQUAL("Crashed::Function", String("Foo()"), Crashed.begin()->FunctionName)
+        TEST_STRING_CONTAINS("Crashed::LogsBacktrace", String("Foo() + 0x10 in Test_Tester"), Crashed.GetTestLog())
+
+        ResultRecordProbeTests Silent;
+        Mezzanine::Testing::RecordCrashed(Silent, 9, Mezzanine::Testing::CrashReport{});
+        TEST_EQUAL("Crashed::SilentIsUnknown", TestResult::Unknown, Silent.begin()->Results)
+        TEST_STRING_CONTAINS("Crashed::SilentLogsSignal", String("(9)"), Silent.GetTestLog())
+    }
+}
+
+#endif
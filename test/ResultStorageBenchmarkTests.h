@@ -0,0 +1,148 @@
+// © Copyright 2010 - 2021 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_ResultStorageBenchmarkTests_h
+#define Mezz_Test_ResultStorageBenchmarkTests_h
+
+/// @file
+/// @brief Benchmarks storing many results in one group, to show each assertion costs the same however many came first.
+
+#include "MezzTest.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+/// @brief A group that only exists to have results stored in it.
+class ResultStorageProbeTestGroup : public Mezzanine::Testing::UnitTestGroup
+{
+public:
+    virtual void operator()() override
+        {}
+    virtual Mezzanine::String Name() const override
+        { return "ResultStorageProbe"; }
+    virtual Mezzanine::Boole EmitIntermediaryTestResults() const override
+        { return false; }
+};
+
+/// @brief A group that makes one aggregated assertion over and over.
+class AggregatedLoopTestGroup : public Mezzanine::Testing::UnitTestGroup
+{
+public:
+    /// @brief How many times to make the assertion.
+    Mezzanine::Whole Count = 0;
+
+    virtual void operator()() override
+    {
+        for(Mezzanine::Whole Index = 0; Index < Count; Index++)
+            { TEST_AGGREGATED("Looped" + std::to_string(Index), Index < Count) }
+    }
+    virtual Mezzanine::String Name() const override
+        { return "AggregatedLoop"; }
+    virtual Mezzanine::Boole EmitIntermediaryTestResults() const override
+        { return false; }
+};
+
+/// @brief How long storing a result with a new name takes once a group already holds some.
+/// @param Count How many results with distinct names to store in a fresh group.
+/// @return The average time storing one of them took.
+inline std::chrono::nanoseconds TimePerStoredResult(const Mezzanine::Whole Count)
+{
+    using Mezzanine::Testing::TestData;
+    using Mezzanine::Testing::TestResult;
+
+    // Build the names first so only the storing is timed.
+    std::vector<Mezzanine::String> Names;
+    Names.reserve(Count);
+    for(Mezzanine::Whole Index = 0; Index < Count; Index++)
+        { Names.push_back("Assertion" + std::to_string(Index)); }
+
+    ResultStorageProbeTestGroup Probe;
+    const auto Started = std::chrono::steady_clock::now();
+    for(const Mezzanine::String& SingleName : Names)
+        { Probe.AddTestResultWithoutName(TestData(SingleName, TestResult::Success, "Benchmark", __FILE__, __LINE__)); }
+    const auto Elapsed = std::chrono::steady_clock::now() - Started;
+
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Elapsed) /
+           static_cast<std::chrono::nanoseconds::rep>(Count);
+}
+
+/// @brief How long a passing TEST_AGGREGATED takes once it has run before.
+/// @param Count How many times to make the assertion.
+/// @return The average time each one took.
+inline std::chrono::nanoseconds TimePerAggregatedPass(const Mezzanine::Whole Count)
+{
+    AggregatedLoopTestGroup Loop;
+    Loop.Count = Count;
+    const auto Started = std::chrono::steady_clock::now();
+    Loop();
+    const auto Elapsed = std::chrono::steady_clock::now() - Started;
+
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Elapsed) /
+           static_cast<std::chrono::nanoseconds::rep>(Count);
+}
+
+/// @brief Stores ever larger numbers of assertions in one group and compares what each one cost.
+BENCHMARK_TEST_GROUP(ResultStorageBenchmarkTests, ResultStorageBenchmark)
+{
+    const std::vector<Mezzanine::Whole> Counts{ 10000, 100000, 1000000, 2000000 };
+    std::vector<std::chrono::nanoseconds> Costs;
+    for(const Mezzanine::Whole SingleCount : Counts)
+    {
+        Costs.push_back(TimePerStoredResult(SingleCount));
+        TestLog << "Stored " << SingleCount << " results at " << Costs.back().count() << "ns each." << std::endl;
+    }
+
+    // Storing used to sort every result stored so far, so the cost per assertion grew with the group. Now it should
+    // stay flat, allowing some growth for the name index falling out of cache.
+    const std::chrono::nanoseconds SmallestGroupCost{ Costs.front() };
+    for(std::vector<Mezzanine::Whole>::size_type Index = 1; Index < Counts.size(); Index++)
+    {
+        TEST_PERF("FlatCostPerResult" + std::to_string(Counts[Index]),
+                  Costs[Index] <= SmallestGroupCost * 4 + std::chrono::nanoseconds{500})
+    }
+
+    // Aggregated assertions store nothing when they pass, so they should be much cheaper than storing anything.
+    const std::chrono::nanoseconds AggregatedCost{ TimePerAggregatedPass(Counts.back()) };
+    TestLog << "Made " << Counts.back() << " aggregated assertions at " << AggregatedCost.count() << "ns each."
+            << std::endl;
+    TEST_PERF("AggregatedPassCheaperThanStoring", AggregatedCost * 4 <= SmallestGroupCost)
+}
+
+#endif
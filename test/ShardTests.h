@@ -0,0 +1,172 @@
+// © Copyright 2010 - 2021 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_ShardTests_h
+#define Mezz_Test_ShardTests_h
+
+/// @file
+/// @brief Tests for splitting test groups between machines and merging their results.
+
+// Add other headers you need here
+#include "MezzTest.h"
+
+#include <set>
+#include <sstream>
+
+using Mezzanine::String;
+using Mezzanine::Whole;
+using Mezzanine::Testing::OrderedTestGroups;
+using Mezzanine::Testing::SelectShard;
+using Mezzanine::Testing::TestHistory;
+
+/// @brief A group with a name that can be chosen, so sharding has something to sort.
+class NamedShardProbe : public Mezzanine::Testing::UnitTestGroup
+{
+    /// @brief The name to report.
+    String ProbeName;
+public:
+    /// @brief Constructor.
+    /// @param NewName The name to report.
+    explicit NamedShardProbe(const String& NewName) : ProbeName(NewName) {}
+    /// @brief Does nothing, these are never run.
+    virtual void operator()() override {}
+    /// @return The name passed to the constructor.
+    virtual String Name() const override { return ProbeName; }
+};
+
+AUTOMATIC_TEST_GROUP(ShardTests, Shard)
+{
+    const std::vector<String> Names{"Alpha", "Beta", "Gamma", "Delta", "Epsilon", "Zeta", "Eta", "Theta"};
+    std::vector<NamedShardProbe> Probes(Names.begin(), Names.end());
+    Mezzanine::Testing::CoreTestGroup FakeTestGroup;
+    for(NamedShardProbe& OneProbe : Probes)
+        { FakeTestGroup[OneProbe.Name()] = &OneProbe; }
+    OrderedTestGroups Candidates;
+    for(const Mezzanine::Testing::CoreTestGroup::value_type& OneTestGroup : FakeTestGroup)
+        { Candidates.push_back(&OneTestGroup); }
+
+    // Without history every group lands in exactly one shard.
+    {
+        TestHistory NoHistory;
+        std::multiset<String> Seen;
+        for(Whole Index = 1; Index <= 3; ++Index)
+        {
+            for(const Mezzanine::Testing::CoreTestGroup::value_type* OneTestGroup :
+                SelectShard(Candidates, NoHistory, Index, 3))
+                { Seen.insert(OneTestGroup->first); }
+        }
+        TEST_EQUAL("Hash::EveryGroupOnce", Names.size(), Seen.size())
+        TEST_EQUAL("Hash::NoDuplicates", Names.size(), std::set<String>(Seen.begin(), Seen.end()).size())
+        TEST_EQUAL("Hash::Stable",
+                   SelectShard(Candidates, NoHistory, 2, 3).size(), SelectShard(Candidates, NoHistory, 2, 3).size())
+        TEST_EQUAL("Hash::OneShardIsEverything", Names.size(), SelectShard(Candidates, NoHistory, 1, 1).size())
+    }
+
+    // With history, longest first onto the least loaded shard.
+    {
+        TestHistory History;
+        History.Record("Alpha", std::chrono::nanoseconds{10});
+        History.Record("Beta", std::chrono::nanoseconds{9});
+        History.Record("Gamma", std::chrono::nanoseconds{8});
+        History.Record("Delta", std::chrono::nanoseconds{1});
+        History.Record("Epsilon", std::chrono::nanoseconds{1});
+        History.Record("Zeta", std::chrono::nanoseconds{1});
+        History.Record("Eta", std::chrono::nanoseconds{1});
+        History.Record("Theta", std::chrono::nanoseconds{1});
+
+        std::set<String> First;
+        for(const Mezzanine::Testing::CoreTestGroup::value_type* OneTestGroup : SelectShard(Candidates, History, 1, 2))
+            { First.insert(OneTestGroup->first); }
+        std::set<String> Second;
+        for(const Mezzanine::Testing::CoreTestGroup::value_type* OneTestGroup : SelectShard(Candidates, History, 2, 2))
+            { Second.insert(OneTestGroup->first); }
+
+        TEST_EQUAL("History::EveryGroupOnce", Names.size(), First.size() + Second.size())
+        TEST("History::LongestInFirst", First.count("Alpha") && !Second.count("Alpha"))
+        TEST("History::NextLongestSplit", Second.count("Beta") && Second.count("Gamma"))
+        TEST_EQUAL("History::ShortOnesFillTheGap", size_t{6}, First.size())
+    }
+
+    TEST_EQUAL("FileName", String("Mezz_Test_Shard_2_of_4.txt"), Mezzanine::Testing::GetShardResultsFileName(2, 4))
+
+    // Results written by a shard can be read back to merge.
+    {
+        ShardTests Written;
+        Written.AddTestResult(Mezzanine::Testing::TestData("Passes"));
+        Written.AddTestResult(Mezzanine::Testing::TestData("Fails", Mezzanine::Testing::TestResult::Failed,
+                                                           "SomeFunction", "SomeFile.h", 42));
+        Written.SetScheduledToRun();
+        Mezzanine::Testing::CoreTestGroup WrittenGroup;
+        WrittenGroup["shard"] = &Written;
+
+        std::stringstream ShardFile;
+        Mezzanine::Testing::EmitShardResults(WrittenGroup, ShardFile);
+        TEST_STRING_CONTAINS("Emit::HasHeader", String("--= Shard =--"), ShardFile.str())
+
+        Mezzanine::Testing::UnitTestGroup::TestDataStorageType Read = Mezzanine::Testing::ReadTestResults(ShardFile);
+        TEST_EQUAL("Read::Count", size_t{2}, Read.size())
+        TEST_EQUAL("Read::Worst", Mezzanine::Testing::TestResult::Failed, Mezzanine::Testing::GetWorstResults(Read))
+        Whole FailedLine{0};
+        for(const Mezzanine::Testing::TestData& OneResult : Read)
+        {
+            if(Mezzanine::Testing::TestResult::Failed == OneResult.Results)
+                { FailedLine = OneResult.LineNumber; }
+        }
+        TEST_EQUAL("Read::KeepsLine", Whole{42}, FailedLine)
+
+        std::stringstream ResultsFile;
+        ResultsFile << "Failed results before any group are ignored\n" << ShardFile.str()
+                    << "--= Wobbly =--\n"
+                    << Mezzanine::Testing::TestData("Wobbly::Meh", Mezzanine::Testing::TestResult::Warning)
+                    << "--= Broken =--\n"
+                    << Mezzanine::Testing::TestData("Broken::Lost", Mezzanine::Testing::TestResult::Unknown)
+                    << Mezzanine::Testing::TestData("Broken::Again", Mezzanine::Testing::TestResult::Failed)
+                    << "--= Empty =--\n";
+        const std::vector<String> FailedNames = Mezzanine::Testing::ReadFailedGroupNames(ResultsFile);
+        TEST_EQUAL("ReadFailedGroupNames::Count", size_t{2}, FailedNames.size())
+        TEST_EQUAL("ReadFailedGroupNames::First", String("Shard"), FailedNames.front())
+        TEST_EQUAL("ReadFailedGroupNames::Last", String("Broken"), FailedNames.back())
+    }
+
+    TEST_EQUAL("GetWorstResults::EmptyIsSuccess",
+               Mezzanine::Testing::TestResult::Success,
+               Mezzanine::Testing::GetWorstResults(Mezzanine::Testing::UnitTestGroup::TestDataStorageType{}))
+}
+
+#endif
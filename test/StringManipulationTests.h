@@ -51,6 +51,7 @@ using Mezzanine::Testing::RightTrim;
 using Mezzanine::Testing::AllLower;
 using Mezzanine::Testing::SanitizeFileName;
 using Mezzanine::Testing::SanitizeProcessCommand;
+using Mezzanine::Testing::StableStringHash;
 
 AUTOMATIC_TEST_GROUP(StringManipulationTests, StringManipulation)
 {
@@ -78,6 +79,10 @@ AUTOMATIC_TEST_GROUP(StringManipulationTests, StringManipulation)
     TEST_EQUAL("SanitizeProcessCommand-none",     String("echo 'foo'"),     SanitizeProcessCommand("echo 'foo'"))
     TEST_EQUAL("SanitizeProcessCommand-pipe",     String("ls _ wc"),        SanitizeProcessCommand("ls | wc"))
     TEST_EQUAL("SanitizeProcessCommand-allbad",   String("___"),            SanitizeProcessCommand("|><"))
+
+    TEST_EQUAL("StableStringHash-empty",    Mezzanine::UInt64{0xcbf29ce484222325ULL}, StableStringHash(""))
+    TEST_EQUAL("StableStringHash-a",        Mezzanine::UInt64{0xaf63dc4c8601ec8cULL}, StableStringHash("a"))
+    TEST_EQUAL("StableStringHash-foobar",   Mezzanine::UInt64{0x85944171f73967e8ULL}, StableStringHash("foobar"))
 }
 
 #endif
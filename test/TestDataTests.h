@@ -75,6 +75,24 @@ AUTOMATIC_TEST_GROUP(TestDataTests, TestData)
     TEST_EQUAL("TestDataConstruction.FileName",     String("file.cpp"),     Constructed.FileName)
     TEST_EQUAL("TestDataConstruction.LineNumber",   Mezzanine::Whole{42},   Constructed.LineNumber)
 
+    // Functions and files are interned, so assertions made in the same place share them.
+    {
+        using Mezzanine::Testing::InternedString;
+        const TestData SamePlace("OtherName", TestResult::Success, String("Func"), String("file.cpp"), 43);
+        TEST("Interned::SharedFunction", &Constructed.FunctionName.str() == &SamePlace.FunctionName.str())
+        TEST("Interned::SharedFile", &Constructed.FileName.str() == &SamePlace.FileName.str())
+        TEST("Interned::DifferentTextDiffers", InternedString("file.cpp") != InternedString("file.h"))
+        TEST("Interned::EmptyIsDefault", InternedString("") == InternedString())
+
+        // Text is remembered by where it was, so new text in the same place must not be mistaken for the old.
+        char Reused[] = "first.cpp";
+        const InternedString First(Reused);
+        Reused[0] = 'F';
+        TEST_EQUAL("Interned::ReusedAddressNewText", String("First.cpp"), InternedString(Reused).str())
+        TEST("Interned::ReusedAddressOldTextKept", String("first.cpp") == First.str())
+        TEST("Interned::OnlyNameOwned", sizeof(TestData) <= sizeof(String) + 4 * sizeof(Mezzanine::Whole))
+    }
+
     // Sorting
     std::vector<TestData> Sorted = {TestData("Ocelot"), TestData("Aardvark"), TestData("Zebra")};
     std::sort(Sorted.begin(), Sorted.end());
@@ -180,6 +198,9 @@ AUTOMATIC_TEST_GROUP(TestDataTests, TestData)
     TEST_STRING_CONTAINS("TestResultToString-Cancel",
                          String("Cancel"),
                          TestResultToString(TestResult::Cancelled))
+    TEST_STRING_CONTAINS("TestResultToString-Flaky",
+                         String("Flaky"),
+                         TestResultToString(TestResult::Flaky))
     TEST_STRING_CONTAINS("TestResultToString-Inconclusive",
                          String("Inconclusive"),
                          TestResultToString(TestResult::Inconclusive))
@@ -199,6 +220,9 @@ AUTOMATIC_TEST_GROUP(TestDataTests, TestData)
     TEST_STRING_CONTAINS("TestResultToFixedBoxString-Cancel",
                          String("Cancel"),
                          TestResultToFixedBoxString(TestResult::Cancelled))
+    TEST_STRING_CONTAINS("TestResultToFixedBoxString-Flaky",
+                         String("Flaky"),
+                         TestResultToFixedBoxString(TestResult::Flaky))
     TEST_STRING_CONTAINS("TestResultToFixedBoxString-Inconclusive",
                          String("Inconclusive"),
                          TestResultToFixedBoxString(TestResult::Inconclusive))
@@ -212,6 +236,9 @@ AUTOMATIC_TEST_GROUP(TestDataTests, TestData)
                          String("NotApplicable"),
                          TestResultToFixedBoxString(TestResult::NotApplicable))
 
+    TestData FlakyLine{ StringToTestData(" [     Flaky     ]  Scrappy in function 'bark' at Doo.h:12.") };
+    TEST_EQUAL("StringToTestData-Flaky-Results",        TestResult::Flaky,      FlakyLine.Results)
+
     TestData BogusLine{ StringToTestData(" Shaggy is probably a stoner, but there was never any on screen.") };
     TEST_EQUAL("StringToTestData-CompletelyBogus", TestData{}, BogusLine)
 
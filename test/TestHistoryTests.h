@@ -0,0 +1,148 @@
+// © Copyright 2010 - 2021 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_TestHistoryTests_h
+#define Mezz_Test_TestHistoryTests_h
+
+/// @file
+/// @brief Tests for remembering test group durations and ordering groups with them.
+
+// Add other headers you need here
+#include "MezzTest.h"
+
+#include <algorithm>
+#include <sstream>
+
+using Mezzanine::String;
+using Mezzanine::Testing::TestHistory;
+
+AUTOMATIC_TEST_GROUP(TestHistoryTests, TestHistory)
+{
+    using std::chrono::nanoseconds;
+
+    {
+        TestHistory Empty;
+        TEST_EQUAL("Empty::Size", Mezzanine::Whole{0}, Empty.size())
+        TEST("Empty::HasNoDuration", !Empty.HasDuration("Anything"))
+        TEST_EQUAL("Empty::DurationIsZero", nanoseconds::rep{0}, Empty.GetDuration("Anything").count())
+    }
+
+    {
+        TestHistory History;
+        History.Record("Slow", nanoseconds{5000});
+        History.Record("Fast", nanoseconds{10});
+        History.Record("Fast", nanoseconds{20});
+        TEST_EQUAL("Record::Size", Mezzanine::Whole{2}, History.size())
+        TEST_EQUAL("Record::Replaces", nanoseconds::rep{20}, History.GetDuration("Fast").count())
+
+        TEST("Order::LongerFirst", History.ShouldRunBefore("Slow", "Fast"))
+        TEST("Order::ShorterLater", !History.ShouldRunBefore("Fast", "Slow"))
+        TEST("Order::UnknownFirst", History.ShouldRunBefore("New", "Slow"))
+        TEST("Order::KnownAfterUnknown", !History.ShouldRunBefore("Slow", "New"))
+        TEST("Order::UnknownTies", !History.ShouldRunBefore("New", "Newer"))
+
+        std::stringstream Saved;
+        History.Save(Saved);
+        TestHistory Loaded;
+        Loaded.Load(Saved);
+        TEST_EQUAL("SaveLoad::Size", Mezzanine::Whole{2}, Loaded.size())
+        TEST_EQUAL("SaveLoad::Slow", nanoseconds::rep{5000}, Loaded.GetDuration("Slow").count())
+        TEST_EQUAL("SaveLoad::Fast", nanoseconds::rep{20}, Loaded.GetDuration("Fast").count())
+    }
+
+    {
+        std::stringstream Damaged("12 Good\nnonsense\n-5 Negative\n\n30\n7 Other\n");
+        TestHistory History;
+        History.Load(Damaged);
+        TEST_EQUAL("Load::SkipsBadLines", Mezzanine::Whole{2}, History.size())
+        TEST_EQUAL("Load::KeepsGoodLines", nanoseconds::rep{7}, History.GetDuration("Other").count())
+    }
+
+    {
+        TestHistory History;
+        Mezzanine::Testing::RecordTestGroupTimings(
+            { {"Initial Setup", nanoseconds{1}},
+              {"Threaded" + Mezzanine::Testing::ParallelTimingSuffix, nanoseconds{2}},
+              {"Serial" + Mezzanine::Testing::SerialTimingSuffix, nanoseconds{3}} },
+            History);
+        TEST_EQUAL("RecordTimings::OnlyGroups", Mezzanine::Whole{2}, History.size())
+        TEST_EQUAL("RecordTimings::Parallel", nanoseconds::rep{2}, History.GetDuration("Threaded").count())
+        TEST_EQUAL("RecordTimings::Serial", nanoseconds::rep{3}, History.GetDuration("Serial").count())
+    }
+
+    {
+        Mezzanine::Testing::CoreTestGroup FakeTestGroup;
+        TestHistoryTests First;
+        TestHistoryTests Second;
+        TestHistoryTests Third;
+        FakeTestGroup["a"] = &First;
+        FakeTestGroup["b"] = &Second;
+        FakeTestGroup["c"] = &Third;
+
+        TestHistory NoHistory;
+        Mezzanine::Testing::OrderedTestGroups Alphabetical =
+            Mezzanine::Testing::OrderTestGroupsByHistory(FakeTestGroup, NoHistory);
+        TEST_EQUAL("OrderGroups::Count", size_t{3}, Alphabetical.size())
+        TEST_EQUAL("OrderGroups::StableWithoutHistory", String("a"), Alphabetical.front()->first)
+    }
+
+    {
+        Mezzanine::Testing::CoreTestGroup FakeTestGroup;
+        TestHistoryTests Instance;
+        for(const char* OneName : {"a", "b", "c", "d", "e", "f", "g", "h"})
+            { FakeTestGroup[OneName] = &Instance; }
+
+        using Mezzanine::Testing::ShuffleTestGroups;
+        const Mezzanine::Testing::OrderedTestGroups First{ ShuffleTestGroups(FakeTestGroup, 42) };
+        TEST_EQUAL("Shuffle::Count", size_t{8}, First.size())
+        TEST("Shuffle::SameSeedSameOrder", First == ShuffleTestGroups(FakeTestGroup, 42))
+
+        Mezzanine::Testing::OrderedTestGroups Sorted{First};
+        std::sort(Sorted.begin(), Sorted.end(),
+                  [](const auto* Left, const auto* Right){ return Left->first < Right->first; });
+        TEST("Shuffle::EveryGroupOnce", std::adjacent_find(Sorted.begin(), Sorted.end()) == Sorted.end())
+
+        // With 8 groups the chance of three more seeds all matching the first by accident is negligible.
+        TEST("Shuffle::SeedsDiffer", First != ShuffleTestGroups(FakeTestGroup, 1) ||
+                                     First != ShuffleTestGroups(FakeTestGroup, 2) ||
+                                     First != ShuffleTestGroups(FakeTestGroup, 3))
+    }
+}
+
+#endif
@@ -45,6 +45,9 @@
 
 #include "MezzTest.h"
 
+#include <atomic>
+#include <chrono>
+#include <iterator>
 #include <stdexcept>
 #include <thread>
 
@@ -109,6 +112,91 @@ void WarningTestTests::operator ()()
     TEST_RESULT("TestResultWarning", Mezzanine::Testing::TestResult::Warning)
 }
 
+// This class is not called directly by the Unit Test framework and is just used by
+/// @brief TestTests to verify that repeated runs are tallied, it fails every third time it runs.
+class MEZZ_LIB FlickeringTestTests : public Mezzanine::Testing::AutomaticTestGroup
+{
+    public:
+        /// @brief How many times this has run, counted safely when copies run at once.
+        std::atomic<Mezzanine::Whole> RunCount{0};
+
+        virtual void operator()() override;
+        virtual Mezzanine::String Name() const override
+            { return "FlickeringTests"; }
+
+        /// @brief Don't print Failures that are supposed to happen.
+        virtual Mezzanine::Boole EmitIntermediaryTestResults() const override
+            { return false; }
+        /// @brief Only the atomic RunCount changes, so copies can run at once.
+        virtual Mezzanine::Boole CanRunConcurrentCopies() const override
+            { return true; }
+};
+
+void FlickeringTestTests::operator ()()
+{
+    TEST("SteadyTest", true)
+    TEST("FlickeringTest", 0 != ++RunCount % 3)
+}
+
+// This class is not called directly by the Unit Test framework and is just used by
+/// @brief TestTests to verify that Test can still be overridden with the signature it always had.
+class MEZZ_LIB OverriddenTestTests : public Mezzanine::Testing::AutomaticTestGroup
+{
+    public:
+        /// @brief How many times the override was called.
+        Mezzanine::Whole OverrideCalls = 0;
+
+        virtual void operator()() override
+        {
+            Test("CalledDirectly", true, Mezzanine::Testing::TestResult::Failed,
+                 Mezzanine::Testing::TestResult::Success, __func__, __FILE__, __LINE__);
+        }
+        virtual Mezzanine::String Name() const override
+            { return "OverriddenTests"; }
+        virtual Mezzanine::Testing::TestResult Test(const Mezzanine::String& TestName,
+                                                    bool TestCondition,
+                                                    Mezzanine::Testing::TestResult IfFalse,
+                                                    Mezzanine::Testing::TestResult IfTrue,
+                                                    const Mezzanine::String& FuncName,
+                                                    const Mezzanine::String& File,
+                                                    Mezzanine::Whole Line) override
+        {
+            OverrideCalls++;
+            return AutomaticTestGroup::Test(TestName, TestCondition, IfFalse, IfTrue, FuncName, File, Line);
+        }
+};
+
+// This class is not called directly by the Unit Test framework and is just used by
+/// @brief TestTests to verify how many repeats run at once.
+class MEZZ_LIB OverlapTestTests : public Mezzanine::Testing::AutomaticTestGroup
+{
+    public:
+        /// @brief Set to let copies run at once.
+        Mezzanine::Boole AllowCopies;
+        /// @brief How many copies are running right now.
+        std::atomic<Mezzanine::Whole> Running{0};
+        /// @brief The most copies that were ever running at once.
+        std::atomic<Mezzanine::Whole> MostRunning{0};
+
+        explicit OverlapTestTests(const Mezzanine::Boole Allow) :
+            AllowCopies(Allow)
+            {}
+
+        virtual void operator()() override
+        {
+            const Mezzanine::Whole NowRunning{ ++Running };
+            Mezzanine::Whole Most{ MostRunning.load() };
+            while(Most < NowRunning && !MostRunning.compare_exchange_weak(Most, NowRunning))
+                {}
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            --Running;
+        }
+        virtual Mezzanine::String Name() const override
+            { return "OverlapTests"; }
+        virtual Mezzanine::Boole CanRunConcurrentCopies() const override
+            { return AllowCopies; }
+};
+
 /// @brief This is the actual Test class. This tests our Test Macros.
 class MEZZ_LIB TestTests : public Mezzanine::Testing::AutomaticTestGroup
 {
@@ -153,6 +241,15 @@ void TestTests::operator ()()
     for(const Mezzanine::Testing::TestData& SingleResult : Negation)
         { TEST_EQUAL(SingleResult.TestName, Mezzanine::Testing::TestResult::Failed, SingleResult.Results) }
     TEST_EQUAL("GetWorstShouldReturnFailure", Mezzanine::Testing::TestResult::Failed, Negation.GetWorstResults())
+    TEST_EQUAL("ResultsKeepStoredOrder-First", Mezzanine::String("NegativeTests::DefaultTestFailing"),
+               Negation.begin()->TestName)
+    TEST_EQUAL("ResultsKeepStoredOrder-Second", Mezzanine::String("NegativeTests::EqualityTestFailing"),
+               std::next(Negation.begin())->TestName)
+
+    class OverriddenTestTests Overridden;
+    Overridden();
+    TEST_EQUAL("OverriddenTestIsCalled", Mezzanine::Whole{1}, Overridden.OverrideCalls)
+    TEST_EQUAL("OverriddenTestStores", Mezzanine::Testing::TestResult::Success, Overridden.GetWorstResults())
 
     // Warning Tests
     class WarningTestTests Warnifier;
@@ -169,6 +266,56 @@ void TestTests::operator ()()
         { ConstTestCount++; }
 
     TEST_EQUAL("ConstAndNormalIterationOverTestGroupSame", TestCount, ConstTestCount)
+
+    // Repeats tally results with the same name rather than refusing them.
+    {
+        using Mezzanine::Testing::TestResult;
+        class FlickeringTestTests Flickering;
+        Flickering.SetRepeats(6, false, false);
+        TEST("Repeat::IsRepeating", Flickering.IsRepeating())
+        TEST_NO_THROW("Repeat::SameNamesAllowed", [&]{ Flickering.Execute(); })
+        TEST_EQUAL("Repeat::RanEveryTime", Mezzanine::Whole{6}, Flickering.RunCount.load())
+        const UnitTestGroup::RepeatTallyStorageType Tallies{ Flickering.GetRepeatTallies() };
+        TEST_EQUAL("Repeat::TalliesSteadyRuns", Mezzanine::Whole{6}, Tallies.at("FlickeringTests::SteadyTest").Runs)
+        TEST_EQUAL("Repeat::TalliesSteadyFailures",
+                   Mezzanine::Whole{0}, Tallies.at("FlickeringTests::SteadyTest").Failures)
+        TEST_EQUAL("Repeat::TalliesFlickeringFailures",
+                   Mezzanine::Whole{2}, Tallies.at("FlickeringTests::FlickeringTest").Failures)
+        TEST_EQUAL("Repeat::KeepsOneResultPerName", std::distance(Flickering.begin(), Flickering.end()), 2)
+        TEST_EQUAL("Repeat::KeepsWorst", TestResult::Failed, Flickering.GetWorstResults())
+    }
+
+    {
+        class FlickeringTestTests Flickering;
+        Flickering.SetRepeats(1, true, false);
+        Flickering.Execute();
+        TEST_EQUAL("Repeat::UntilFailStops", Mezzanine::Whole{3}, Flickering.RunCount.load())
+    }
+
+    {
+        class FlickeringTestTests Flickering;
+        Flickering.SetRepeats(8, false, true, 4);
+        Flickering.Execute();
+        const UnitTestGroup::RepeatTallyStorageType Tallies{ Flickering.GetRepeatTallies() };
+        TEST_EQUAL("Repeat::ConcurrentCopiesAllRan", Mezzanine::Whole{8}, Flickering.RunCount.load())
+        TEST_EQUAL("Repeat::ConcurrentTalliesEveryRun",
+                   Mezzanine::Whole{8}, Tallies.at("FlickeringTests::FlickeringTest").Runs)
+        TEST_EQUAL("Repeat::ConcurrentTalliesFailures",
+                   Mezzanine::Whole{2}, Tallies.at("FlickeringTests::FlickeringTest").Failures)
+    }
+
+    {
+        class OverlapTestTests Bounded(true);
+        Bounded.SetRepeats(40, false, true, 3);
+        Bounded.Execute();
+        TEST("Repeat::ConcurrentCopiesOverlap", 1 < Bounded.MostRunning.load())
+        TEST("Repeat::ConcurrentCopiesLimitedToJobs", 3 >= Bounded.MostRunning.load())
+
+        class OverlapTestTests NotAllowed(false);
+        NotAllowed.SetRepeats(10, false, true, 3);
+        NotAllowed.Execute();
+        TEST_EQUAL("Repeat::ConcurrentOnlyIfAllowed", Mezzanine::Whole{1}, NotAllowed.MostRunning.load())
+    }
 }
 
 RESTORE_WARNING_STATE
@@ -0,0 +1,132 @@
+// © Copyright 2010 - 2021 BlackTopp Studios Inc.
+/* This file is part of The Mezzanine Engine.
+
+    The Mezzanine Engine is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    The Mezzanine Engine is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with The Mezzanine Engine.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/* The original authors have included a copy of the license specified above in the
+   'Docs' folder. See 'gpl.txt'
+*/
+/* We welcome the use of the Mezzanine engine to anyone, including companies who wish to
+   Build professional software and charge for their product.
+
+   However there are some practical restrictions, so if your project involves
+   any of the following you should contact us and we will try to work something
+   out:
+    - DRM or Copy Protection of any kind(except Copyrights)
+    - Software Patents You Do Not Wish to Freely License
+    - Any Kind of Linking to Non-GPL licensed Works
+    - Are Currently In Violation of Another Copyright Holder's GPL License
+    - If You want to change our code and not add a few hundred MB of stuff to
+        your distribution
+
+   These and other limitations could cause serious legal problems if you ignore
+   them, so it is best to simply contact us or the Free Software Foundation, if
+   you have any questions.
+
+   Joseph Toppi - toppij@gmail.com
+   John Blackwood - makoenergy02@gmail.com
+*/
+#ifndef Mezz_Test_WorkStealingPoolTests_h
+#define Mezz_Test_WorkStealingPoolTests_h
+
+/// @file
+/// @brief Tests for the pool of threads that runs test groups in parallel.
+
+// Add other headers you need here
+#include "MezzTest.h"
+#include "WorkStealingPool.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+using Mezzanine::Testing::WorkStealingPool;
+
+AUTOMATIC_TEST_GROUP(WorkStealingPoolTests, WorkStealingPool)
+{
+    TEST("DefaultThreadCountIsPositive", 0 < WorkStealingPool::GetDefaultThreadCount())
+    TEST_EQUAL("ZeroThreadsClampsToOne", Mezzanine::Whole{1}, WorkStealingPool(0).GetThreadCount())
+    TEST_EQUAL("ThreadCountIsKept", Mezzanine::Whole{3}, WorkStealingPool(3).GetThreadCount())
+
+    {
+        WorkStealingPool EmptyPool(4);
+        TEST_NO_THROW("RunWithNoWork", [&EmptyPool]{ EmptyPool.Run(); })
+    }
+
+    {
+        std::atomic<Mezzanine::Whole> Counter{0};
+        WorkStealingPool Pool(4);
+        for(Mezzanine::Whole Count = 0; Count < 1000; ++Count)
+            { Pool.AddWork([&Counter](){ ++Counter; }); }
+        Pool.Run();
+        TEST_EQUAL("AllWorkRuns", Mezzanine::Whole{1000}, Counter.load())
+    }
+
+    {
+        std::atomic<Mezzanine::Whole> Counter{0};
+        WorkStealingPool Pool(4);
+        for(Mezzanine::Whole Outer = 0; Outer < 10; ++Outer)
+        {
+            Pool.AddWork([&Counter, &Pool]()
+            {
+                ++Counter;
+                for(Mezzanine::Whole Inner = 0; Inner < 10; ++Inner)
+                    { Pool.AddWork([&Counter](){ ++Counter; }); }
+            });
+        }
+        Pool.Run();
+        TEST_EQUAL("NestedWorkRuns", Mezzanine::Whole{110}, Counter.load())
+    }
+
+    {
+        const std::thread::id CallingThread = std::this_thread::get_id();
+        Mezzanine::Boole AllOnCallingThread = true;
+        WorkStealingPool Pool(1);
+        for(Mezzanine::Whole Count = 0; Count < 10; ++Count)
+        {
+            Pool.AddWork([&AllOnCallingThread, CallingThread]()
+                { AllOnCallingThread = AllOnCallingThread && CallingThread == std::this_thread::get_id(); });
+        }
+        Pool.Run();
+        TEST("OneThreadUsesCallingThread", AllOnCallingThread)
+    }
+
+    {
+        std::atomic<Mezzanine::Boole> IndexesInRange{true};
+        WorkStealingPool Pool(4);
+        for(Mezzanine::Whole Count = 0; Count < 100; ++Count)
+        {
+            Pool.AddWork([&IndexesInRange]()
+            {
+                if(4 <= WorkStealingPool::GetCurrentWorkerIndex())
+                    { IndexesInRange = false; }
+            });
+        }
+        Pool.Run();
+        TEST("WorkerIndexInRange", IndexesInRange.load())
+        TEST_EQUAL("WorkerIndexOutsidePool", Mezzanine::Whole{0}, WorkStealingPool::GetCurrentWorkerIndex())
+    }
+
+    {
+        std::atomic<Mezzanine::Whole> Counter{0};
+        WorkStealingPool Pool(2);
+        Pool.AddWork([](){ throw std::runtime_error("Work failed"); });
+        for(Mezzanine::Whole Count = 0; Count < 10; ++Count)
+            { Pool.AddWork([&Counter](){ ++Counter; }); }
+        TEST_THROW("ExceptionsReachRun", std::runtime_error, [&Pool]{ Pool.Run(); })
+        TEST_EQUAL("ExceptionsDoNotStopOtherWork", Mezzanine::Whole{10}, Counter.load())
+    }
+}
+
+#endif